@@ -0,0 +1,491 @@
+// Per-operation cost of the C++ core types, the counterpart of bench/ops.py for
+// the Python bindings.
+//
+// Build it from the repository root along with the library sources:
+//
+//     g++ -O3 -std=c++11 -pthread -Ipyglm bench/core.cpp pyglm/Matrix.cpp pyglm/Vector.cpp pyglm/Quaternion.cpp pyglm/Transform.cpp pyglm/TransformHierarchy.cpp pyglm/DualQuaternion.cpp pyglm/Animation.cpp pyglm/Skinning.cpp pyglm/ThreadPool.cpp -o core
+//     ./core            # a table for humans
+//     ./core --json     # one JSON object per line, for scripts and CI
+//
+// Every benchmark feeds its result back into the next iteration, so that the
+// compiler can neither hoist the operation out of the loop nor drop it.
+//
+// The batches of 1000 stay on one thread. The "large" lines go through
+// batches big enough for the ThreadPool to split, once on one thread and once
+// on all of them, and time is measured on the wall clock for that reason.
+
+#include "Animation.hpp"
+#include "DualQuaternion.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Skinning.hpp"
+#include "ThreadPool.hpp"
+#include "Transform.hpp"
+#include "TransformHierarchy.hpp"
+#include "Vector.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace PyGlMath;
+
+namespace {
+
+const int N = 5000000;
+
+// Rotations only, so that the chains neither explode nor vanish.
+const Quaternion qa = Quaternion::rotation(Vector(1.0f, 2.0f, 3.0f).normalized(), 0.01f);
+const Quaternion qb = Quaternion::rotation(Vector(3.0f, 2.0f, 1.0f).normalized(), -0.01f);
+
+float vector_add(int n)
+{
+    Vector a(1.0f, 2.0f, 3.0f);
+    const Vector b(1e-6f, -1e-6f, 1e-6f);
+    for(int i = 0 ; i < n ; ++i) {
+        a = a + b;
+    }
+    return a.x();
+}
+
+float vector_cross(int n)
+{
+    Vector a(1.0f, 2.0f, 3.0f);
+    const Vector b(0.0f, 0.0f, 1.0f);
+    for(int i = 0 ; i < n ; ++i) {
+        a = a.cross(b);
+    }
+    return a.x();
+}
+
+float vector_dot(int n)
+{
+    Vector a(1.0f, 2.0f, 3.0f);
+    float sum = 0.0f;
+    for(int i = 0 ; i < n ; ++i) {
+        sum += a.dot(a);
+        a.x(sum * 1e-9f);
+    }
+    return sum;
+}
+
+float vector_normalized(int n)
+{
+    Vector a(1.0f, 2.0f, 3.0f);
+    for(int i = 0 ; i < n ; ++i) {
+        a = (a * 2.0f).normalized();
+    }
+    return a.x();
+}
+
+float quaternion_mul(int n)
+{
+    Quaternion q;
+    for(int i = 0 ; i < n ; ++i) {
+        q = q * ((i & 1) ? qa : qb);
+    }
+    return q.x();
+}
+
+float quaternion_nlerp(int n)
+{
+    Quaternion q = qa;
+    for(int i = 0 ; i < n ; ++i) {
+        q = q.nlerp(qb, 0.3f);
+    }
+    return q.x();
+}
+
+float quaternion_slerp(int n)
+{
+    Quaternion q = qa;
+    for(int i = 0 ; i < n ; ++i) {
+        q = q.slerp((i & 1) ? qa : qb, 0.3f);
+    }
+    return q.x();
+}
+
+float quaternion_rotate(int n)
+{
+    Vector v(1.0f, 2.0f, 3.0f);
+    for(int i = 0 ; i < n ; ++i) {
+        v = qa.rotate(v);
+    }
+    return v.x();
+}
+
+float quaternion_rotate_batch(int n)
+{
+    // Counts one operation per vector, to compare to quaternion_rotate.
+    std::vector<float> v(3 * 1000, 1.0f);
+    for(int i = 0 ; i < n / 1000 ; ++i) {
+        qa.rotate(&v[0], &v[0], 1000);
+    }
+    return v[0];
+}
+
+float affine_construct(int n)
+{
+    AffineMatrix m;
+    Vector t(1.0f, 2.0f, 3.0f);
+    for(int i = 0 ; i < n ; ++i) {
+        m = AffineMatrix::transformation(t, qa);
+        t.x(m(1, 4) * 0.5f + 1.0f);
+    }
+    return m(1, 4);
+}
+
+float affine_mul(int n)
+{
+    const AffineMatrix ra = AffineMatrix::rotation(qa);
+    const AffineMatrix rb = AffineMatrix::rotation(qb);
+    AffineMatrix m;
+    for(int i = 0 ; i < n ; ++i) {
+        m = m * ((i & 1) ? ra : rb);
+    }
+    return m[0];
+}
+
+float affine_inverse(int n)
+{
+    AffineMatrix m = AffineMatrix::transformation(Vector(1.0f, 2.0f, 3.0f), qa);
+    for(int i = 0 ; i < n ; ++i) {
+        m = m.inverse();
+    }
+    return m(1, 4);
+}
+
+float affine_transform_points(int n)
+{
+    // Counts one operation per point, like quaternion_rotate_batch.
+    const AffineMatrix m = AffineMatrix::rotation(qa);
+    std::vector<float> pts(3 * 1000, 1.0f);
+    for(int i = 0 ; i < n / 1000 ; ++i) {
+        m.transformPoints(&pts[0], &pts[0], 1000);
+    }
+    return pts[0];
+}
+
+float general_mul(int n)
+{
+    const General4x4Matrix ga(AffineMatrix::rotation(qa));
+    const General4x4Matrix gb(AffineMatrix::rotation(qb));
+    General4x4Matrix g;
+    for(int i = 0 ; i < n ; ++i) {
+        g = g * ((i & 1) ? ga : gb);
+    }
+    return g[0];
+}
+
+float general_inverse(int n)
+{
+    General4x4Matrix g = General4x4Matrix::perspectiveProjection(60.0f, 4.0f / 3.0f);
+    for(int i = 0 ; i < n ; ++i) {
+        g = g.inverse();
+    }
+    return g[0];
+}
+
+float transform_mul(int n)
+{
+    const Transform ta(Vector(0.1f, 0.2f, 0.3f), qa);
+    const Transform tb(Vector(0.3f, 0.2f, 0.1f), qb);
+    Transform t;
+    for(int i = 0 ; i < n ; ++i) {
+        t = t * ((i & 1) ? ta : tb);
+    }
+    return t.translation().x();
+}
+
+float transform_matrix(int n)
+{
+    Transform t(Vector(1.0f, 2.0f, 3.0f), qa);
+    for(int i = 0 ; i < n ; ++i) {
+        t.translation(Vector(t.matrix()(1, 4) * 0.5f + 1.0f, 2.0f, 3.0f));
+    }
+    return t.translation().x();
+}
+
+float dual_quaternion_mul(int n)
+{
+    const DualQuaternion da(Vector(0.1f, 0.2f, 0.3f), qa);
+    const DualQuaternion db(Vector(0.3f, 0.2f, 0.1f), qb);
+    DualQuaternion d;
+    for(int i = 0 ; i < n ; ++i) {
+        d = d * ((i & 1) ? da : db);
+    }
+    return d.translation().x();
+}
+
+// A rotation track of 300 keyframes at 30 per second, sampled every frame of
+// a 60 per second playback if \a forward, or at random times otherwise, which
+// needs a search every time.
+float track_sample(int n, bool forward)
+{
+    std::vector<float> times(300);
+    std::vector<Quaternion> keys(300);
+    for(std::size_t i = 0 ; i < times.size() ; ++i) {
+        times[i] = i / 30.0f;
+        keys[i] = (i & 1) ? qa : qb;
+    }
+    const QuaternionTrack track(&times[0], &keys[0], times.size());
+    Quaternion q;
+    unsigned int r = 1;
+    for(int i = 0 ; i < n ; ++i) {
+        r = r * 1103515245u + 12345u;
+        const float t = forward ? (i % 600) / 60.0f : (r >> 16) % 600 / 60.0f;
+        q = track.sample(t + q.x() * 1e-9f);
+    }
+    return q.w();
+}
+
+float track_sample_forward(int n)
+{
+    return track_sample(n, true);
+}
+
+float track_sample_random(int n)
+{
+    return track_sample(n, false);
+}
+
+// Counts one operation per track of a clip of 100 nodes, each with a
+// translation, a rotation and a scale track.
+float clip_sample(int n)
+{
+    std::vector<float> times(300);
+    std::vector<Vector> vkeys(300);
+    std::vector<Quaternion> qkeys(300);
+    for(std::size_t i = 0 ; i < times.size() ; ++i) {
+        times[i] = i / 30.0f;
+        vkeys[i] = Vector(0.1f * i, 1.0f, 2.0f);
+        qkeys[i] = (i & 1) ? qa : qb;
+    }
+    AnimationClip clip;
+    for(int b = 0 ; b < 100 ; ++b) {
+        clip.add(VectorTrack(&times[0], &vkeys[0], times.size()));
+        clip.add(QuaternionTrack(&times[0], &qkeys[0], times.size()));
+        clip.add(VectorTrack(&times[0], &vkeys[0], times.size()));
+    }
+    std::vector<float> out(clip.floats());
+    for(int i = 0 ; i < n / 300 ; ++i) {
+        clip.sample((i % 600) / 60.0f + out[0] * 1e-9f, &out[0]);
+    }
+    return out[3];
+}
+
+// Counts one operation per node of a binary tree of 1000 of them, of which
+// only the nodes below those in \a moved, a 0-terminated list, are recomputed
+// if given.
+float hierarchy_update(int n, const int *moved)
+{
+    std::vector<int> parents(1000, -1);
+    for(int i = 1 ; i < 1000 ; ++i) {
+        parents[i] = (i - 1) / 2;
+    }
+    TransformHierarchy h(&parents[0], parents.size());
+    for(std::size_t i = 0 ; i < h.size() ; ++i) {
+        h.local(i, Transform(Vector(0.1f, 0.2f, 0.3f), (i & 1) ? qa : qb));
+    }
+    for(int i = 0 ; i < n / 1000 ; ++i) {
+        if(moved) {
+            for(const int *m = moved ; *m ; ++m) {
+                h.local(*m, h.local(*m));
+            }
+        } else {
+            h.invalidate();
+        }
+        h.update();
+    }
+    return h.matrices()[16*999 + 12];
+}
+
+float hierarchy_update_all(int n)
+{
+    return hierarchy_update(n, 0);
+}
+
+float hierarchy_update_some(int n)
+{
+    // Each is the root of 1 + 2 + 4 + 8 nodes, 30 of the 1000 in total.
+    const int moved[] = {100, 101, 0};
+    return hierarchy_update(n, moved);
+}
+
+// Counts one operation per vertex of 1000 of them, each moved by four of
+// 64 bones, like the "skin" lines of bench/ops.py.
+float skin_linear(int n, bool normals)
+{
+    std::vector<AffineMatrix> palette;
+    for(int b = 0 ; b < 64 ; ++b) {
+        palette.push_back(AffineMatrix::transformation(Vector(0.01f * b, 0.0f, 0.0f), (b & 1) ? qa : qb));
+    }
+    std::vector<unsigned int> bones(4 * 1000);
+    std::vector<float> weights(4 * 1000);
+    for(std::size_t i = 0 ; i < bones.size() ; ++i) {
+        bones[i] = (7 * i) % 64;
+        weights[i] = 0.4f - 0.1f * (i % 4);
+    }
+    std::vector<float> pos(3 * 1000, 1.0f);
+    std::vector<float> nrm(3 * 1000, 0.5f);
+    for(int i = 0 ; i < n / 1000 ; ++i) {
+        skinLinear(&palette[0], palette.size(), &bones[0], &weights[0], 4,
+                   &pos[0], &pos[0], normals ? &nrm[0] : 0, normals ? &nrm[0] : 0, 1000);
+    }
+    return pos[0] + nrm[0];
+}
+
+// The same as skin_linear, with the bones as dual quaternions.
+float skin_dual_quaternion(int n, bool normals)
+{
+    std::vector<DualQuaternion> palette;
+    for(int b = 0 ; b < 64 ; ++b) {
+        palette.push_back(DualQuaternion(Vector(0.01f * b, 0.0f, 0.0f), (b & 1) ? qa : qb));
+    }
+    std::vector<unsigned int> bones(4 * 1000);
+    std::vector<float> weights(4 * 1000);
+    for(std::size_t i = 0 ; i < bones.size() ; ++i) {
+        bones[i] = (7 * i) % 64;
+        weights[i] = 0.4f - 0.1f * (i % 4);
+    }
+    std::vector<float> pos(3 * 1000, 1.0f);
+    std::vector<float> nrm(3 * 1000, 0.5f);
+    for(int i = 0 ; i < n / 1000 ; ++i) {
+        skinDualQuaternion(&palette[0], palette.size(), &bones[0], &weights[0], 4,
+                           &pos[0], &pos[0], normals ? &nrm[0] : 0, normals ? &nrm[0] : 0, 1000);
+    }
+    return pos[0] + nrm[0];
+}
+
+// Counts one operation per vertex of 100000 of them, which the pool splits
+// over the given amount of threads, 0 meaning all of them.
+float skin_large(int n, std::size_t threads)
+{
+    ThreadPool::instance().threads(threads);
+    std::vector<AffineMatrix> palette;
+    for(int b = 0 ; b < 64 ; ++b) {
+        palette.push_back(AffineMatrix::transformation(Vector(0.01f * b, 0.0f, 0.0f), (b & 1) ? qa : qb));
+    }
+    const std::size_t nverts = 100000;
+    std::vector<unsigned int> bones(4 * nverts);
+    std::vector<float> weights(4 * nverts);
+    for(std::size_t i = 0 ; i < bones.size() ; ++i) {
+        bones[i] = (7 * i) % 64;
+        weights[i] = 0.4f - 0.1f * (i % 4);
+    }
+    std::vector<float> pos(3 * nverts, 1.0f);
+    for(int i = 0 ; i < n / static_cast<int>(nverts) ; ++i) {
+        skinLinear(&palette[0], palette.size(), &bones[0], &weights[0], 4,
+                   &pos[0], &pos[0], 0, 0, nverts);
+    }
+    ThreadPool::instance().threads(0);
+    return pos[0];
+}
+
+float skin_large_one_thread(int n)
+{
+    return skin_large(n, 1);
+}
+
+float skin_large_all_threads(int n)
+{
+    return skin_large(n, 0);
+}
+
+float skin_positions(int n)
+{
+    return skin_linear(n, false);
+}
+
+float skin_normals(int n)
+{
+    return skin_linear(n, true);
+}
+
+float skin_dual_quaternion_positions(int n)
+{
+    return skin_dual_quaternion(n, false);
+}
+
+float skin_dual_quaternion_normals(int n)
+{
+    return skin_dual_quaternion(n, true);
+}
+
+struct Benchmark {
+    const char* name;
+    float (*run)(int);
+};
+
+const Benchmark benchmarks[] = {
+    {"Vector a + b", &vector_add},
+    {"Vector a.cross(b)", &vector_cross},
+    {"Vector a.dot(b)", &vector_dot},
+    {"Vector a.normalized()", &vector_normalized},
+    {"Quaternion p * q", &quaternion_mul},
+    {"Quaternion nlerp", &quaternion_nlerp},
+    {"Quaternion slerp", &quaternion_slerp},
+    {"Quaternion rotate", &quaternion_rotate},
+    {"Quaternion rotate (batch)", &quaternion_rotate_batch},
+    {"AffineMatrix transformation", &affine_construct},
+    {"AffineMatrix m * m", &affine_mul},
+    {"AffineMatrix inverse", &affine_inverse},
+    {"AffineMatrix transformPoints", &affine_transform_points},
+    {"General4x4Matrix g * g", &general_mul},
+    {"General4x4Matrix inverse", &general_inverse},
+    {"Transform t * t", &transform_mul},
+    {"Transform matrix()", &transform_matrix},
+    {"DualQuaternion d * d", &dual_quaternion_mul},
+    {"QuaternionTrack sample (forward)", &track_sample_forward},
+    {"QuaternionTrack sample (random)", &track_sample_random},
+    {"AnimationClip sample", &clip_sample},
+    {"TransformHierarchy update", &hierarchy_update_all},
+    {"TransformHierarchy 2 moved", &hierarchy_update_some},
+    {"skinLinear", &skin_positions},
+    {"skinLinear with normals", &skin_normals},
+    {"skinDualQuaternion", &skin_dual_quaternion_positions},
+    {"skinDualQuaternion with normals", &skin_dual_quaternion_normals},
+    {"skinLinear large, 1 thread", &skin_large_one_thread},
+    {"skinLinear large, all threads", &skin_large_all_threads},
+};
+
+double seconds()
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double> >(steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const bool json = argc > 1 && std::strcmp(argv[1], "--json") == 0;
+
+#if defined(D_PYGLM_SSE)
+    const char* simd = "SSE";
+#elif defined(D_PYGLM_NEON)
+    const char* simd = "NEON";
+#else
+    const char* simd = "none";
+#endif
+    if(!json) {
+        std::printf("SIMD backend: %s\n", simd);
+    }
+
+    for(std::size_t i = 0 ; i < sizeof(benchmarks) / sizeof(benchmarks[0]) ; ++i) {
+        const double t = seconds();
+        const float result = benchmarks[i].run(N);
+        const double ns = (seconds() - t) / N * 1e9;
+
+        // Printing the result keeps the compiler from optimizing the loop away.
+        if(json) {
+            std::printf("{\"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"simd\": \"%s\", \"check\": %g}\n",
+                        benchmarks[i].name, ns, 1e9 / ns, simd, result);
+        } else {
+            std::printf("%-32s %8.2f ns/op   (%g)\n", benchmarks[i].name, ns, result);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Throughput of chained matrix products, which multiply the inverses too unless
+// those are lazy.
+//
+// Build it from the repository root along with the library sources, once as is
+// and once with -DD_PYGLM_NO_SIMD to compare to the plain C++ fallback:
+//
+//     g++ -O3 -std=c++11 -pthread -Ipyglm bench/matrix_products.cpp pyglm/Matrix.cpp pyglm/Vector.cpp pyglm/Quaternion.cpp pyglm/ThreadPool.cpp -o matrix_products
+//     ./matrix_products
+
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Vector.hpp"
+
+#include <cstdio>
+#include <ctime>
+
+using namespace PyGlMath;
+
+namespace {
+
+const int N = 10000000;
+
+double seconds()
+{
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+template<class M>
+void report(const char* name, const M& result, double t)
+{
+    // Printing an element keeps the compiler from optimizing the loop away.
+    std::printf("%-36s %8.2f ns/op   (%g)\n", name, t / N * 1e9, result[0]);
+}
+
+}
+
+int main()
+{
+#if defined(D_PYGLM_SSE)
+    std::printf("SIMD backend: SSE\n");
+#elif defined(D_PYGLM_NEON)
+    std::printf("SIMD backend: NEON\n");
+#else
+    std::printf("SIMD backend: none\n");
+#endif
+
+    // Rotations only, so that the chain neither explodes nor vanishes.
+    const AffineMatrix ra = AffineMatrix::rotation(Quaternion::rotation(Vector(1.0f, 2.0f, 3.0f).normalized(), 0.01f));
+    const AffineMatrix rb = AffineMatrix::rotation(Quaternion::rotation(Vector(3.0f, 2.0f, 1.0f).normalized(), -0.01f));
+
+    AffineMatrix a;
+    double t = seconds();
+    for(int i = 0 ; i < N ; ++i) {
+        a *= (i & 1) ? ra : rb;
+    }
+    report("AffineMatrix *= AffineMatrix", a, seconds() - t);
+
+    a = AffineMatrix();
+    t = seconds();
+    for(int i = 0 ; i < N ; ++i) {
+        a = a * ((i & 1) ? ra : rb);
+    }
+    report("AffineMatrix = AffineMatrix * ...", a, seconds() - t);
+
+    const General4x4Matrix ga(ra), gb(rb);
+    General4x4Matrix g;
+    t = seconds();
+    for(int i = 0 ; i < N ; ++i) {
+        g *= (i & 1) ? ga : gb;
+    }
+    report("General4x4Matrix *= General4x4Matrix", g, seconds() - t);
+
+    // Same chains, but only computing the inverse once at the end.
+    AffineMatrix la;
+    la.setLazyInverse(true);
+    t = seconds();
+    for(int i = 0 ; i < N ; ++i) {
+        la *= (i & 1) ? ra : rb;
+    }
+    la.array16fInverse();
+    report("AffineMatrix *= (lazy inverse)", la, seconds() - t);
+
+    General4x4Matrix lg;
+    lg.setLazyInverse(true);
+    t = seconds();
+    for(int i = 0 ; i < N ; ++i) {
+        lg *= (i & 1) ? ga : gb;
+    }
+    lg.array16fInverse();
+    report("General4x4Matrix *= (lazy inverse)", lg, seconds() - t);
+
+    return 0;
+}
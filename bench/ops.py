@@ -0,0 +1,160 @@
+"""Per-operation cost of the pyglm Python types.
+
+Build the extension in place first, then run from the repository root:
+
+    python setup.py build_ext --inplace
+    PYTHONPATH=. python bench/ops.py
+    PYTHONPATH=. python bench/ops.py --json > ops.json
+
+With --json, every line is one JSON object, ready to be compared against a
+previous run in CI. Any other arguments select the benchmarks whose name
+contains one of them.
+
+The C++ side is measured by bench/core.cpp, and the matrix products in more
+depth by bench/matrix_products.cpp.
+
+Next to the time, every line reports two allocation counts per operation:
+"new" is the amount of Vector and Quaternion instances which could not be
+recycled from their free list and had to be allocated, and "leak" is how many
+memory blocks stayed allocated afterwards, which must be zero.
+
+Every operation returning a new object goes through the types' make_inst.
+The "construct" lines call the types the generic way, which is what
+make_inst used to do for every result, so they are the reference to compare
+the operations to.
+
+The VectorArray and transformPoints lines work on 1000 vectors at once, the
+batched nlerp and slerp lines on 1000 pairs of quaternions and the hierarchy
+update on a tree of 1000 nodes. The skin lines move 1000 vertices by four
+of 64 bones each. The clip samples 100 nodes of translation, rotation and
+scale tracks. Compare them to a thousand times the
+corresponding single line. Of those 1000 nodes, "hierarchy 2 moved" only
+recomputes the 8 it moves or which are below those.
+"""
+import json
+import sys
+import timeit
+
+SETUP = '''
+import array
+from pyglm import Vector, Quaternion, VectorArray, translation, transformation, perspectiveProjection, Transform, TransformHierarchy, nlerp, slerp, rotate, skin, DualQuaternion, VectorTrack, QuaternionTrack, AnimationClip
+a = Vector(1.0, 2.0, 3.0)
+b = Vector(0.5, 0.25, 0.125)
+p = Quaternion(Vector(0, 1, 0), deg=30)
+q = Quaternion(Vector(1, 0, 0), deg=45)
+va = VectorArray([a] * 1000)
+vb = VectorArray([b] * 1000)
+m = translation(1.0, 2.0, 3.0)
+g = perspectiveProjection(60.0, 4.0 / 3.0)
+t = Transform(a, q, 2.0)
+h = TransformHierarchy([-1] + [i // 2 for i in range(999)])
+for i in range(1000):
+    h.setLocal(i, t)
+pts = array.array('f', [1.0] * 3000)
+qa = array.array('f', [p.x, p.y, p.z, p.w] * 1000)
+qb = array.array('f', [q.x, q.y, q.z, q.w] * 1000)
+qt = array.array('f', [0.3] * 1000)
+qout = array.array('f', qa)
+pal = [transformation(Vector(i, 0, 0), q) for i in range(64)]
+bi = array.array('H', [(7*i) % 64 for i in range(4000)])
+bw = array.array('f', [0.4, 0.3, 0.2, 0.1] * 1000)
+nrm = array.array('f', [0.0, 1.0, 0.0] * 1000)
+dpal = [DualQuaternion(Vector(i, 0, 0), q) for i in range(64)]
+d = DualQuaternion(a, q)
+keys = [i / 30.0 for i in range(300)]
+vt = VectorTrack(keys, [a] * 300)
+qtrack = QuaternionTrack(keys, [p, q] * 150)
+clip = AnimationClip([vt, qtrack, vt] * 100)
+cout = array.array('f', [0.0] * clip.floats())
+sout = array.array('f', pts)
+nout = array.array('f', nrm)
+'''
+
+BENCHMARKS = [
+    ('Vector construct',     'Vector(1.0, 2.0, 3.0)'),
+    ('Vector a.x',           'a.x'),
+    ('Vector a.x = 2.0',     'a.x = 2.0'),
+    ('Vector a.zyx',         'a.zyx'),
+    ('Vector a.xz = b.zx',   'a.xz = b.zx'),
+    ('Vector a + b',         'a + b'),
+    ('Vector a * 2.0',       'a * 2.0'),
+    ('Vector a += b',        'a += b'),
+    ('Vector a *= 1.0',      'a *= 1.0'),
+    ('Vector -a',            '-a'),
+    ('Vector a.cross(b)',    'a.cross(b)'),
+    ('Vector a.normalized()','a.normalized()'),
+    ('Quaternion construct', 'Quaternion(0.0, 0.0, 0.0, 1.0)'),
+    ('Quaternion q.w',       'q.w'),
+    ('Quaternion q.deg',     'q.deg'),
+    ('Quaternion p * q',     'p * q'),
+    ('Quaternion p *= q',    'p *= q'),
+    ('Quaternion -q',        '-q'),
+    ('Quaternion nlerp',     'p.nlerp(q, 0.3)'),
+    ('Quaternion slerp',     'p.slerp(q, 0.3)'),
+    ('Quaternion q.rotate(a)','q.rotate(a)'),
+    ('VectorArray va + vb',  'va + vb'),
+    ('VectorArray va * 2.0', 'va * 2.0'),
+    ('VectorArray cross',    'va.cross(vb)'),
+    ('VectorArray normalize','va.normalize()'),
+    ('AffineMatrix construct','transformation(a, q)'),
+    ('AffineMatrix m * a',   'm * a'),
+    ('AffineMatrix m * m',   'm * m'),
+    ('AffineMatrix m *= m',  'm *= m'),
+    ('AffineMatrix inverse', 'm.inverse()'),
+    ('General4x4Matrix g * g','g * g'),
+    ('General4x4Matrix inverse','g.inverse()'),
+    ('Transform t * t',      't * t'),
+    ('Transform t *= t',     't *= t'),
+    ('Transform matrix()',   't.matrix()'),
+    ('DualQuaternion d * d', 'd * d'),
+    ('transformPoints',      'm.transformPoints(pts, pts)'),
+    ('batched nlerp',        'nlerp(qa, qb, qt, qout)'),
+    ('batched slerp',        'slerp(qa, qb, qt, qout)'),
+    ('rotateVectors',        'q.rotateVectors(pts, pts)'),
+    ('batched rotate',       'rotate(qa, pts, pts)'),
+    ('track sample',         'qtrack.sample(5.01)'),
+    ('clip sample',          'clip.sample(5.01, cout)'),
+    ('hierarchy update',     'h.invalidate(); h.update()'),
+    ('hierarchy 2 moved',    'h.setLocal(200, t); h.setLocal(700, t); h.update()'),
+    ('skin',                 'skin(pal, bi, bw, pts, out=sout)'),
+    ('skin with normals',    'skin(pal, bi, bw, pts, nrm, sout, nout)'),
+    ('skin dual quaternions','skin(dpal, bi, bw, pts, nrm, sout, nout)'),
+]
+
+def run(stmt, number=200000, repeat=5):
+    best = min(timeit.repeat(stmt, SETUP, number=number, repeat=repeat))
+    return best / number * 1e9
+
+def misses():
+    return sum(stats['misses'] for stats in freeListStats().values())
+
+def allocations(stmt, number=20000):
+    """Returns the new instances and the leaked memory blocks per run of stmt."""
+    timer = timeit.Timer(stmt, SETUP)
+    # The first round warms up the free lists and the interpreter's caches.
+    timer.timeit(number)
+    new, blocks = misses(), sys.getallocatedblocks()
+    timer.timeit(number)
+    once = sys.getallocatedblocks() - blocks
+    new = misses() - new
+    # Each round of timeit sets things up anew, which costs a few blocks of its
+    # own. Those cancel out between a single and a double round.
+    blocks = sys.getallocatedblocks()
+    timer.timeit(2 * number)
+    twice = sys.getallocatedblocks() - blocks
+    return new / number, max(0, twice - once) / number
+
+if __name__ == '__main__':
+    from pyglm import freeListStats
+    as_json = '--json' in sys.argv[1:]
+    only = [arg for arg in sys.argv[1:] if arg != '--json']
+    for name, stmt in BENCHMARKS:
+        if only and not any(o in name for o in only):
+            continue
+        ns = run(stmt)
+        new, leak = allocations(stmt)
+        if as_json:
+            print(json.dumps({'name': name, 'ns_per_op': round(ns, 1), 'ops_per_sec': round(1e9 / ns),
+                              'new_per_op': new, 'leak_per_op': leak}))
+        else:
+            print('%-26s %8.1f ns/op %12.0f ops/s %6.2f new %6.2f leak' % (name, ns, 1e9 / ns, new, leak))
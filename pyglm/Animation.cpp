@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "Animation.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Finds the pair of keyframes to interpolate for sampling at time t, starting
+// with the pair at the cursor and then the one after it, which is what
+// playing forward needs, and only then searching. Results in the index of the
+// first keyframe of the pair, writes that of the second one to next and the
+// time of interpolation between both to between. Before the first and after
+// the last keyframe, both of the pair are that keyframe.
+// The times are supposed to be strictly increasing, and not empty.
+std::size_t seek(const std::vector<float>& times, std::size_t& cursor, float t, std::size_t& next, float& between)
+{
+    const std::size_t n = times.size();
+    // Written such that NaN goes to the first keyframe.
+    if(!(t > times[0])) {
+        cursor = next = 0;
+        between = 0.0f;
+        return 0;
+    } else if(t >= times[n-1]) {
+        cursor = next = n-1;
+        between = 0.0f;
+        return n-1;
+    }
+
+    // From here on, times[0] < t < times[n-1], and i is such that
+    // times[i] <= t < times[i+1].
+    std::size_t i = cursor;
+    if(i + 1 < n && times[i] <= t && t < times[i+1]) {
+        // Still the same pair.
+    } else if(i + 2 < n && times[i+1] <= t && t < times[i+2]) {
+        ++i;
+    } else {
+        i = (std::upper_bound(times.begin(), times.end(), t) - times.begin()) - 1;
+    }
+
+    cursor = i;
+    next = i + 1;
+    between = (t - times[i]) / (times[i+1] - times[i]);
+    return i;
+}
+
+// Interpolating a rotation takes some tens of nanoseconds, only clips with
+// hundreds of them are worth waking up other threads.
+const std::size_t sample_grain = 512;
+
+struct RotationsTask {
+    const std::vector<PyGlMath::QuaternionTrack> *tracks;
+    const std::vector<std::size_t> *offsets;
+    float *scratch;
+    float t;
+    float *out;
+};
+
+// Samples the quaternion tracks from begin up to end of a clip, as described
+// by AnimationClip::sample. Each track has its own slots in the scratch room.
+void sample_rotations(void *data, std::size_t begin, std::size_t end)
+{
+    const RotationsTask& task = *static_cast<const RotationsTask*>(data);
+    const std::size_t n = task.tracks->size();
+    float *q1 = task.scratch;
+    float *q2 = q1 + 4*n;
+    float *q = q2 + 4*n;
+    float *between = q + 4*n;
+    for(std::size_t i = begin ; i < end ; ++i) {
+        between[i] = (*task.tracks)[i].keys(task.t, q1 + 4*i, q2 + 4*i);
+    }
+    PyGlMath::Quaternion::slerp(q1 + 4*begin, q2 + 4*begin, between + begin, q + 4*begin, end - begin);
+    for(std::size_t i = begin ; i < end ; ++i) {
+        std::copy(q + 4*i, q + 4*i + 4, task.out + (*task.offsets)[i]);
+    }
+}
+
+}
+
+namespace PyGlMath {
+
+////////////////////////////////////////////
+// Constructors and assignment operators. //
+////////////////////////////////////////////
+
+VectorTrack::VectorTrack()
+    : m_times()
+    , m_keys()
+    , m_cursor(0)
+{ }
+
+VectorTrack::VectorTrack(const float *in_times, const Vector *in_keys, std::size_t in_n)
+    : m_times(in_times, in_times + in_n)
+    , m_keys(in_keys, in_keys + in_n)
+    , m_cursor(0)
+{ }
+
+std::size_t VectorTrack::sorted(const float *in_times, std::size_t in_n)
+{
+    for(std::size_t i = 1 ; i < in_n ; ++i) {
+        // Written such that NaN isn't sorted either.
+        if(!(in_times[i] > in_times[i-1])) {
+            return i;
+        }
+    }
+
+    return in_n;
+}
+
+QuaternionTrack::QuaternionTrack()
+    : m_times()
+    , m_keys()
+    , m_cursor(0)
+{ }
+
+QuaternionTrack::QuaternionTrack(const float *in_times, const Quaternion *in_keys, std::size_t in_n)
+    : m_times(in_times, in_times + in_n)
+    , m_keys(in_keys, in_keys + in_n)
+    , m_cursor(0)
+{
+    // q and -q are the same rotation, but slerp between q and a key on the
+    // other side would go all around.
+    for(std::size_t i = 1 ; i < m_keys.size() ; ++i) {
+        if(m_keys[i].dot(m_keys[i-1]) < 0.0f) {
+            m_keys[i] = -m_keys[i];
+        }
+    }
+}
+
+AnimationClip::AnimationClip()
+    : m_vectors()
+    , m_vectorOffsets()
+    , m_quaternions()
+    , m_quaternionOffsets()
+    , m_floats(0)
+    , m_scratch()
+{ }
+
+std::size_t AnimationClip::add(const VectorTrack& in_track)
+{
+    m_vectors.push_back(in_track);
+    m_vectorOffsets.push_back(m_floats);
+    m_floats += 3;
+    return m_vectorOffsets.back();
+}
+
+std::size_t AnimationClip::add(const QuaternionTrack& in_track)
+{
+    m_quaternions.push_back(in_track);
+    m_quaternionOffsets.push_back(m_floats);
+    m_scratch.resize(13*m_quaternions.size());
+    m_floats += 4;
+    return m_quaternionOffsets.back();
+}
+
+/////////////////////////////////////
+// Accessors, getters and setters. //
+/////////////////////////////////////
+
+float AnimationClip::duration() const
+{
+    float d = 0.0f;
+    for(std::size_t i = 0 ; i < m_vectors.size() ; ++i) {
+        if(m_vectors[i].size()) {
+            d = std::max(d, m_vectors[i].time(m_vectors[i].size() - 1));
+        }
+    }
+    for(std::size_t i = 0 ; i < m_quaternions.size() ; ++i) {
+        if(m_quaternions[i].size()) {
+            d = std::max(d, m_quaternions[i].time(m_quaternions[i].size() - 1));
+        }
+    }
+    return d;
+}
+
+///////////////
+// Sampling. //
+///////////////
+
+Vector VectorTrack::sample(float in_t) const
+{
+    float v[3];
+    this->sample(in_t, v);
+    return Vector(v[0], v[1], v[2]);
+}
+
+void VectorTrack::sample(float in_t, float *out_v) const
+{
+    if(m_times.empty()) {
+        out_v[0] = out_v[1] = out_v[2] = 0.0f;
+        return;
+    }
+
+    std::size_t next;
+    float between;
+    const Vector& a = m_keys[seek(m_times, m_cursor, in_t, next, between)];
+    const Vector& b = m_keys[next];
+    out_v[0] = a.x() + (b.x() - a.x())*between;
+    out_v[1] = a.y() + (b.y() - a.y())*between;
+    out_v[2] = a.z() + (b.z() - a.z())*between;
+}
+
+Quaternion QuaternionTrack::sample(float in_t) const
+{
+    Quaternion q;
+    this->sample(in_t, q.array4f());
+    return q;
+}
+
+void QuaternionTrack::sample(float in_t, float *out_q) const
+{
+    D_PYGLM_ALIGN(16) float q1[4];
+    D_PYGLM_ALIGN(16) float q2[4];
+    const float between = this->keys(in_t, q1, q2);
+    Quaternion::slerp(q1, q2, &between, out_q, 1);
+}
+
+float QuaternionTrack::keys(float in_t, float *out_q1, float *out_q2) const
+{
+    if(m_times.empty()) {
+        out_q1[0] = out_q1[1] = out_q1[2] = 0.0f;
+        out_q1[3] = 1.0f;
+        std::copy(out_q1, out_q1 + 4, out_q2);
+        return 0.0f;
+    }
+
+    std::size_t next;
+    float between;
+    const float *a = m_keys[seek(m_times, m_cursor, in_t, next, between)].array4f();
+    const float *b = m_keys[next].array4f();
+    std::copy(a, a + 4, out_q1);
+    std::copy(b, b + 4, out_q2);
+    return between;
+}
+
+void AnimationClip::sample(float in_t, float *out_f) const
+{
+    for(std::size_t i = 0 ; i < m_vectors.size() ; ++i) {
+        m_vectors[i].sample(in_t, out_f + m_vectorOffsets[i]);
+    }
+
+    const std::size_t n = m_quaternions.size();
+    if(n == 0) {
+        return;
+    }
+
+    RotationsTask task = {&m_quaternions, &m_quaternionOffsets, &m_scratch[0], in_t, out_f};
+    ThreadPool::instance().parallelFor(n, sample_grain, &sample_rotations, &task);
+}
+
+} // namespace PyGlMath
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_ANIMATION_H
+#define PYGLM_ANIMATION_H
+
+#include "Vector.hpp"
+#include "Quaternion.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PyGlMath {
+
+/// The keyframes of a Vector changing over time, such as the translation or
+/// the scale of a bone. Sampling in between two keyframes interpolates them
+/// linearly, and sampling before the first or after the last one results in
+/// that keyframe.\n
+/// Each track remembers which pair of keyframes it sampled last. Playing an
+/// animation forward asks for that same pair or the next one nearly every
+/// time, which is then found without searching.
+/// \note Because of that cursor, a track can't be sampled by two threads at
+///       the same time. Different tracks can.
+class VectorTrack {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates an empty track, whose samples are all zero-vectors.
+    VectorTrack();
+    /// Creates a track from its keyframes.
+    /// \param in_times The time of every keyframe, which need to be strictly
+    ///                 increasing, \see sorted.
+    /// \param in_keys The value of every keyframe.
+    /// \param in_n The amount of keyframes.
+    VectorTrack(const float *in_times, const Vector *in_keys, std::size_t in_n);
+
+    /// Checks whether the times of keyframes are strictly increasing, as the
+    /// constructors of the tracks need.
+    /// \param in_times The time of every keyframe.
+    /// \param in_n The amount of keyframes.
+    /// \return The index of the first keyframe which doesn't come after the one
+    ///         before it, or \a in_n if there is none.
+    static std::size_t sorted(const float *in_times, std::size_t in_n);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The amount of keyframes.
+    inline std::size_t size() const {return m_times.size();};
+    /// \param idx The index of a keyframe, it must be less than size().
+    /// \return The time of keyframe \a idx.
+    inline float time(std::size_t idx) const {return m_times[idx];};
+    /// \param idx The index of a keyframe, it must be less than size().
+    /// \return The value of keyframe \a idx.
+    inline const Vector& key(std::size_t idx) const {return m_keys[idx];};
+
+    ///////////////
+    // Sampling. //
+    ///////////////
+
+    /// \param in_t The time at which to sample.
+    /// \return The value of the track at time \a in_t.
+    Vector sample(float in_t) const;
+    /// Samples the track, writing the result as floats.
+    /// \param in_t The time at which to sample.
+    /// \param out_v Where to write the x y z of the value at time \a in_t.
+    void sample(float in_t, float *out_v) const;
+
+private:
+    /// The time of each keyframe, strictly increasing.
+    std::vector<float> m_times;
+    /// The value of each keyframe.
+    std::vector<Vector> m_keys;
+    /// The index of the keyframe which the last sample came after.
+    mutable std::size_t m_cursor;
+};
+
+/// The keyframes of a Quaternion changing over time, such as the rotation of
+/// a bone. Sampling in between two keyframes interpolates them by slerp, and
+/// otherwise works like VectorTrack.
+/// \note The keyframes are flipped, if need be, such that each one is on the
+///       same side as the one before it, which is the same rotation. Sampling
+///       thus always takes the shortest way.
+/// \note The slerp is the one of Quaternion::slerp for arrays, within 1e-6 of
+///       the one of a single Quaternion.
+class QuaternionTrack {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates an empty track, whose samples are all the identity.
+    QuaternionTrack();
+    /// Creates a track from its keyframes.
+    /// \param in_times The time of every keyframe, which need to be strictly
+    ///                 increasing, \see VectorTrack::sorted.
+    /// \param in_keys The value of every keyframe, as unit quaternions.
+    /// \param in_n The amount of keyframes.
+    QuaternionTrack(const float *in_times, const Quaternion *in_keys, std::size_t in_n);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The amount of keyframes.
+    inline std::size_t size() const {return m_times.size();};
+    /// \param idx The index of a keyframe, it must be less than size().
+    /// \return The time of keyframe \a idx.
+    inline float time(std::size_t idx) const {return m_times[idx];};
+    /// \param idx The index of a keyframe, it must be less than size().
+    /// \return The value of keyframe \a idx, possibly flipped.
+    inline const Quaternion& key(std::size_t idx) const {return m_keys[idx];};
+
+    ///////////////
+    // Sampling. //
+    ///////////////
+
+    /// \param in_t The time at which to sample.
+    /// \return The value of the track at time \a in_t.
+    Quaternion sample(float in_t) const;
+    /// Samples the track, writing the result as floats.
+    /// \param in_t The time at which to sample.
+    /// \param out_q Where to write the x y z w of the value at time \a in_t.
+    void sample(float in_t, float *out_q) const;
+    /// Finds the keyframes to interpolate for sampling, without interpolating.
+    /// \param in_t The time at which to sample.
+    /// \param out_q1 Where to write the x y z w of the keyframe before \a in_t.
+    /// \param out_q2 Where to write the x y z w of the keyframe after \a in_t.
+    /// \return The time of interpolation between both, in [0, 1].
+    float keys(float in_t, float *out_q1, float *out_q2) const;
+
+private:
+    /// The time of each keyframe, strictly increasing.
+    std::vector<float> m_times;
+    /// The value of each keyframe.
+    std::vector<Quaternion> m_keys;
+    /// The index of the keyframe which the last sample came after.
+    mutable std::size_t m_cursor;
+};
+
+/// All tracks of an animation, sampled together. The values of all tracks are
+/// written one after the other into a single block of floats: three for each
+/// VectorTrack and four for each QuaternionTrack, in the order they were added.
+/// Adding the translation, rotation and scale tracks of each node of a
+/// TransformHierarchy in that order gives exactly the ten floats per node
+/// its Python binding's setLocals takes.\n
+/// The rotations are all interpolated in one go by Quaternion::slerp for arrays,
+/// split over the ThreadPool for clips with many of them.
+/// \note Like the tracks, a clip can't be sampled by two threads at the same time.
+class AnimationClip {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates a clip without any track.
+    AnimationClip();
+
+    /// Adds a copy of a track to the clip.
+    /// \param in_track The track to add.
+    /// \return The index of the first float of this track's values in a sample.
+    std::size_t add(const VectorTrack& in_track);
+    /// Adds a copy of a track to the clip.
+    /// \param in_track The track to add.
+    /// \return The index of the first float of this track's values in a sample.
+    std::size_t add(const QuaternionTrack& in_track);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The amount of tracks.
+    inline std::size_t size() const {return m_vectors.size() + m_quaternions.size();};
+    /// \return The amount of floats a sample of all tracks takes.
+    inline std::size_t floats() const {return m_floats;};
+    /// \return The time of the last keyframe of all tracks, or 0 if there are none.
+    float duration() const;
+
+    ///////////////
+    // Sampling. //
+    ///////////////
+
+    /// Samples all tracks at the same time.
+    /// \param in_t The time at which to sample.
+    /// \param out_f Where to write the floats() floats of the values of all tracks.
+    void sample(float in_t, float *out_f) const;
+
+private:
+    /// The vector tracks, in the order they were added.
+    std::vector<VectorTrack> m_vectors;
+    /// Where the values of each vector track go in a sample.
+    std::vector<std::size_t> m_vectorOffsets;
+    /// The quaternion tracks, in the order they were added.
+    std::vector<QuaternionTrack> m_quaternions;
+    /// Where the values of each quaternion track go in a sample.
+    std::vector<std::size_t> m_quaternionOffsets;
+    /// The amount of floats of a sample.
+    std::size_t m_floats;
+    /// Room for the keyframes and times to pass to Quaternion::slerp, four
+    /// floats each for the first, then the second keyframes, then the results,
+    /// and then one float each for the times.
+    mutable std::vector<float> m_scratch;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_ANIMATION_H
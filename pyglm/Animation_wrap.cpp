@@ -0,0 +1,351 @@
+#include "Animation_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Quaternion_wrap.hpp"
+#include "Util_wrap.hpp"
+
+#include <vector>
+
+namespace {
+
+// The keyframe times and keys given to the constructor of the track called
+// \a name, checking there are as many of both and that the times are sorted.
+void keyframes_from(const Py::Tuple& args, const Py::Dict& kwds, const char* name, std::vector<float>& times, Py::Sequence& keys)
+{
+    Py::Object times_arg = argument(args, kwds, 0, "times");
+    Py::Object keys_arg = argument(args, kwds, 1, "keys");
+    if(args.length() + kwds.length() != 2 || !times_arg.isSequence() || !keys_arg.isSequence()) {
+        throw Py::TypeError(std::string(name) + " takes a sequence of keyframe times and a sequence of as many keys: " + name + "(times, keys).");
+    }
+
+    Py::Sequence times_seq(times_arg);
+    keys = Py::Sequence(keys_arg);
+    if(times_seq.length() != keys.length()) {
+        throw Py::ValueError(std::string(name) + " needs as many keys as keyframe times.");
+    }
+
+    resize_or_raise(times, times_seq.length());
+    for(Py::Sequence::size_type i = 0 ; i < times_seq.length() ; ++i) {
+        times[i] = Py::Float(times_seq[i]);
+    }
+
+    const std::size_t bad = PyGlMath::VectorTrack::sorted(times.empty() ? 0 : &times[0], times.size());
+    if(bad != times.size()) {
+        std::OSTRSTREAM ss;
+        ss << "The keyframe times of a " << name << " need to be strictly increasing, " << times[bad] << " at index " << bad << " isn't.";
+        throw Py::ValueError(ss.str());
+    }
+}
+
+PyGlMath::VectorTrack vector_track_from(const Py::Tuple& args, const Py::Dict& kwds)
+{
+    std::vector<float> times;
+    Py::Sequence keys_seq;
+    keyframes_from(args, kwds, "VectorTrack", times, keys_seq);
+
+    std::vector<PyGlMath::Vector> keys;
+    reserve_or_raise(keys, times.size());
+    for(Py::Sequence::size_type i = 0 ; i < keys_seq.length() ; ++i) {
+        keys.push_back(vector_from(keys_seq[i], "The keys of a VectorTrack need to be Vector objects or iterables of up to three numbers."));
+    }
+    return PyGlMath::VectorTrack(times.empty() ? 0 : &times[0], keys.empty() ? 0 : &keys[0], times.size());
+}
+
+PyGlMath::QuaternionTrack quaternion_track_from(const Py::Tuple& args, const Py::Dict& kwds)
+{
+    std::vector<float> times;
+    Py::Sequence keys_seq;
+    keyframes_from(args, kwds, "QuaternionTrack", times, keys_seq);
+
+    std::vector<PyGlMath::Quaternion> keys;
+    reserve_or_raise(keys, times.size());
+    for(Py::Sequence::size_type i = 0 ; i < keys_seq.length() ; ++i) {
+        keys.push_back(quaternion_from(keys_seq[i], "The keys of a QuaternionTrack need to be Quaternion objects or iterables of their four components."));
+    }
+    return PyGlMath::QuaternionTrack(times.empty() ? 0 : &times[0], keys.empty() ? 0 : &keys[0], times.size());
+}
+
+// The keyframe index given as argument \a i, checked against the amount of keyframes.
+std::size_t key_index(std::size_t n, const Py::Tuple& args, int i, const char* name)
+{
+    long idx = Py::Long(args[i]).as_long();
+    if(idx < 0 || static_cast<std::size_t>(idx) >= n) {
+        throw Py::IndexError(std::string(name) + ".key keyframe index out of range");
+    }
+    return static_cast<std::size_t>(idx);
+}
+
+// The time given as single argument to sample.
+float sample_time(const Py::Object& o, const char* name)
+{
+    try {
+        return Py::Float(o);
+    } catch(const Py::Exception&) {
+        throw Py::TypeError(std::string(name) + ".sample takes the time at which to sample as a number.");
+    }
+}
+
+template<class T>
+Py::Object times_of(const T& track)
+{
+    Py::List l(track.size());
+    for(std::size_t i = 0 ; i < track.size() ; ++i) {
+        l[i] = Py::Float(track.time(i));
+    }
+    return l;
+}
+
+}
+
+//////////////////////////////
+//////////////////////////////
+//// The VectorTrack part ////
+//////////////////////////////
+//////////////////////////////
+
+VectorTrack::VectorTrack(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<VectorTrack>::PythonClass(self, args, kwds)
+    , m_track(vector_track_from(args, kwds))
+{ }
+
+VectorTrack::~VectorTrack()
+{ }
+
+void VectorTrack::init_type()
+{
+    behaviors().name("VectorTrack");
+    behaviors().doc("The keyframes of a Vector changing over time: VectorTrack(times, keys), with strictly increasing times. sample(t) interpolates linearly, playing forward finds the keyframes without searching.");
+    behaviors().supportRepr();
+    behaviors().supportSequenceType();
+
+    PYCXX_ADD_NOARGS_METHOD(times, times, "Returns the list of the times of all keyframes.");
+    PYCXX_ADD_VARARGS_METHOD(key, key, "Returns the Vector of the keyframe given by index.");
+    PYCXX_ADD_VARARGS_METHOD(sample, sample, "Returns the Vector at the given time, interpolated linearly between the keyframes around it. Clamps to the first and last keyframes.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object VectorTrack::repr()
+{
+    std::OSTRSTREAM ss;
+    ss << "VectorTrack(" << m_track.size() << " keyframes)";
+    return Py::String(ss.str());
+}
+
+int VectorTrack::sequence_length()
+{
+    return static_cast<int>(m_track.size());
+}
+
+Py::Object VectorTrack::times()
+{
+    return times_of(m_track);
+}
+
+Py::Object VectorTrack::key(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("VectorTrack.key takes the index of a keyframe.");
+    }
+
+    return Vector::make_inst(m_track.key(key_index(m_track.size(), args, 0, "VectorTrack")));
+}
+
+Py::Object VectorTrack::sample(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("VectorTrack.sample takes the time at which to sample as a number.");
+    }
+
+    return Vector::make_inst(m_track.sample(sample_time(args[0], "VectorTrack")));
+}
+
+//////////////////////////////////
+//////////////////////////////////
+//// The QuaternionTrack part ////
+//////////////////////////////////
+//////////////////////////////////
+
+QuaternionTrack::QuaternionTrack(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<QuaternionTrack>::PythonClass(self, args, kwds)
+    , m_track(quaternion_track_from(args, kwds))
+{ }
+
+QuaternionTrack::~QuaternionTrack()
+{ }
+
+void QuaternionTrack::init_type()
+{
+    behaviors().name("QuaternionTrack");
+    behaviors().doc("The keyframes of a Quaternion changing over time: QuaternionTrack(times, keys), with strictly increasing times. sample(t) interpolates by slerp along the shortest way, playing forward finds the keyframes without searching.");
+    behaviors().supportRepr();
+    behaviors().supportSequenceType();
+
+    PYCXX_ADD_NOARGS_METHOD(times, times, "Returns the list of the times of all keyframes.");
+    PYCXX_ADD_VARARGS_METHOD(key, key, "Returns the Quaternion of the keyframe given by index, which may have been flipped to the side of the one before it.");
+    PYCXX_ADD_VARARGS_METHOD(sample, sample, "Returns the Quaternion at the given time, interpolated by slerp between the keyframes around it. Clamps to the first and last keyframes.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object QuaternionTrack::repr()
+{
+    std::OSTRSTREAM ss;
+    ss << "QuaternionTrack(" << m_track.size() << " keyframes)";
+    return Py::String(ss.str());
+}
+
+int QuaternionTrack::sequence_length()
+{
+    return static_cast<int>(m_track.size());
+}
+
+Py::Object QuaternionTrack::times()
+{
+    return times_of(m_track);
+}
+
+Py::Object QuaternionTrack::key(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("QuaternionTrack.key takes the index of a keyframe.");
+    }
+
+    return Quaternion::make_inst(m_track.key(key_index(m_track.size(), args, 0, "QuaternionTrack")));
+}
+
+Py::Object QuaternionTrack::sample(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("QuaternionTrack.sample takes the time at which to sample as a number.");
+    }
+
+    return Quaternion::make_inst(m_track.sample(sample_time(args[0], "QuaternionTrack")));
+}
+
+////////////////////////////////
+////////////////////////////////
+//// The AnimationClip part ////
+////////////////////////////////
+////////////////////////////////
+
+AnimationClip::AnimationClip(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<AnimationClip>::PythonClass(self, args, kwds)
+    , m_clip()
+{
+    if(args.length() + kwds.length() > 1) {
+        throw Py::TypeError("AnimationClip takes an optional sequence of VectorTrack and QuaternionTrack objects: AnimationClip(tracks).");
+    }
+
+    Py::Object tracks = argument(args, kwds, 0, "tracks");
+    if(tracks.isNone()) {
+        return;
+    } else if(!tracks.isSequence()) {
+        throw Py::TypeError("AnimationClip takes an optional sequence of VectorTrack and QuaternionTrack objects: AnimationClip(tracks).");
+    }
+
+    Py::Sequence s(tracks);
+    for(Py::Sequence::size_type i = 0 ; i < s.length() ; ++i) {
+        add_track(s[i]);
+    }
+}
+
+AnimationClip::~AnimationClip()
+{ }
+
+void AnimationClip::init_type()
+{
+    behaviors().name("AnimationClip");
+    behaviors().doc("All tracks of an animation, sampled together: AnimationClip(tracks). sample(t) writes three floats per VectorTrack and four per QuaternionTrack, in the order they were added. Adding the translation, rotation and scale tracks of every node gives what TransformHierarchy.setLocals takes.");
+    behaviors().supportRepr();
+    behaviors().supportSequenceType();
+
+    PYCXX_ADD_VARARGS_METHOD(add, add, "Adds a copy of a VectorTrack or QuaternionTrack. Returns the index of its first float in a sample.");
+    PYCXX_ADD_NOARGS_METHOD(floats, floats, "Returns the amount of floats a sample of all tracks takes.");
+    PYCXX_ADD_NOARGS_METHOD(duration, duration, "Returns the time of the last keyframe of all tracks.");
+    PYCXX_ADD_KEYWORDS_METHOD(sample, sample, "Samples all tracks at the same time: sample(t, out=None). Writes floats() floats to 'out', or returns an array.array if not given.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object AnimationClip::repr()
+{
+    std::OSTRSTREAM ss;
+    ss << "AnimationClip(" << m_clip.size() << " tracks)";
+    return Py::String(ss.str());
+}
+
+int AnimationClip::sequence_length()
+{
+    return static_cast<int>(m_clip.size());
+}
+
+std::size_t AnimationClip::add_track(const Py::Object& o)
+{
+    if(VectorTrack::check(o)) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_clip.add(cxx_object<VectorTrack>(o.ptr())->m_track);
+    } else if(QuaternionTrack::check(o)) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_clip.add(cxx_object<QuaternionTrack>(o.ptr())->m_track);
+    }
+
+    throw Py::TypeError("An AnimationClip only holds VectorTrack and QuaternionTrack objects.");
+}
+
+Py::Object AnimationClip::add(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("AnimationClip.add takes a VectorTrack or a QuaternionTrack.");
+    }
+
+    return Py::Long(static_cast<long>(add_track(args[0])));
+}
+
+Py::Object AnimationClip::floats()
+{
+    return Py::Long(static_cast<long>(m_clip.floats()));
+}
+
+Py::Object AnimationClip::duration()
+{
+    return Py::Float(m_clip.duration());
+}
+
+bool AnimationClip::sample_into(float t, float* out, std::size_t n)
+{
+    // The mutex is taken once the GIL is gone and released before getting
+    // it back, \see AllowThreads.
+    AllowThreads nogil(n);
+    std::lock_guard<std::mutex> lock(m_lock);
+    if(m_clip.floats() != n) {
+        return false;
+    }
+    m_clip.sample(t, out);
+    return true;
+}
+
+Py::Object AnimationClip::sample(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() < 1 || args.length() + kwargs.length() > 2) {
+        throw Py::TypeError("AnimationClip.sample takes the time at which to sample and optionally an 'out' buffer.");
+    }
+
+    const float t = sample_time(argument(args, kwargs, 0, "t"), "AnimationClip");
+    Py::Object out_arg = argument(args, kwargs, 1, "out");
+    if(out_arg.isNone()) {
+        std::vector<float> out;
+        do {
+            resize_or_raise(out, m_clip.floats());
+        } while(!sample_into(t, out.empty() ? 0 : &out[0], out.size()));
+        return float_array(out.empty() ? 0 : &out[0], out.size());
+    }
+
+    FloatBufferArg out(out_arg, true, "out");
+    if(!sample_into(t, out.data(), out.size())) {
+        throw Py::ValueError("The output of AnimationClip.sample needs to hold floats() floats.");
+    }
+    return out_arg;
+}
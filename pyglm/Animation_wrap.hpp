@@ -0,0 +1,90 @@
+#include "Animation.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+#include <mutex>
+
+class VectorTrack : public Py::PythonClass<VectorTrack>
+{
+public:
+    VectorTrack(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    virtual ~VectorTrack();
+
+    static void init_type();
+
+    PyGlMath::VectorTrack m_track;
+
+private:
+    Py::Object repr();
+
+    int sequence_length();
+
+    Py::Object times();
+    PYCXX_NOARGS_METHOD_DECL(VectorTrack, times);
+    Py::Object key(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(VectorTrack, key);
+    Py::Object sample(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(VectorTrack, sample);
+};
+
+class QuaternionTrack : public Py::PythonClass<QuaternionTrack>
+{
+public:
+    QuaternionTrack(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    virtual ~QuaternionTrack();
+
+    static void init_type();
+
+    PyGlMath::QuaternionTrack m_track;
+
+private:
+    Py::Object repr();
+
+    int sequence_length();
+
+    Py::Object times();
+    PYCXX_NOARGS_METHOD_DECL(QuaternionTrack, times);
+    Py::Object key(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(QuaternionTrack, key);
+    Py::Object sample(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(QuaternionTrack, sample);
+};
+
+class AnimationClip : public Py::PythonClass<AnimationClip>
+{
+public:
+    AnimationClip(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    virtual ~AnimationClip();
+
+    static void init_type();
+
+    PyGlMath::AnimationClip m_clip;
+
+private:
+    Py::Object repr();
+
+    int sequence_length();
+
+    /// Adds the track \a o, raising a TypeError if it isn't one. \return Its offset.
+    std::size_t add_track(const Py::Object& o);
+    /// Samples all tracks at \a t into the \a n floats at \a out, letting
+    /// other threads run if there are enough of them. \return false, leaving
+    /// \a out untouched, if the clip doesn't take \a n floats, as another
+    /// thread added a track since they were counted.
+    bool sample_into(float t, float* out, std::size_t n);
+
+    Py::Object add(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(AnimationClip, add);
+    Py::Object floats();
+    PYCXX_NOARGS_METHOD_DECL(AnimationClip, floats);
+    Py::Object duration();
+    PYCXX_NOARGS_METHOD_DECL(AnimationClip, duration);
+    Py::Object sample(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(AnimationClip, sample);
+
+    /// Guards the cursors of m_clip, which sample moves without the GIL.
+    std::mutex m_lock;
+};
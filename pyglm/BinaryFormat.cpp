@@ -0,0 +1,378 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "BinaryFormat.hpp"
+#include "Vector.hpp"
+#include "VectorArray.hpp"
+#include "Quaternion.hpp"
+#include "Matrix.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+using PyGlMath::BinaryFormat;
+
+const char magic[4] = {'P', 'G', 'L', 'M'};
+
+bool little_endian()
+{
+    const uint32_t one = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+// The integers of the header go byte by byte, which works on any machine.
+void put(unsigned char *out, uint64_t value, std::size_t bytes)
+{
+    for(std::size_t i = 0 ; i < bytes ; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8*i));
+    }
+}
+
+uint64_t get(const unsigned char *in, std::size_t bytes)
+{
+    uint64_t value = 0;
+    for(std::size_t i = 0 ; i < bytes ; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8*i);
+    }
+    return value;
+}
+
+// The floats go in bulk, only big-endian machines need to swap their bytes.
+void put_floats(unsigned char *out, const float *in, std::size_t n)
+{
+    std::memcpy(out, in, n*sizeof(float));
+    if(!little_endian()) {
+        for(std::size_t i = 0 ; i < n ; ++i) {
+            std::swap(out[4*i+0], out[4*i+3]);
+            std::swap(out[4*i+1], out[4*i+2]);
+        }
+    }
+}
+
+void get_floats(float *out, const unsigned char *in, std::size_t n)
+{
+    if(little_endian()) {
+        std::memcpy(out, in, n*sizeof(float));
+        return;
+    }
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        const unsigned char swapped[4] = {in[4*i+3], in[4*i+2], in[4*i+1], in[4*i+0]};
+        std::memcpy(out + i, swapped, sizeof(float));
+    }
+}
+
+// Writes the header of a block and results in where its elements go.
+unsigned char *put_header(void *out_buf, BinaryFormat::Type type, std::size_t n)
+{
+    unsigned char *out = static_cast<unsigned char*>(out_buf);
+    std::memcpy(out, magic, sizeof(magic));
+    put(out + 4, BinaryFormat::Version, 4);
+    put(out + 8, type, 4);
+    put(out + 12, BinaryFormat::floatsPerElement(type), 4);
+    put(out + 16, n, 8);
+    put(out + 24, 0, 8);
+    return out + BinaryFormat::HeaderSize;
+}
+
+// Checks the block holds elements of the given type and results in the first
+// of them, or NULL if it doesn't.
+const unsigned char *elements(const void *in_buf, std::size_t in_size, BinaryFormat::Type type, std::size_t& out_n)
+{
+    BinaryFormat::Header header;
+    if(!BinaryFormat::readHeader(in_buf, in_size, header) || header.type != static_cast<uint32_t>(type)) {
+        return 0;
+    }
+
+    out_n = static_cast<std::size_t>(header.count);
+    return static_cast<const unsigned char*>(in_buf) + BinaryFormat::HeaderSize;
+}
+
+}
+
+namespace PyGlMath {
+
+std::size_t BinaryFormat::floatsPerElement(Type in_type)
+{
+    switch(in_type) {
+    case VectorType: return 3;
+    case QuaternionType: return 4;
+    case AffineMatrixType: return 32;
+    case General4x4MatrixType: return 32;
+    case AffineMatrixWithoutInverseType: return 16;
+    case VectorArrayType: return 3;
+    }
+
+    return 0;
+}
+
+std::size_t BinaryFormat::size(Type in_type, std::size_t in_n)
+{
+    return HeaderSize + in_n*floatsPerElement(in_type)*sizeof(float);
+}
+
+////////////////////////////
+// Writing binary blocks. //
+////////////////////////////
+
+std::size_t BinaryFormat::writeHeader(Type in_type, std::size_t in_n, void *out_buf)
+{
+    put_header(out_buf, in_type, in_n);
+    return HeaderSize;
+}
+
+std::size_t BinaryFormat::write(const Vector *in_v, std::size_t in_n, void *out_buf)
+{
+    unsigned char *out = put_header(out_buf, VectorType, in_n);
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        const float v[3] = {in_v[i].x(), in_v[i].y(), in_v[i].z()};
+        put_floats(out + i*sizeof(v), v, 3);
+    }
+
+    return size(VectorType, in_n);
+}
+
+std::size_t BinaryFormat::write(const VectorArray& in_a, void *out_buf)
+{
+    unsigned char *out = put_header(out_buf, VectorArrayType, in_a.size());
+    for(std::size_t i = 0 ; i < in_a.size() ; ++i) {
+        const float v[3] = {in_a.x()[i], in_a.y()[i], in_a.z()[i]};
+        put_floats(out + i*sizeof(v), v, 3);
+    }
+
+    return size(VectorArrayType, in_a.size());
+}
+
+std::size_t BinaryFormat::write(const Quaternion *in_q, std::size_t in_n, void *out_buf)
+{
+    unsigned char *out = put_header(out_buf, QuaternionType, in_n);
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        put_floats(out + i*4*sizeof(float), in_q[i].array4f(), 4);
+    }
+
+    return size(QuaternionType, in_n);
+}
+
+std::size_t BinaryFormat::write(const AffineMatrix *in_m, std::size_t in_n, void *out_buf, bool in_bInverses)
+{
+    if(!in_bInverses) {
+        unsigned char *out = put_header(out_buf, AffineMatrixWithoutInverseType, in_n);
+        for(std::size_t i = 0 ; i < in_n ; ++i) {
+            put_floats(out + i*16*sizeof(float), in_m[i].array16f(), 16);
+        }
+
+        return size(AffineMatrixWithoutInverseType, in_n);
+    }
+
+    unsigned char *out = put_header(out_buf, AffineMatrixType, in_n);
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        put_floats(out + i*32*sizeof(float), in_m[i].array16f(), 16);
+        put_floats(out + i*32*sizeof(float) + 16*sizeof(float), in_m[i].array16fInverse(), 16);
+    }
+
+    return size(AffineMatrixType, in_n);
+}
+
+std::size_t BinaryFormat::write(const General4x4Matrix *in_m, std::size_t in_n, void *out_buf)
+{
+    unsigned char *out = put_header(out_buf, General4x4MatrixType, in_n);
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        put_floats(out + i*32*sizeof(float), in_m[i].array16f(), 16);
+        put_floats(out + i*32*sizeof(float) + 16*sizeof(float), in_m[i].array16fInverse(), 16);
+    }
+
+    return size(General4x4MatrixType, in_n);
+}
+
+////////////////////////////
+// Reading binary blocks. //
+////////////////////////////
+
+bool BinaryFormat::readHeader(const void *in_buf, std::size_t in_size, Header& out_header)
+{
+    if(in_buf == 0 || in_size < HeaderSize) {
+        return false;
+    }
+
+    const unsigned char *in = static_cast<const unsigned char*>(in_buf);
+    Header h;
+    h.version = static_cast<uint32_t>(get(in + 4, 4));
+    h.type = static_cast<uint32_t>(get(in + 8, 4));
+    h.floatsPerElement = static_cast<uint32_t>(get(in + 12, 4));
+    h.count = get(in + 16, 8);
+
+    if(std::memcmp(in, magic, sizeof(magic)) != 0 || h.version < 1 || h.version > Version) {
+        return false;
+    }
+
+    if(h.type < VectorType || h.type > VectorArrayType
+    || h.floatsPerElement != floatsPerElement(static_cast<Type>(h.type))) {
+        return false;
+    }
+
+    // Written this way round, a huge count can't overflow.
+    if(h.count > (in_size - HeaderSize) / (h.floatsPerElement*sizeof(float))) {
+        return false;
+    }
+
+    out_header = h;
+    return true;
+}
+
+bool BinaryFormat::read(const void *in_buf, std::size_t in_size, std::vector<Vector>& out_v)
+{
+    std::size_t n = 0;
+    const unsigned char *in = elements(in_buf, in_size, VectorType, n);
+    if(in == 0) {
+        in = elements(in_buf, in_size, VectorArrayType, n);
+    }
+    if(in == 0) {
+        return false;
+    }
+
+    std::vector<Vector> result;
+    result.reserve(n);
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        float v[3];
+        get_floats(v, in + i*sizeof(v), 3);
+        result.push_back(Vector(v[0], v[1], v[2]));
+    }
+
+    out_v.swap(result);
+    return true;
+}
+
+bool BinaryFormat::read(const void *in_buf, std::size_t in_size, VectorArray& out_a)
+{
+    std::size_t n = 0;
+    const unsigned char *in = elements(in_buf, in_size, VectorType, n);
+    if(in == 0) {
+        in = elements(in_buf, in_size, VectorArrayType, n);
+    }
+    if(in == 0) {
+        return false;
+    }
+
+    VectorArray result(n);
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        float v[3];
+        get_floats(v, in + i*sizeof(v), 3);
+        result.x()[i] = v[0];
+        result.y()[i] = v[1];
+        result.z()[i] = v[2];
+    }
+
+    out_a.swap(result);
+    return true;
+}
+
+bool BinaryFormat::read(const void *in_buf, std::size_t in_size, std::vector<Quaternion>& out_q)
+{
+    std::size_t n = 0;
+    const unsigned char *in = elements(in_buf, in_size, QuaternionType, n);
+    if(in == 0) {
+        return false;
+    }
+
+    std::vector<Quaternion> result(n);
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        get_floats(result[i].array4f(), in + i*4*sizeof(float), 4);
+    }
+
+    out_q.swap(result);
+    return true;
+}
+
+bool BinaryFormat::read(const void *in_buf, std::size_t in_size, std::vector<AffineMatrix>& out_m)
+{
+    std::size_t n = 0;
+    const unsigned char *in = elements(in_buf, in_size, AffineMatrixType, n);
+    const bool inverses = in != 0;
+    if(!inverses) {
+        in = elements(in_buf, in_size, AffineMatrixWithoutInverseType, n);
+    }
+    if(in == 0) {
+        return false;
+    }
+
+    const std::size_t stride = (inverses ? 32 : 16)*sizeof(float);
+    std::vector<AffineMatrix> result(n);
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        AffineMatrix& m = result[i];
+        get_floats(m.m, in + i*stride, 16);
+        if(inverses) {
+            get_floats(m.im, in + i*stride + 16*sizeof(float), 16);
+        }
+        m.m_bInverseDirty = !inverses;
+
+        // 3x3 parts are just copied over.
+
+        m.m3[0] = m.m[0]; m.m3[3] = m.m[4]; m.m3[6] = m.m[8];
+        m.m3[1] = m.m[1]; m.m3[4] = m.m[5]; m.m3[7] = m.m[9];
+        m.m3[2] = m.m[2]; m.m3[5] = m.m[6]; m.m3[8] = m.m[10];
+
+        m.im3[0] = m.im[0]; m.im3[3] = m.im[4]; m.im3[6] = m.im[8];
+        m.im3[1] = m.im[1]; m.im3[4] = m.im[5]; m.im3[7] = m.im[9];
+        m.im3[2] = m.im[2]; m.im3[5] = m.im[6]; m.im3[8] = m.im[10];
+    }
+
+    out_m.swap(result);
+    return true;
+}
+
+bool BinaryFormat::read(const void *in_buf, std::size_t in_size, std::vector<General4x4Matrix>& out_m)
+{
+    std::size_t n = 0;
+    const unsigned char *in = elements(in_buf, in_size, General4x4MatrixType, n);
+    if(in == 0) {
+        return false;
+    }
+
+    std::vector<General4x4Matrix> result(n);
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        get_floats(result[i].m, in + i*32*sizeof(float), 16);
+        get_floats(result[i].im, in + i*32*sizeof(float) + 16*sizeof(float), 16);
+        result[i].m_bInverseDirty = false;
+    }
+
+    out_m.swap(result);
+    return true;
+}
+
+const float *BinaryFormat::floats(const void *in_buf, std::size_t in_size, Type in_type, std::size_t& out_n)
+{
+    std::size_t n = 0;
+    const unsigned char *in = elements(in_buf, in_size, in_type, n);
+    if(in == 0 || !little_endian() || reinterpret_cast<uintptr_t>(in) % sizeof(float) != 0) {
+        return 0;
+    }
+
+    out_n = n;
+    return reinterpret_cast<const float*>(in);
+}
+
+} // namespace PyGlMath
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_BINARYFORMAT_H
+#define PYGLM_BINARYFORMAT_H
+
+#include "Util.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <stdint.h>
+
+namespace PyGlMath {
+    class Vector;
+    class VectorArray;
+    class Quaternion;
+    class AffineMatrix;
+    class General4x4Matrix;
+
+/// Reads and writes blocks of vectors, quaternions or matrices in a compact
+/// binary form, as opposed to the text written by the << and >> operators.\n
+/// A block is a Header followed by the elements, packed one after the other.
+/// Everything is little-endian, whatever the machine writing or reading it.
+/// The header is 32 bytes long, so a block starting at an address aligned to
+/// 16 bytes (as are mmap'd files) has its floats aligned to 16 bytes too.\n
+/// Reading doesn't parse anything: on little-endian machines, the floats of a
+/// block can even be used right where they are, \see floats.
+class BinaryFormat {
+public:
+    /// What the elements of a block are, and how they're stored.
+    enum Type {
+        /// x y z, the w component is not stored.
+        VectorType = 1,
+        /// x y z w.
+        QuaternionType = 2,
+        /// The 16 floats of the matrix followed by the 16 of its inverse,
+        /// both in column-wise representation.
+        AffineMatrixType = 3,
+        /// Same as AffineMatrixType.
+        General4x4MatrixType = 4,
+        /// The 16 floats of the matrix only, in column-wise representation.
+        /// The inverses are computed when needed after reading.
+        AffineMatrixWithoutInverseType = 5,
+        /// Same as VectorType, but written from a VectorArray, such that it
+        /// can be read back as one.
+        VectorArrayType = 6
+    };
+
+    /// The version of the format written. Blocks of newer versions are refused.
+    static const uint32_t Version = 1;
+    /// The size in bytes of the header.
+    static const std::size_t HeaderSize = 32;
+
+    /// The header every block starts with, as read by readHeader.
+    struct Header {
+        /// The version the block was written in.
+        uint32_t version;
+        /// What the elements are, one of Type.
+        uint32_t type;
+        /// The amount of floats each element is made of.
+        uint32_t floatsPerElement;
+        /// The amount of elements following the header.
+        uint64_t count;
+    };
+
+    /// \return The amount of floats each element of type \a in_type is made of.
+    static std::size_t floatsPerElement(Type in_type);
+    /// \return The size in bytes of a block holding \a in_n elements of type
+    ///         \a in_type, header included.
+    static std::size_t size(Type in_type, std::size_t in_n);
+
+    ////////////////////////////
+    // Writing binary blocks. //
+    ////////////////////////////
+
+    /// Writes only the header of a block, for writing its elements piece by
+    /// piece, for instance straight to a file.
+    /// \param in_type What the elements of the block are.
+    /// \param in_n The amount of elements which will follow the header.
+    /// \param out_buf Where to write the HeaderSize bytes to, it may be unaligned.
+    /// \return The amount of bytes written.
+    static std::size_t writeHeader(Type in_type, std::size_t in_n, void *out_buf);
+
+    /// Writes a block holding the \a in_n vectors \a in_v.
+    /// \param out_buf Where to write the block to. It needs room for
+    ///                size(VectorType, in_n) bytes and may be unaligned.
+    /// \return The amount of bytes written.
+    static std::size_t write(const Vector *in_v, std::size_t in_n, void *out_buf);
+    /// Writes a block holding all vectors of \a in_a, of VectorArrayType.
+    /// \see write(const Vector*, std::size_t, void*)
+    static std::size_t write(const VectorArray& in_a, void *out_buf);
+    /// Writes a block holding the \a in_n quaternions \a in_q.
+    /// \see write(const Vector*, std::size_t, void*)
+    static std::size_t write(const Quaternion *in_q, std::size_t in_n, void *out_buf);
+    /// Writes a block holding the \a in_n matrices \a in_m, along with their
+    /// inverses unless \a in_bInverses is false, which halves the size.
+    /// \see write(const Vector*, std::size_t, void*)
+    static std::size_t write(const AffineMatrix *in_m, std::size_t in_n, void *out_buf, bool in_bInverses = true);
+    /// Writes a block holding the \a in_n matrices \a in_m along with their inverses.
+    /// \see write(const Vector*, std::size_t, void*)
+    static std::size_t write(const General4x4Matrix *in_m, std::size_t in_n, void *out_buf);
+
+    ////////////////////////////
+    // Reading binary blocks. //
+    ////////////////////////////
+
+    /// Reads and checks the header of a block.
+    /// \param in_buf The block, it may be unaligned.
+    /// \param in_size The size in bytes of \a in_buf. It may be more than the block.
+    /// \param out_header Where to store the header.
+    /// \return false if \a in_buf doesn't start with a complete block this
+    ///         code can read, in which case \a out_header is left untouched.
+    static bool readHeader(const void *in_buf, std::size_t in_size, Header& out_header);
+
+    /// Reads a block of vectors.
+    /// \param in_buf The block, it may be unaligned.
+    /// \param in_size The size in bytes of \a in_buf. It may be more than the block.
+    /// \param out_v Replaced by the vectors read.
+    /// \return false if \a in_buf doesn't start with a complete block of
+    ///         vectors, in which case \a out_v is left untouched.
+    /// \note Both this and the next one read blocks of VectorType and of
+    ///       VectorArrayType alike.
+    static bool read(const void *in_buf, std::size_t in_size, std::vector<Vector>& out_v);
+    /// Reads a block of vectors into an array.
+    /// \see read(const void*, std::size_t, std::vector<Vector>&)
+    static bool read(const void *in_buf, std::size_t in_size, VectorArray& out_a);
+    /// Reads a block of quaternions.
+    /// \see read(const void*, std::size_t, std::vector<Vector>&)
+    static bool read(const void *in_buf, std::size_t in_size, std::vector<Quaternion>& out_q);
+    /// Reads a block of affine matrices. Their inverse is read, not computed,
+    /// unless the block doesn't hold them. These are computed when needed.
+    /// \see read(const void*, std::size_t, std::vector<Vector>&)
+    static bool read(const void *in_buf, std::size_t in_size, std::vector<AffineMatrix>& out_m);
+    /// Reads a block of general matrices. Their inverse is read, not computed.
+    /// \see read(const void*, std::size_t, std::vector<Vector>&)
+    static bool read(const void *in_buf, std::size_t in_size, std::vector<General4x4Matrix>& out_m);
+
+    /// Gives access to the floats of a block without copying them, for
+    /// instance to hand the matrices of an mmap'd file to OpenGL.
+    /// \param in_buf The block. It needs to be aligned to 4 bytes at least.
+    /// \param in_size The size in bytes of \a in_buf. It may be more than the block.
+    /// \param in_type The type of elements the block needs to hold.
+    /// \param out_n Where to store the amount of elements in the block.
+    /// \return The floats of the first element, the others following it, or
+    ///         NULL if \a in_buf doesn't start with a complete block of
+    ///         \a in_type elements, is misaligned or this machine is big-endian.
+    static const float *floats(const void *in_buf, std::size_t in_size, Type in_type, std::size_t& out_n);
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_BINARYFORMAT_H
@@ -0,0 +1,176 @@
+#include "BinaryFormat_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Quaternion_wrap.hpp"
+#include "Matrix_wrap.hpp"
+#include "VectorArray_wrap.hpp"
+
+#include <vector>
+
+using PyGlMath::BinaryFormat;
+
+namespace {
+
+// Borrows the bytes of any object supporting the buffer protocol, for as
+// long as it lives.
+class BytesArg {
+public:
+    BytesArg(const Py::Object& obj)
+    {
+        if(PyObject_GetBuffer(obj.ptr(), &m_view, PyBUF_SIMPLE) != 0) {
+            PyErr_Clear();
+            throw Py::TypeError("fromBinary takes a bytes-like object, such as bytes or mmap.");
+        }
+    }
+
+    ~BytesArg()
+    {
+        PyBuffer_Release(&m_view);
+    }
+
+    const void* data() const {return m_view.buf;}
+    std::size_t size() const {return static_cast<std::size_t>(m_view.len);}
+
+private:
+    BytesArg(const BytesArg&);
+    BytesArg& operator=(const BytesArg&);
+
+    Py_buffer m_view;
+};
+
+BinaryFormat::Type binary_type(const PyGlMath::Vector*, bool) {return BinaryFormat::VectorType;}
+BinaryFormat::Type binary_type(const PyGlMath::Quaternion*, bool) {return BinaryFormat::QuaternionType;}
+BinaryFormat::Type binary_type(const PyGlMath::AffineMatrix*, bool inverses) {return inverses ? BinaryFormat::AffineMatrixType : BinaryFormat::AffineMatrixWithoutInverseType;}
+BinaryFormat::Type binary_type(const PyGlMath::General4x4Matrix*, bool) {return BinaryFormat::General4x4MatrixType;}
+
+// Only affine matrices may be written without their inverse.
+template<class V>
+std::size_t write_block(const V* values, std::size_t n, void* out, bool)
+{
+    return BinaryFormat::write(values, n, out);
+}
+
+std::size_t write_block(const PyGlMath::AffineMatrix* values, std::size_t n, void* out, bool inverses)
+{
+    return BinaryFormat::write(values, n, out, inverses);
+}
+
+// Gathers the wrapped values of all items of the sequence, which all need to
+// be instances of the wrapper class W, and writes them as one block.
+template<class W, class V>
+Py::Object write_all(const Py::Sequence& s, V W::*value, bool inverses)
+{
+    std::vector<V> values;
+    reserve_or_raise(values, s.length());
+    for(Py::Sequence::size_type i = 0 ; i < s.length() ; ++i) {
+        if(!W::check(s[i])) {
+            throw Py::TypeError("toBinary takes a sequence of objects all of the same type.");
+        }
+        Py::PythonClassObject<W> item(s[i]);
+        values.push_back(item.getCxxObject()->*value);
+    }
+
+    std::vector<char> bytes;
+    resize_or_raise(bytes, BinaryFormat::size(binary_type(static_cast<const V*>(0), inverses), values.size()));
+    {
+        AllowThreads nogil(bytes.size() / sizeof(float));
+        write_block(values.empty() ? 0 : &values[0], values.size(), &bytes[0], inverses);
+    }
+    return Py::Bytes(&bytes[0], bytes.size());
+}
+
+// Wraps the vectors read from a block written from a VectorArray into one.
+Py::Object read_array(const BytesArg& in)
+{
+    PyGlMath::VectorArray arr;
+    {
+        AllowThreads nogil(in.size() / sizeof(float));
+        BinaryFormat::read(in.data(), in.size(), arr);
+    }
+    return VectorArray::make_inst(arr);
+}
+
+// Wraps all values read from a block into a list.
+template<class W, class V>
+Py::Object read_all(const BytesArg& in)
+{
+    std::vector<V> values;
+    {
+        AllowThreads nogil(in.size() / sizeof(float));
+        BinaryFormat::read(in.data(), in.size(), values);
+    }
+
+    Py::List result(values.size());
+    for(std::size_t i = 0 ; i < values.size() ; ++i) {
+        result[i] = W::make_inst(values[i]);
+    }
+    return result;
+}
+
+}
+
+Py::Object to_binary(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() != 1 || kwargs.length() > (kwargs.hasKey("inverses") ? 1 : 0)) {
+        throw Py::TypeError("toBinary takes one argument, the object or sequence of objects to pack, and optionally 'inverses'.");
+    }
+
+    bool inverses = kwargs.hasKey("inverses") ? Py::Object(kwargs["inverses"]).isTrue() : true;
+
+    Py::Object o = args[0];
+    if(VectorArray::check(o)) {
+        VectorArray::VectorArrayObject a(o);
+        const PyGlMath::VectorArray& arr = a.getCxxObject()->m_arr;
+        std::vector<char> bytes;
+        resize_or_raise(bytes, BinaryFormat::size(BinaryFormat::VectorArrayType, arr.size()));
+        {
+            AllowThreads nogil(bytes.size() / sizeof(float));
+            BinaryFormat::write(arr, &bytes[0]);
+        }
+        return Py::Bytes(&bytes[0], bytes.size());
+    }
+
+    // A single object is packed as a sequence of one.
+    if(Vector::check(o) || Quaternion::check(o) || AffineMatrix::check(o) || General4x4Matrix::check(o)) {
+        o = Py::TupleN(o);
+    }
+
+    if(!o.isSequence()) {
+        throw Py::TypeError("toBinary takes a Vector, Quaternion, AffineMatrix, General4x4Matrix or VectorArray, or a sequence of any one of the first four.");
+    }
+
+    // An empty sequence has no type to go by, it makes an empty block of vectors.
+    Py::Sequence s(o);
+    if(s.length() == 0 || Vector::check(s[0])) {
+        return write_all(s, &Vector::m_vec, inverses);
+    } else if(Quaternion::check(s[0])) {
+        return write_all(s, &Quaternion::m_quat, inverses);
+    } else if(AffineMatrix::check(s[0])) {
+        return write_all(s, &AffineMatrix::m_mat, inverses);
+    } else if(General4x4Matrix::check(s[0])) {
+        return write_all(s, &General4x4Matrix::m_mat, inverses);
+    }
+
+    throw Py::TypeError("toBinary takes a sequence of Vector, Quaternion, AffineMatrix or General4x4Matrix objects.");
+}
+
+Py::Object from_binary(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("fromBinary takes one argument, the bytes to read.");
+    }
+
+    BytesArg in(args[0]);
+    BinaryFormat::Header header;
+    if(!BinaryFormat::readHeader(in.data(), in.size(), header)) {
+        throw Py::ValueError("fromBinary needs a complete block written by toBinary, of a version it knows about.");
+    }
+
+    switch(header.type) {
+    case BinaryFormat::VectorType: return read_all<Vector, PyGlMath::Vector>(in);
+    case BinaryFormat::VectorArrayType: return read_array(in);
+    case BinaryFormat::QuaternionType: return read_all<Quaternion, PyGlMath::Quaternion>(in);
+    case BinaryFormat::AffineMatrixType:
+    case BinaryFormat::AffineMatrixWithoutInverseType: return read_all<AffineMatrix, PyGlMath::AffineMatrix>(in);
+    default: return read_all<General4x4Matrix, PyGlMath::General4x4Matrix>(in);
+    }
+}
@@ -0,0 +1,14 @@
+#include "BinaryFormat.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+/// Packs a Vector, Quaternion, AffineMatrix, General4x4Matrix or VectorArray,
+/// or a sequence of any one of the first four, into a bytes object holding a
+/// binary block. Matrices are packed without their inverse if the 'inverses'
+/// keyword argument is false. \see PyGlMath::BinaryFormat
+Py::Object to_binary(const Py::Tuple& args, const Py::Dict& kwargs);
+
+/// Reads a binary block from any object supporting the buffer protocol, such
+/// as bytes or mmap. Results in a list of the vectors, quaternions or matrices.
+Py::Object from_binary(const Py::Tuple& args);
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "DualQuaternion.hpp"
+#include "Matrix.hpp"
+#include "Util.hpp"
+
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+// The rotation of a matrix which may also scale, the scale being divided out
+// of its columns first. Goes by the largest of the diagonal terms, so as not
+// to divide by something near zero (Shepperd's method).
+PyGlMath::Quaternion rotation_of(const PyGlMath::AffineMatrix& m)
+{
+    float r[3][3];
+    for(unsigned int c = 0 ; c < 3 ; ++c) {
+        const float x = m(1, c+1), y = m(2, c+1), z = m(3, c+1);
+        const float l = std::sqrt(x*x + y*y + z*z);
+        const float f = l > 0.0f ? 1.0f / l : 0.0f;
+        r[0][c] = x*f;
+        r[1][c] = y*f;
+        r[2][c] = z*f;
+    }
+
+    const float trace = r[0][0] + r[1][1] + r[2][2];
+    if(trace > 0.0f) {
+        const float s = 2.0f * std::sqrt(1.0f + trace);
+        return PyGlMath::Quaternion((r[2][1] - r[1][2]) / s, (r[0][2] - r[2][0]) / s, (r[1][0] - r[0][1]) / s, 0.25f * s);
+    } else if(r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+        const float s = 2.0f * std::sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]);
+        return PyGlMath::Quaternion(0.25f * s, (r[0][1] + r[1][0]) / s, (r[0][2] + r[2][0]) / s, (r[2][1] - r[1][2]) / s);
+    } else if(r[1][1] > r[2][2]) {
+        const float s = 2.0f * std::sqrt(1.0f + r[1][1] - r[0][0] - r[2][2]);
+        return PyGlMath::Quaternion((r[0][1] + r[1][0]) / s, 0.25f * s, (r[1][2] + r[2][1]) / s, (r[0][2] - r[2][0]) / s);
+    } else {
+        const float s = 2.0f * std::sqrt(1.0f + r[2][2] - r[0][0] - r[1][1]);
+        return PyGlMath::Quaternion((r[0][2] + r[2][0]) / s, (r[1][2] + r[2][1]) / s, 0.25f * s, (r[1][0] - r[0][1]) / s);
+    }
+}
+
+// The Hamilton product a b, written to out, or added to it if \a accumulate.
+// Going through Quaternion::operator * instead costs a call and a temporary
+// for each of the three products of a dual quaternion product.
+inline void hamilton(const float *a, const float *b, float *out, bool accumulate)
+{
+    const float x = a[3]*b[0] + a[0]*b[3] + a[1]*b[2] - a[2]*b[1];
+    const float y = a[3]*b[1] + a[1]*b[3] + a[2]*b[0] - a[0]*b[2];
+    const float z = a[3]*b[2] + a[2]*b[3] + a[0]*b[1] - a[1]*b[0];
+    const float w = a[3]*b[3] - a[0]*b[0] - a[1]*b[1] - a[2]*b[2];
+    if(accumulate) {
+        out[0] += x;
+        out[1] += y;
+        out[2] += z;
+        out[3] += w;
+    } else {
+        out[0] = x;
+        out[1] = y;
+        out[2] = z;
+        out[3] = w;
+    }
+}
+
+// The pure quaternion (v, 0).
+inline PyGlMath::Quaternion pure(const PyGlMath::Vector& v)
+{
+    return PyGlMath::Quaternion(v.x(), v.y(), v.z(), 0.0f);
+}
+
+// The axis part of q.
+inline PyGlMath::Vector axis_part(const PyGlMath::Quaternion& q)
+{
+    return PyGlMath::Vector(q.x(), q.y(), q.z());
+}
+
+}
+
+namespace PyGlMath {
+
+////////////////////////////////////////////
+// Constructors and assignment operators. //
+////////////////////////////////////////////
+
+DualQuaternion::DualQuaternion()
+    : m_real()
+    , m_dual(0.0f, 0.0f, 0.0f, 0.0f)
+{ }
+
+DualQuaternion::DualQuaternion(const Quaternion& in_real, const Quaternion& in_dual)
+    : m_real(in_real)
+    , m_dual(in_dual)
+{ }
+
+DualQuaternion::DualQuaternion(const Vector& in_trans, const Quaternion& in_rot)
+    : m_real(in_rot)
+    , m_dual(pure(in_trans * 0.5f) * in_rot)
+{ }
+
+DualQuaternion::DualQuaternion(const AffineMatrix& in_m)
+    : m_real(rotation_of(in_m))
+    , m_dual(pure(Vector(in_m(1, 4), in_m(2, 4), in_m(3, 4)) * 0.5f) * m_real)
+{ }
+
+/////////////////////////////////////
+// Accessors, getters and setters. //
+/////////////////////////////////////
+
+Vector DualQuaternion::translation() const
+{
+    // The dual part is t/2 r, so t is 2 d r*, of which only the axis part is
+    // not zero.
+    return axis_part(m_dual * m_real.cnj()) * 2.0f;
+}
+
+std::string DualQuaternion::to_s(unsigned int in_iDecimalPlaces) const
+{
+    std::stringstream ss;
+    ss << "real " << m_real.to_s(in_iDecimalPlaces)
+       << ", dual " << m_dual.to_s(in_iDecimalPlaces);
+    return ss.str();
+}
+
+DualQuaternion::operator std::string() const
+{
+    return this->to_s();
+}
+
+/////////////////////////////////
+// Dual quaternion arithmetic. //
+/////////////////////////////////
+
+DualQuaternion DualQuaternion::operator -() const
+{
+    return DualQuaternion(-m_real, -m_dual);
+}
+
+DualQuaternion DualQuaternion::operator +(const DualQuaternion& in_dq) const
+{
+    return DualQuaternion(m_real + in_dq.m_real, m_dual + in_dq.m_dual);
+}
+
+DualQuaternion DualQuaternion::operator *(float in_f) const
+{
+    return DualQuaternion(m_real * in_f, m_dual * in_f);
+}
+
+DualQuaternion DualQuaternion::operator *(const DualQuaternion& in_dq) const
+{
+    // (a + e b)(c + e d) = ac + e (ad + bc), as e^2 = 0. Copying is cheaper
+    // than the constructors, which live in other files.
+    DualQuaternion result(*this);
+    hamilton(m_real.array4f(), in_dq.m_dual.array4f(), result.m_dual.array4f(), false);
+    hamilton(m_dual.array4f(), in_dq.m_real.array4f(), result.m_dual.array4f(), true);
+    hamilton(m_real.array4f(), in_dq.m_real.array4f(), result.m_real.array4f(), false);
+    return result;
+}
+
+void DualQuaternion::operator *=(const DualQuaternion& in_dq)
+{
+    *this = *this * in_dq;
+}
+
+DualQuaternion DualQuaternion::cnj() const
+{
+    return DualQuaternion(m_real.cnj(), m_dual.cnj());
+}
+
+float DualQuaternion::len() const
+{
+    return m_real.len();
+}
+
+DualQuaternion& DualQuaternion::normalize()
+{
+    const float l = this->len();
+    if(!nearZero(l)) {
+        m_real *= 1.0f / l;
+        m_dual *= 1.0f / l;
+    }
+    return *this;
+}
+
+DualQuaternion DualQuaternion::normalized() const
+{
+    return DualQuaternion(*this).normalize();
+}
+
+/////////////////////////////////////
+// Transforming points and others. //
+/////////////////////////////////////
+
+Vector DualQuaternion::operator *(const Vector& in_v) const
+{
+    return m_real.rotate(in_v) + this->translation();
+}
+
+Vector DualQuaternion::direction(const Vector& in_v) const
+{
+    return m_real.rotate(in_v);
+}
+
+AffineMatrix DualQuaternion::matrix() const
+{
+    return AffineMatrix::transformation(this->translation(), m_real);
+}
+
+/////////////////////////////////
+// Interpolation and blending. //
+/////////////////////////////////
+
+DualQuaternion DualQuaternion::sclerp(const DualQuaternion& in_dq, float between) const
+{
+    // The transformation from this to in_dq, taken the short way, raised to
+    // the power of between: a screw motion of angle theta about the axis l,
+    // going d along it, can be scaled by scaling both theta and d.
+    DualQuaternion diff = this->cnj() * in_dq;
+    if(diff.m_real.w() < 0.0f) {
+        diff = -diff;
+    }
+
+    const Vector t = diff.translation();
+    const Vector u = axis_part(diff.m_real);
+    const float s = u.len();
+    if(nearZero(s)) {
+        // No rotation, only a translation.
+        return *this * DualQuaternion(t * between, Quaternion());
+    }
+
+    // The screw: its axis l goes through the point p, so that the moment
+    // p x l of the axis is m.
+    const Vector l = u * (1.0f / s);
+    const float w = clamp(diff.m_real.w(), -1.0f, 1.0f);
+    const float theta = 2.0f * std::atan2(s, w);
+    const float d = t.dot(l);
+    const Vector m = (t.cross(l) + (t - l * d) * (w / s)) * 0.5f;
+
+    const float half = 0.5f * theta * between;
+    const float sh = std::sin(half), ch = std::cos(half);
+    const float dh = 0.5f * d * between;
+    const Vector dual = m * sh + l * (dh * ch);
+    return *this * DualQuaternion(Quaternion(l.x() * sh, l.y() * sh, l.z() * sh, ch),
+                                  Quaternion(dual.x(), dual.y(), dual.z(), -dh * sh));
+}
+
+DualQuaternion DualQuaternion::blend(const DualQuaternion *in_dqs, const float *in_weights, std::size_t in_n)
+{
+    if(in_n == 0) {
+        return DualQuaternion();
+    }
+
+    DualQuaternion sum(Quaternion(0.0f, 0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        const float w = in_dqs[i].m_real.dot(in_dqs[0].m_real) < 0.0f ? -in_weights[i] : in_weights[i];
+        sum.m_real += in_dqs[i].m_real * w;
+        sum.m_dual += in_dqs[i].m_dual * w;
+    }
+    return sum.normalize();
+}
+
+////////////////////////////////////////////
+// Dual quaternion comparison operations. //
+////////////////////////////////////////////
+
+bool DualQuaternion::operator ==(const DualQuaternion& in_dq) const
+{
+    const float sign = m_real.dot(in_dq.m_real) < 0.0f ? -1.0f : 1.0f;
+    for(unsigned int i = 0 ; i < 4 ; ++i) {
+        if(!nearZero(m_real[i] - sign * in_dq.m_real[i]) || !nearZero(m_dual[i] - sign * in_dq.m_dual[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace PyGlMath
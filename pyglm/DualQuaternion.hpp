@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_DUALQUATERNION_H
+#define PYGLM_DUALQUATERNION_H
+
+#include "Vector.hpp"
+#include "Quaternion.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace PyGlMath {
+    class AffineMatrix;
+
+/// A rigid transformation, that is a rotation followed by a translation, held
+/// as a dual quaternion: a real part, which is the rotation, and a dual part,
+/// which is half the translation times the rotation.\n
+/// Unlike matrices, they can be blended (DLB) and interpolated (sclerp)
+/// without shrinking the mesh in between, which is what makes skinning by
+/// dual quaternions volume-preserving. They also only take 8 floats, where an
+/// AffineMatrix with its inverse takes 32.
+/// \note All operations expect unit dual quaternions, which is what the
+///       constructors create. Use normalize after adding some by hand.
+/// \note There's no scaling: converting a matrix with one drops it.
+class DualQuaternion {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates the identity: no rotation and no translation.
+    DualQuaternion();
+    /// Creates a dual quaternion from its two parts.
+    /// \param in_real The real part, which is the rotation.
+    /// \param in_dual The dual part.
+    DualQuaternion(const Quaternion& in_real, const Quaternion& in_dual);
+    /// Creates a dual quaternion which rotates and then translates.
+    /// \param in_trans The translation.
+    /// \param in_rot The rotation, which needs to be a unit quaternion.
+    DualQuaternion(const Vector& in_trans, const Quaternion& in_rot);
+    /// Creates the dual quaternion doing the same as the rotation and the
+    /// translation of a matrix. Any scaling in the matrix is dropped.
+    /// \param in_m The matrix to convert.
+    explicit DualQuaternion(const AffineMatrix& in_m);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The real part, which is the rotation.
+    inline const Quaternion& real() const { return m_real; };
+    /// \return The dual part.
+    inline const Quaternion& dual() const { return m_dual; };
+    /// Sets the real part. \return a reference to *this
+    inline DualQuaternion& real(const Quaternion& in_real) { m_real = in_real; return *this; };
+    /// Sets the dual part. \return a reference to *this
+    inline DualQuaternion& dual(const Quaternion& in_dual) { m_dual = in_dual; return *this; };
+
+    /// \return The rotation, which is the real part.
+    inline const Quaternion& rotation() const { return m_real; };
+    /// \return The translation, applied after the rotation.
+    Vector translation() const;
+
+    /// \param in_iDecimalPlaces The amount of decimal places to use.
+    /// \return A string representing both parts of this dual quaternion.
+    std::string to_s(unsigned int in_iDecimalPlaces = 2) const;
+    /// \return A string representing both parts of this dual quaternion.
+    operator std::string() const;
+
+    /////////////////////////////////
+    // Dual quaternion arithmetic. //
+    /////////////////////////////////
+
+    /// \return Both parts of this negated, which is the same transformation.
+    DualQuaternion operator -() const;
+    /// \return The part-wise sum of this and \a in_dq.
+    DualQuaternion operator +(const DualQuaternion& in_dq) const;
+    /// \return Both parts of this multiplied by \a in_f.
+    DualQuaternion operator *(float in_f) const;
+    /// Concatenates two transformations, like the product of their matrices does.
+    /// \param in_dq The transformation to apply before this one.
+    /// \return The transformation doing \a in_dq first and then this.
+    DualQuaternion operator *(const DualQuaternion& in_dq) const;
+    /// Concatenates \a in_dq to this, in the same order as operator *.
+    void operator *=(const DualQuaternion& in_dq);
+
+    /// \return Both parts conjugated, which for a unit dual quaternion is the
+    ///         transformation undoing this one.
+    DualQuaternion cnj() const;
+    /// \return The transformation undoing this one.
+    inline DualQuaternion inverse() const { return this->cnj(); };
+
+    /// \return The length of the real part.
+    float len() const;
+    /// Scales both parts so that the real part has unit length.
+    /// \return a reference to *this
+    DualQuaternion& normalize();
+    /// \return A normalized copy of this.
+    DualQuaternion normalized() const;
+
+    /////////////////////////////////////
+    // Transforming points and others. //
+    /////////////////////////////////////
+
+    /// Transforms a point: rotates and then translates it.
+    /// \param in_v The point to transform.
+    /// \return The transformed point.
+    Vector operator *(const Vector& in_v) const;
+    /// Transforms a direction: only rotates it.
+    /// \param in_v The direction to transform.
+    /// \return The rotated direction.
+    Vector direction(const Vector& in_v) const;
+
+    /// \return The matrix doing the same as this, along with its inverse.
+    AffineMatrix matrix() const;
+
+    /////////////////////////////////
+    // Interpolation and blending. //
+    /////////////////////////////////
+
+    /// Screw linear interpolation: moves along the screw motion (a rotation
+    /// about an axis and a translation along it) taking this to \a in_dq, at
+    /// constant speed, the same way slerp does for rotations.
+    /// \param in_dq The other transformation with which to interpolate.
+    /// \param between The time of interpolation. 0.0f results in this, 1.0f results in \a in_dq.
+    /// \return The interpolated transformation.
+    /// \note This always takes the shortest way.
+    DualQuaternion sclerp(const DualQuaternion& in_dq, float between) const;
+    /// Dual quaternion linear blending (DLB): the normalized weighted sum of
+    /// many transformations. It's nearly as good as sclerp and much cheaper,
+    /// which is why skinning uses it.
+    /// \param in_dqs The transformations to blend.
+    /// \param in_weights The weight of each of them, which should add up to 1.
+    /// \param in_n The amount of transformations.
+    /// \return The blended transformation.
+    /// \note Like sclerp, this takes the shortest way: every one of them is
+    ///       flipped to the same side as the first one.
+    static DualQuaternion blend(const DualQuaternion *in_dqs, const float *in_weights, std::size_t in_n);
+
+    ////////////////////////////////////////////
+    // Dual quaternion comparison operations. //
+    ////////////////////////////////////////////
+
+    /// \return true if this is \e nearly the same transformation as \a in_dq,
+    ///         that is if all components are nearly those of \a in_dq or -\a in_dq.
+    bool operator ==(const DualQuaternion& in_dq) const;
+    /// \return true if this is \e not \e nearly the same transformation as \a in_dq.
+    inline bool operator !=(const DualQuaternion& in_dq) const {return !this->operator==(in_dq);};
+
+private:
+    /// The real part, the rotation.
+    Quaternion m_real;
+    /// The dual part, half the translation times the rotation.
+    Quaternion m_dual;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_DUALQUATERNION_H
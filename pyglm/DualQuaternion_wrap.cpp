@@ -0,0 +1,324 @@
+#include "DualQuaternion_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Quaternion_wrap.hpp"
+#include "Matrix_wrap.hpp"
+#include "Util_wrap.hpp"
+
+#include <vector>
+
+DualQuaternion::DualQuaternion(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<DualQuaternion>::PythonClass(self, args, kwds)
+    , m_dq()
+{
+    const int narg = args.length();
+    const int nkwd = kwds.length();
+    if(narg == 1 && nkwd == 0 && DualQuaternion::check(args[0])) {
+        m_dq = cxx_object<DualQuaternion>(args[0].ptr())->m_dq;
+        return;
+    } else if(narg == 1 && nkwd == 0 && AffineMatrix::check(args[0])) {
+        m_dq = PyGlMath::DualQuaternion(cxx_object<AffineMatrix>(args[0].ptr())->m_mat);
+        return;
+    } else if(narg + nkwd > 2) {
+        throw Py::TypeError("DualQuaternion takes an AffineMatrix, a translation and a rotation (both optional) or the two Quaternion parts: DualQuaternion(translation, rotation), DualQuaternion(real=..., dual=...).");
+    }
+
+    // Two quaternions are the parts, anything else is a translation.
+    if((narg > 0 && Quaternion::check(args[0])) || kwds.hasKey("real") || kwds.hasKey("dual")) {
+        Py::Object real = argument(args, kwds, 0, "real");
+        Py::Object dual = argument(args, kwds, 1, "dual");
+        if(!real.isNone()) {
+            m_dq.real(quaternion_from(real, "The real part of a DualQuaternion needs to be a Quaternion or an iterable of its four components."));
+        }
+        if(!dual.isNone()) {
+            m_dq.dual(quaternion_from(dual, "The dual part of a DualQuaternion needs to be a Quaternion or an iterable of its four components."));
+        }
+        return;
+    }
+
+    PyGlMath::Vector trans(0.0f, 0.0f, 0.0f);
+    PyGlMath::Quaternion rot;
+    Py::Object trans_arg = argument(args, kwds, 0, "translation");
+    if(!trans_arg.isNone()) {
+        trans = vector_from(trans_arg, "The translation of a DualQuaternion needs to be a Vector or an iterable.");
+    }
+    Py::Object rot_arg = argument(args, kwds, 1, "rotation");
+    if(!rot_arg.isNone()) {
+        rot = quaternion_from(rot_arg, "The rotation of a DualQuaternion needs to be a Quaternion or an iterable of its four components.");
+    }
+    m_dq = PyGlMath::DualQuaternion(trans, rot);
+}
+
+DualQuaternion::DualQuaternion(Py::PythonClassInstance *self, const PyGlMath::DualQuaternion& dq)
+    : Py::PythonClass<DualQuaternion>::PythonClass(self, no_args(), no_kwds())
+    , m_dq(dq)
+{ }
+
+DualQuaternion::DualQuaternionObject DualQuaternion::make_inst(const PyGlMath::DualQuaternion& dq)
+{
+    return make_wrapped_inst<DualQuaternion>(dq);
+}
+
+DualQuaternion::~DualQuaternion()
+{ }
+
+namespace {
+
+// The parts as attributes, handing out copies like those of Transform. The
+// translation and rotation are read-only, as setting one changes the other's
+// share of the dual part.
+
+PyObject* get_real(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Quaternion::make_inst(cxx_object<DualQuaternion>(self)->m_dq.real()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+PyObject* get_dual(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Quaternion::make_inst(cxx_object<DualQuaternion>(self)->m_dq.dual()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+PyObject* get_translation(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Vector::make_inst(cxx_object<DualQuaternion>(self)->m_dq.translation()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+// Shared by the setters, refusing to delete the attribute.
+bool check_set(PyObject* self, PyObject* value)
+{
+    if(value == NULL) {
+        PyErr_Format(PyExc_AttributeError, "The attributes of %s can't be deleted.", Py_TYPE(self)->tp_name);
+        return false;
+    }
+    return true;
+}
+
+int set_real(PyObject* self, PyObject* value, void*)
+{
+    if(!check_set(self, value)) {
+        return -1;
+    }
+
+    try {
+        cxx_object<DualQuaternion>(self)->m_dq.real(quaternion_from(Py::Object(value), "The real part of a DualQuaternion needs to be a Quaternion or an iterable of its four components."));
+        return 0;
+    } catch(const Py::Exception&) {
+        return -1;
+    }
+}
+
+int set_dual(PyObject* self, PyObject* value, void*)
+{
+    if(!check_set(self, value)) {
+        return -1;
+    }
+
+    try {
+        cxx_object<DualQuaternion>(self)->m_dq.dual(quaternion_from(Py::Object(value), "The dual part of a DualQuaternion needs to be a Quaternion or an iterable of its four components."));
+        return 0;
+    } catch(const Py::Exception&) {
+        return -1;
+    }
+}
+
+PyGetSetDef dualquaternion_getset[] = {
+    {"real", &get_real, &set_real, "The real part, which is the rotation, as a Quaternion.", NULL},
+    {"dual", &get_dual, &set_dual, "The dual part, half the translation times the rotation, as a Quaternion.", NULL},
+    {"rotation", &get_real, NULL, "The rotation, which is the real part, as a Quaternion. Read-only.", NULL},
+    {"translation", &get_translation, NULL, "The translation, applied after the rotation, as a Vector. Read-only.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+}
+
+void DualQuaternion::init_type()
+{
+    behaviors().name("DualQuaternion");
+    behaviors().doc("A rigid transformation, a rotation followed by a translation, as a dual quaternion: DualQuaternion(translation, rotation) or DualQuaternion(AffineMatrix), dropping any scale. Unlike matrices, blending them (dlb) and interpolating them (sclerp) preserves volume, which is what skinning wants.");
+    behaviors().supportRichCompare();
+    behaviors().supportRepr();
+    behaviors().supportStr();
+    behaviors().supportNumberType();
+    behaviors().type_object()->tp_as_number->nb_inplace_multiply = &number_inplace_handler<DualQuaternion, &DualQuaternion::number_inplace_multiply>;
+    support_getset(behaviors(), dualquaternion_getset);
+
+    PYCXX_ADD_NOARGS_METHOD(inverse, inverse, "Returns the transformation undoing this one, which is the conjugate.");
+    PYCXX_ADD_NOARGS_METHOD(len, len, "Returns the length of the real part.");
+    PYCXX_ADD_NOARGS_METHOD(normalize, normalize, "Scales both parts so that the real part has unit length, returns nothing. Needed after adding some by hand.");
+    PYCXX_ADD_NOARGS_METHOD(normalized, normalized, "Returns a normalized copy of this dual quaternion. Self remains unchanged.");
+    PYCXX_ADD_NOARGS_METHOD(matrix, matrix, "Returns the AffineMatrix doing the same as this dual quaternion.");
+    PYCXX_ADD_VARARGS_METHOD(direction, direction, "Returns the Vector given as argument rotated, but not translated. Multiplying by a Vector transforms it as a point.");
+    PYCXX_ADD_KEYWORDS_METHOD(sclerp, sclerp, "Returns the screw linear interpolation between self and the first argument 'other' at the second argument 'between'. At constant speed, along the shortest way.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object DualQuaternion::repr()
+{
+    const PyGlMath::Quaternion& r = m_dq.real();
+    const PyGlMath::Quaternion& d = m_dq.dual();
+    std::OSTRSTREAM ss;
+    ss << "DualQuaternion(Quaternion(" << r.x() << "," << r.y() << "," << r.z() << "," << r.w() << "),"
+       << "Quaternion(" << d.x() << "," << d.y() << "," << d.z() << "," << d.w() << "))";
+    return Py::String(ss.str());
+}
+
+Py::Object DualQuaternion::str()
+{
+    return Py::String(m_dq.to_s());
+}
+
+Py::Object DualQuaternion::rich_compare(const Py::Object& other_, int op)
+{
+    if(!DualQuaternion::check(other_)) {
+        throw Py::TypeError("expecting DualQuaternion object for compare");
+    }
+
+    const PyGlMath::DualQuaternion& other = cxx_object<DualQuaternion>(other_.ptr())->m_dq;
+    switch(op) {
+    case Py_EQ: return m_dq == other ? Py::True() : Py::False();
+    case Py_NE: return m_dq != other ? Py::True() : Py::False();
+    }
+    throw Py::TypeError("DualQuaternion objects can only be compared for equality.");
+}
+
+Py::Object DualQuaternion::number_negative()
+{
+    return make_inst(-m_dq);
+}
+
+Py::Object DualQuaternion::number_add(const Py::Object& other_)
+{
+    if(!DualQuaternion::check(other_)) {
+        throw Py::TypeError("expecting DualQuaternion object for addition");
+    }
+
+    return make_inst(m_dq + cxx_object<DualQuaternion>(other_.ptr())->m_dq);
+}
+
+Py::Object DualQuaternion::number_multiply(const Py::Object& other_)
+{
+    if(DualQuaternion::check(other_)) {
+        return make_inst(m_dq * cxx_object<DualQuaternion>(other_.ptr())->m_dq);
+    } else if(Vector::check(other_)) {
+        return Vector::make_inst(m_dq * cxx_object<Vector>(other_.ptr())->m_vec);
+    }
+
+    float f;
+    if(plain_number(other_, f)) {
+        return make_inst(m_dq * f);
+    }
+
+    throw Py::TypeError("A DualQuaternion may only be multiplied by another DualQuaternion, by a Vector or by a number.");
+}
+
+bool DualQuaternion::number_inplace_multiply(const Py::Object& other_)
+{
+    // The product with a Vector is of another type.
+    if(!DualQuaternion::check(other_)) {
+        return false;
+    }
+
+    m_dq *= cxx_object<DualQuaternion>(other_.ptr())->m_dq;
+    return true;
+}
+
+Py::Object DualQuaternion::inverse()
+{
+    return make_inst(m_dq.inverse());
+}
+
+Py::Object DualQuaternion::len()
+{
+    return Py::Float(m_dq.len());
+}
+
+Py::Object DualQuaternion::normalize()
+{
+    m_dq.normalize();
+    return Py::None();
+}
+
+Py::Object DualQuaternion::normalized()
+{
+    return make_inst(m_dq.normalized());
+}
+
+Py::Object DualQuaternion::matrix()
+{
+    return AffineMatrix::make_inst(m_dq.matrix());
+}
+
+Py::Object DualQuaternion::direction(const Py::Tuple& args)
+{
+    if(args.length() != 1 || !Vector::check(args[0])) {
+        throw Py::TypeError("DualQuaternion.direction takes a Vector.");
+    }
+
+    return Vector::make_inst(m_dq.direction(cxx_object<Vector>(args[0].ptr())->m_vec));
+}
+
+Py::Object DualQuaternion::sclerp(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() != 2) {
+        throw Py::ValueError("DualQuaternion.sclerp takes two arguments: first ('other') another dual quaternion and second ('between') a number.");
+    }
+
+    Py::Object other = argument(args, kwargs, 0, "other");
+    if(!DualQuaternion::check(other)) {
+        throw Py::TypeError("DualQuaternion.sclerp takes a DualQuaternion as first argument ('other').");
+    }
+
+    float between;
+    try {
+        between = Py::Float(argument(args, kwargs, 1, "between"));
+    } catch(const Py::Exception& ) {
+        throw Py::TypeError("The second argument to DualQuaternion.sclerp ('between') needs to be a numeric value.");
+    }
+
+    return make_inst(m_dq.sclerp(cxx_object<DualQuaternion>(other.ptr())->m_dq, between));
+}
+
+Py::Object DualQuaternion::blend(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() != 2) {
+        throw Py::TypeError("dlb takes a sequence of DualQuaternion objects and a sequence of as many weights.");
+    }
+
+    Py::Object dqs_arg = argument(args, kwargs, 0, "dualQuaternions");
+    Py::Object weights_arg = argument(args, kwargs, 1, "weights");
+    if(!dqs_arg.isSequence() || !weights_arg.isSequence()) {
+        throw Py::TypeError("dlb takes a sequence of DualQuaternion objects and a sequence of as many weights.");
+    }
+
+    Py::Sequence dqs_seq(dqs_arg);
+    Py::Sequence weights_seq(weights_arg);
+    if(dqs_seq.length() != weights_seq.length()) {
+        throw Py::ValueError("dlb needs as many weights as dual quaternions.");
+    }
+
+    std::vector<PyGlMath::DualQuaternion> dqs;
+    std::vector<float> weights;
+    for(Py::Sequence::size_type i = 0 ; i < dqs_seq.length() ; ++i) {
+        Py::Object dq = dqs_seq[i];
+        if(!DualQuaternion::check(dq)) {
+            throw Py::TypeError("dlb takes a sequence of DualQuaternion objects.");
+        }
+        dqs.push_back(cxx_object<DualQuaternion>(dq.ptr())->m_dq);
+        weights.push_back(Py::Float(weights_seq[i]));
+    }
+
+    return make_inst(PyGlMath::DualQuaternion::blend(dqs.empty() ? 0 : &dqs[0], weights.empty() ? 0 : &weights[0], dqs.size()));
+}
@@ -0,0 +1,50 @@
+#include "DualQuaternion.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+class DualQuaternion : public Py::PythonClass<DualQuaternion>
+{
+public:
+    DualQuaternion(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing dual quaternion without parsing arguments.
+    DualQuaternion(Py::PythonClassInstance *self, const PyGlMath::DualQuaternion& dq);
+    virtual ~DualQuaternion();
+
+    static void init_type();
+
+    typedef Py::PythonClassObject<DualQuaternion> DualQuaternionObject;
+    static DualQuaternionObject make_inst(const PyGlMath::DualQuaternion& dq);
+
+    static Py::Object blend(const Py::Tuple& args, const Py::Dict& kwargs);
+
+    PyGlMath::DualQuaternion m_dq;
+
+private:
+    Py::Object repr();
+    Py::Object str();
+
+    Py::Object rich_compare(const Py::Object& other_, int op);
+
+    Py::Object number_negative();
+    Py::Object number_add(const Py::Object& other_);
+    Py::Object number_multiply(const Py::Object& other_);
+    bool number_inplace_multiply(const Py::Object& other_);
+
+    Py::Object inverse();
+    PYCXX_NOARGS_METHOD_DECL(DualQuaternion, inverse);
+    Py::Object len();
+    PYCXX_NOARGS_METHOD_DECL(DualQuaternion, len);
+    Py::Object normalize();
+    PYCXX_NOARGS_METHOD_DECL(DualQuaternion, normalize);
+    Py::Object normalized();
+    PYCXX_NOARGS_METHOD_DECL(DualQuaternion, normalized);
+    Py::Object matrix();
+    PYCXX_NOARGS_METHOD_DECL(DualQuaternion, matrix);
+    Py::Object direction(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(DualQuaternion, direction);
+    Py::Object sclerp(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(DualQuaternion, sclerp);
+};
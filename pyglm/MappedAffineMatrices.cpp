@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "MappedAffineMatrices.hpp"
+#include "BinaryFormat.hpp"
+#include "Matrix.hpp"
+
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+// Maps the whole file read-only, results in NULL if that's not possible.
+void *map_file(const std::string& name, std::size_t& out_size)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+
+    LARGE_INTEGER size;
+    void *mapping = 0;
+    if(GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<unsigned long long>(size.QuadPart) <= static_cast<std::size_t>(-1)) {
+        // The view keeps the mapping alive, the handles aren't needed anymore.
+        HANDLE map = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(map != NULL) {
+            mapping = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+            out_size = static_cast<std::size_t>(size.QuadPart);
+            CloseHandle(map);
+        }
+    }
+
+    CloseHandle(file);
+    return mapping;
+#else
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return 0;
+    }
+
+    struct stat st;
+    void *mapping = 0;
+    if(::fstat(fd, &st) == 0 && st.st_size > 0 && static_cast<unsigned long long>(st.st_size) <= static_cast<std::size_t>(-1)) {
+        // The mapping stays valid after closing the file.
+        mapping = ::mmap(0, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if(mapping == MAP_FAILED) {
+            mapping = 0;
+        }
+        out_size = static_cast<std::size_t>(st.st_size);
+    }
+
+    ::close(fd);
+    return mapping;
+#endif
+}
+
+void unmap_file(void *mapping, std::size_t size)
+{
+#if defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(mapping);
+#else
+    ::munmap(mapping, size);
+#endif
+}
+
+}
+
+namespace PyGlMath {
+
+MappedAffineMatrices::MappedAffineMatrices()
+    : m_pMapping(0)
+    , m_mappingSize(0)
+    , m_pFloats(0)
+    , m_n(0)
+    , m_bInverses(false)
+{
+}
+
+MappedAffineMatrices::~MappedAffineMatrices()
+{
+    this->close();
+}
+
+bool MappedAffineMatrices::open(const std::string& in_sFileName)
+{
+    this->close();
+
+    std::size_t size = 0;
+    void *mapping = map_file(in_sFileName, size);
+    if(mapping == 0) {
+        return false;
+    }
+
+    // Only the header is looked at, the matrices are left alone until used.
+    std::size_t n = 0;
+    bool inverses = true;
+    const float *floats = BinaryFormat::floats(mapping, size, BinaryFormat::AffineMatrixType, n);
+    if(floats == 0) {
+        inverses = false;
+        floats = BinaryFormat::floats(mapping, size, BinaryFormat::AffineMatrixWithoutInverseType, n);
+    }
+
+    if(floats == 0) {
+        unmap_file(mapping, size);
+        return false;
+    }
+
+    m_pMapping = mapping;
+    m_mappingSize = size;
+    m_pFloats = n ? floats : 0;
+    m_n = n;
+    m_bInverses = inverses;
+    return true;
+}
+
+void MappedAffineMatrices::close()
+{
+    if(m_pMapping) {
+        unmap_file(m_pMapping, m_mappingSize);
+    }
+
+    m_pMapping = 0;
+    m_mappingSize = 0;
+    m_pFloats = 0;
+    m_n = 0;
+    m_bInverses = false;
+}
+
+bool MappedAffineMatrices::write(const std::string& in_sFileName, const AffineMatrix *in_m, std::size_t in_n, bool in_bInverses)
+{
+    std::ofstream f(in_sFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!f) {
+        return false;
+    }
+
+    BinaryFormat::Type type = in_bInverses ? BinaryFormat::AffineMatrixType : BinaryFormat::AffineMatrixWithoutInverseType;
+    char header[BinaryFormat::HeaderSize];
+    BinaryFormat::writeHeader(type, in_n, header);
+    f.write(header, sizeof(header));
+
+    // The matrices go through a buffer a chunk at a time, each chunk being
+    // written as a block of its own whose header is dropped.
+    static const std::size_t chunk = 4096;
+    std::vector<char> buf(BinaryFormat::size(type, std::min(chunk, in_n)));
+    for(std::size_t i = 0 ; i < in_n && f ; i += chunk) {
+        std::size_t n = std::min(chunk, in_n - i);
+        std::size_t written = BinaryFormat::write(in_m + i, n, &buf[0], in_bInverses);
+        f.write(&buf[BinaryFormat::HeaderSize], written - BinaryFormat::HeaderSize);
+    }
+
+    f.close();
+    return !f.fail();
+}
+
+AffineMatrix MappedAffineMatrices::operator[](std::size_t idx) const
+{
+    AffineMatrix ret;
+    const float *in = this->array16f(idx);
+    std::copy(in, in + 16, ret.m);
+    ret.m3[0] = ret.m[0]; ret.m3[3] = ret.m[4]; ret.m3[6] = ret.m[8];
+    ret.m3[1] = ret.m[1]; ret.m3[4] = ret.m[5]; ret.m3[7] = ret.m[9];
+    ret.m3[2] = ret.m[2]; ret.m3[5] = ret.m[6]; ret.m3[8] = ret.m[10];
+
+    if(!m_bInverses) {
+        ret.m_bInverseDirty = true;
+        return ret;
+    }
+
+    const float *in_inv = this->array16fInverse(idx);
+    std::copy(in_inv, in_inv + 16, ret.im);
+    ret.im3[0] = ret.im[0]; ret.im3[3] = ret.im[4]; ret.im3[6] = ret.im[8];
+    ret.im3[1] = ret.im[1]; ret.im3[4] = ret.im[5]; ret.im3[7] = ret.im[9];
+    ret.im3[2] = ret.im[2]; ret.im3[5] = ret.im[6]; ret.im3[8] = ret.im[10];
+    ret.m_bInverseDirty = false;
+    return ret;
+}
+
+} // namespace PyGlMath
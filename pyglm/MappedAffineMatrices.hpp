@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_MAPPEDAFFINEMATRICES_H
+#define PYGLM_MAPPEDAFFINEMATRICES_H
+
+#include "Util.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace PyGlMath {
+    class AffineMatrix;
+
+/// A read-only view on a file holding a BinaryFormat block of affine matrices,
+/// with or without their inverses, such as the ones written by write.\n
+/// The file is mapped into memory instead of being read: opening it only
+/// checks its header, which takes the same time whatever its size, and the
+/// matrices are used right where they are in the mapping. The system only
+/// loads the pages actually accessed, and shares them between processes.
+/// \note Only works on little-endian machines, where the floats of a block can
+///       be used as they are. Elsewhere, use BinaryFormat::read instead.
+class MappedAffineMatrices {
+public:
+    /// Creates a view which isn't opened yet, holding no matrices.
+    MappedAffineMatrices();
+    /// Unmaps the file, if any.
+    ~MappedAffineMatrices();
+
+    /// Maps a file. Any previously mapped file is unmapped first.
+    /// \param in_sFileName The name of the file to map.
+    /// \return false if the file can't be mapped or doesn't start with a
+    ///         complete block of AffineMatrixType or AffineMatrixWithoutInverseType
+    ///         elements, in which case this view doesn't hold any matrix.
+    bool open(const std::string& in_sFileName);
+    /// Unmaps the file, invalidating all pointers this view gave out.
+    void close();
+
+    /// Writes a file which can be mapped by open, without needing all of it in memory at once.
+    /// \param in_sFileName The name of the file to create or overwrite.
+    /// \param in_m The matrices to write.
+    /// \param in_n The amount of matrices in \a in_m.
+    /// \param in_bInverses Whether to write the inverses too. Files without
+    ///                     them are half the size, but need to compute them
+    ///                     when operator[] is used.
+    /// \return false if the file couldn't be written entirely.
+    static bool write(const std::string& in_sFileName, const AffineMatrix *in_m, std::size_t in_n, bool in_bInverses = true);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return Whether a file is currently mapped.
+    inline bool isOpen() const {return m_pMapping != 0;};
+    /// \return The amount of matrices in the mapped file.
+    inline std::size_t size() const {return m_n;};
+    /// \return Whether the mapped file holds the inverses of the matrices.
+    inline bool hasInverses() const {return m_bInverses;};
+    /// \return The amount of floats between the start of two consecutive
+    ///         matrices: 32 with inverses, 16 without.
+    inline std::size_t stride() const {return m_bInverses ? 32 : 16;};
+    /// \return The floats of all size() matrices, each one starting stride()
+    ///         floats after the previous one, or NULL if there is none.
+    inline const float *data() const {return m_pFloats;};
+
+    /// \param idx The index of the matrix, it must be less than size().
+    /// \return The 16 floats of the matrix, in column-wise representation,
+    ///         right from the mapping: nothing is copied.
+    inline const float *array16f(std::size_t idx) const {return m_pFloats + idx*this->stride();};
+    /// \param idx The index of the matrix, it must be less than size().
+    /// \return The 16 floats of the inverse of the matrix, right from the
+    ///         mapping, or NULL if the file doesn't hold the inverses.
+    inline const float *array16fInverse(std::size_t idx) const {return m_bInverses ? m_pFloats + idx*32 + 16 : 0;};
+    /// \param idx The index of the matrix, it must be less than size().
+    /// \return A copy of the matrix. If the file doesn't hold its inverse,
+    ///         the copy computes it the first time it is needed.
+    AffineMatrix operator[](std::size_t idx) const;
+
+private:
+    MappedAffineMatrices(const MappedAffineMatrices&);
+    MappedAffineMatrices& operator=(const MappedAffineMatrices&);
+
+    /// The start of the mapping, NULL if nothing is mapped.
+    void *m_pMapping;
+    /// The size in bytes of the mapping.
+    std::size_t m_mappingSize;
+    /// The floats of the first matrix, within the mapping.
+    const float *m_pFloats;
+    /// The amount of matrices.
+    std::size_t m_n;
+    /// Whether each matrix is followed by its inverse.
+    bool m_bInverses;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_MAPPEDAFFINEMATRICES_H
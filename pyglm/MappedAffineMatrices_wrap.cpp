@@ -0,0 +1,73 @@
+#include "MappedAffineMatrices_wrap.hpp"
+#include "Matrix_wrap.hpp"
+
+#include "Matrix.hpp"
+
+MappedAffineMatrices::MappedAffineMatrices(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<MappedAffineMatrices>::PythonClass(self, args, kwds)
+    , m_file()
+{
+    if(args.length() != 1 || kwds.length() != 0 || !args[0].isString()) {
+        throw Py::TypeError("MappedAffineMatrices takes the name of the file to map.");
+    }
+
+    std::string name = Py::String(args[0]).as_std_string("utf-8");
+    if(!m_file.open(name)) {
+        throw Py::ValueError("Can't map '" + name + "': it needs to exist and to hold affine matrices written by toBinary, on a little-endian machine.");
+    }
+}
+
+MappedAffineMatrices::~MappedAffineMatrices()
+{ }
+
+void MappedAffineMatrices::init_type()
+{
+    behaviors().name("MappedAffineMatrices");
+    behaviors().doc("A read-only sequence of the AffineMatrix objects of a file written by toBinary, which is mapped into memory instead of being read. Its buffer holds one row of 16 floats per matrix, or 32 with the inverses.");
+    behaviors().supportRepr();
+    behaviors().supportSequenceType();
+    support_float_buffer<MappedAffineMatrices>(behaviors());
+
+    PYCXX_ADD_NOARGS_METHOD(hasInverses, hasInverses, "Whether the file holds the inverses of the matrices. If not, they are computed when needed.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+FloatBuffer MappedAffineMatrices::float_buffer()
+{
+    // Indexed as [matrix, float], the inverse following the matrix.
+    m_shape[0] = m_file.size();
+    m_shape[1] = m_file.stride();
+    m_strides[0] = m_file.stride()*sizeof(float);
+    m_strides[1] = sizeof(float);
+    m_size = m_file.size()*m_file.stride();
+    FloatBuffer b = {const_cast<float*>(m_file.data()), 2, m_shape, m_strides, &m_size, true};
+    return b;
+}
+
+Py::Object MappedAffineMatrices::repr()
+{
+    std::OSTRSTREAM ss;
+    ss << "MappedAffineMatrices(" << m_file.size() << " matrices" << (m_file.hasInverses() ? " with" : " without") << " inverses)";
+    return Py::String(ss.str());
+}
+
+int MappedAffineMatrices::sequence_length()
+{
+    return static_cast<int>(m_file.size());
+}
+
+Py::Object MappedAffineMatrices::sequence_item(Py_ssize_t i)
+{
+    if(i < 0 || static_cast<std::size_t>(i) >= m_file.size()) {
+        throw Py::IndexError("MappedAffineMatrices index out of range.");
+    }
+
+    return AffineMatrix::make_inst(m_file[i]);
+}
+
+Py::Object MappedAffineMatrices::hasInverses()
+{
+    return Py::Boolean(m_file.hasInverses());
+}
@@ -0,0 +1,36 @@
+#include "MappedAffineMatrices.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+class MappedAffineMatrices : public Py::PythonClass<MappedAffineMatrices>
+{
+public:
+    MappedAffineMatrices(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    virtual ~MappedAffineMatrices();
+
+    static void init_type();
+
+    PyGlMath::MappedAffineMatrices m_file;
+
+    /// Used by the buffer protocol, \see get_float_buffer.
+    /// \note The file stays mapped for as long as the instance lives, which
+    ///       any exported buffer makes sure of by holding a reference to it.
+    FloatBuffer float_buffer();
+
+private:
+    Py::Object repr();
+
+    int sequence_length();
+    Py::Object sequence_item(Py_ssize_t i);
+
+    Py::Object hasInverses();
+    PYCXX_NOARGS_METHOD_DECL(MappedAffineMatrices, hasInverses);
+
+    /// The layout exported through the buffer protocol, \see float_buffer.
+    Py_ssize_t m_shape[2];
+    Py_ssize_t m_strides[2];
+    Py_ssize_t m_size;
+};
@@ -25,10 +25,187 @@
 #include "Matrix.hpp"
 #include "Quaternion.hpp"
 #include "Vector.hpp"
+#include "ThreadPool.hpp"
 #include "Util.hpp"
 
 #include <sstream>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(D_PYGLM_SSE)
+#  include <xmmintrin.h>
+#elif defined(D_PYGLM_NEON)
+#  include <arm_neon.h>
+#endif
+
+namespace {
+
+// r = a * b, all of them being column-major 4x4 matrices. They may be
+// unaligned, as new and std::vector only align on 8 bytes on 32-bit x86,
+// whatever D_PYGLM_ALIGN asks for. r may be neither a nor b. Each column of r is a linear combination of the
+// columns of a, which is four multiply-adds of whole columns.
+void mul4x4(const float *a, const float *b, float *r)
+{
+#if defined(D_PYGLM_SSE)
+    const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a+4), a2 = _mm_loadu_ps(a+8), a3 = _mm_loadu_ps(a+12);
+    for(int j = 0 ; j < 16 ; j += 4) {
+        __m128 c = _mm_mul_ps(a0, _mm_set1_ps(b[j]));
+        c = _mm_add_ps(c, _mm_mul_ps(a1, _mm_set1_ps(b[j+1])));
+        c = _mm_add_ps(c, _mm_mul_ps(a2, _mm_set1_ps(b[j+2])));
+        c = _mm_add_ps(c, _mm_mul_ps(a3, _mm_set1_ps(b[j+3])));
+        _mm_storeu_ps(r+j, c);
+    }
+#elif defined(D_PYGLM_NEON)
+    const float32x4_t a0 = vld1q_f32(a), a1 = vld1q_f32(a+4), a2 = vld1q_f32(a+8), a3 = vld1q_f32(a+12);
+    for(int j = 0 ; j < 16 ; j += 4) {
+        float32x4_t c = vmulq_n_f32(a0, b[j]);
+        c = vmlaq_n_f32(c, a1, b[j+1]);
+        c = vmlaq_n_f32(c, a2, b[j+2]);
+        c = vmlaq_n_f32(c, a3, b[j+3]);
+        vst1q_f32(r+j, c);
+    }
+#else
+    for(int j = 0 ; j < 16 ; j += 4) {
+        for(int i = 0 ; i < 4 ; ++i) {
+            r[j+i] = a[i]*b[j] + a[4+i]*b[j+1] + a[8+i]*b[j+2] + a[12+i]*b[j+3];
+        }
+    }
+#endif
+}
+
+// The same for affine matrices: the lower rows being 0 0 0 1, the first three
+// columns of r only depend on the first three columns of a.
+void mul4x4affine(const float *a, const float *b, float *r)
+{
+#if defined(D_PYGLM_SSE)
+    const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a+4), a2 = _mm_loadu_ps(a+8), a3 = _mm_loadu_ps(a+12);
+    for(int j = 0 ; j < 12 ; j += 4) {
+        __m128 c = _mm_mul_ps(a0, _mm_set1_ps(b[j]));
+        c = _mm_add_ps(c, _mm_mul_ps(a1, _mm_set1_ps(b[j+1])));
+        c = _mm_add_ps(c, _mm_mul_ps(a2, _mm_set1_ps(b[j+2])));
+        _mm_storeu_ps(r+j, c);
+    }
+    __m128 c = _mm_mul_ps(a0, _mm_set1_ps(b[12]));
+    c = _mm_add_ps(c, _mm_mul_ps(a1, _mm_set1_ps(b[13])));
+    c = _mm_add_ps(c, _mm_mul_ps(a2, _mm_set1_ps(b[14])));
+    c = _mm_add_ps(c, _mm_mul_ps(a3, _mm_set1_ps(b[15])));
+    _mm_storeu_ps(r+12, c);
+#elif defined(D_PYGLM_NEON)
+    const float32x4_t a0 = vld1q_f32(a), a1 = vld1q_f32(a+4), a2 = vld1q_f32(a+8), a3 = vld1q_f32(a+12);
+    for(int j = 0 ; j < 12 ; j += 4) {
+        float32x4_t c = vmulq_n_f32(a0, b[j]);
+        c = vmlaq_n_f32(c, a1, b[j+1]);
+        c = vmlaq_n_f32(c, a2, b[j+2]);
+        vst1q_f32(r+j, c);
+    }
+    float32x4_t c = vmulq_n_f32(a0, b[12]);
+    c = vmlaq_n_f32(c, a1, b[13]);
+    c = vmlaq_n_f32(c, a2, b[14]);
+    c = vmlaq_n_f32(c, a3, b[15]);
+    vst1q_f32(r+12, c);
+#else
+    for(int j = 0 ; j < 12 ; j += 4) {
+        for(int i = 0 ; i < 3 ; ++i) {
+            r[j+i] = a[i]*b[j] + a[4+i]*b[j+1] + a[8+i]*b[j+2];
+        }
+        r[j+3] = 0.0f;
+    }
+    for(int i = 0 ; i < 3 ; ++i) {
+        r[12+i] = a[i]*b[12] + a[4+i]*b[13] + a[8+i]*b[14] + a[12+i]*b[15];
+    }
+    r[15] = 1.0f;
+#endif
+}
+
+// Transforms n elements of S floats each, x y z being the first three of them
+// (and w the fourth one if S is 4, otherwise it's implicitly 1 for points and
+// 0 for directions). This exploits the lower row of affine matrices being
+// 0 0 0 1: w is left as is. The input and output may not alias, so that the
+// loops get vectorized.
+template<std::size_t S, bool Translate>
+void transform(const float *m, const float * D_PYGLM_RESTRICT in, float * D_PYGLM_RESTRICT out, std::size_t n)
+{
+    const float m0 = m[0], m4 = m[4], m8  = m[8],  m12 = Translate ? m[12] : 0.0f;
+    const float m1 = m[1], m5 = m[5], m9  = m[9],  m13 = Translate ? m[13] : 0.0f;
+    const float m2 = m[2], m6 = m[6], m10 = m[10], m14 = Translate ? m[14] : 0.0f;
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        const float x = in[S*i], y = in[S*i+1], z = in[S*i+2];
+        const float w = S == 4 ? in[S*i+3] : 1.0f;
+        out[S*i]   = m0*x + m4*y + m8*z  + m12*w;
+        out[S*i+1] = m1*x + m5*y + m9*z  + m13*w;
+        out[S*i+2] = m2*x + m6*y + m10*z + m14*w;
+        if(S == 4) {
+            out[S*i+3] = w;
+        }
+    }
+}
+
+// The same for any stride, only ever touching x y z. No vectorization to hope
+// for here, which is why it also works in-place as is.
+template<bool Translate>
+void transform(const float *m, const float *in, float *out, std::size_t n, std::size_t stride)
+{
+    for(std::size_t i = 0 ; i < n*stride ; i += stride) {
+        const float x = in[i], y = in[i+1], z = in[i+2];
+        out[i]   = m[0]*x + m[4]*y + m[8]*z  + (Translate ? m[12] : 0.0f);
+        out[i+1] = m[1]*x + m[5]*y + m[9]*z  + (Translate ? m[13] : 0.0f);
+        out[i+2] = m[2]*x + m[6]*y + m[10]*z + (Translate ? m[14] : 0.0f);
+    }
+}
+
+// Dispatches to the kernel fitting the stride. When working in-place, the
+// fast kernels get the input through a small buffer, one block at a time.
+template<bool Translate>
+void transform_any(const float *m, const float *in, float *out, std::size_t n, std::size_t stride)
+{
+    if(stride != 3 && stride != 4) {
+        if(stride > 4) {
+            transform<Translate>(m, in, out, n, stride);
+        }
+        return;
+    }
+
+    const std::size_t block = 256;
+    D_PYGLM_ALIGN(16) float tmp[4*block];
+
+    for(std::size_t first = 0 ; first < n ; first += block) {
+        const std::size_t count = std::min(block, n - first);
+        const float *src = in + first*stride;
+        if(in == out) {
+            std::memcpy(tmp, src, count*stride*sizeof(float));
+            src = tmp;
+        }
+
+        if(stride == 3) {
+            transform<3, Translate>(m, src, out + first*stride, count);
+        } else {
+            transform<4, Translate>(m, src, out + first*stride, count);
+        }
+    }
+}
+
+// Transforming a point takes about a nanosecond, a chunk of work for another
+// thread needs many of them to be worth waking it up.
+const std::size_t transform_grain = 16384;
+
+struct TransformTask {
+    const float *m;
+    const float *in;
+    float *out;
+    std::size_t stride;
+};
+
+// Transforms the points from begin up to end, for the thread pool.
+template<bool Translate>
+void transform_range(void *data, std::size_t begin, std::size_t end)
+{
+    const TransformTask& t = *static_cast<const TransformTask*>(data);
+    transform_any<Translate>(t.m, t.in + begin*t.stride, t.out + begin*t.stride, end - begin, t.stride);
+}
+
+}
 
 namespace PyGlMath {
 
@@ -47,8 +224,8 @@ Base4x4Matrix::~Base4x4Matrix()
 ////////////////////////////////////////////
 
 Base4x4Matrix::Base4x4Matrix()
-    : m(16)
-    , im(16)
+    : m_bInverseDirty(false)
+    , m_bLazyInverse(D_PYGLM_LAZY_INVERSE != 0)
 {
     m[0] = 1.0f; m[4] = 0.0f; m[8]  = 0.0f; m[12] = 0.0f;
     m[1] = 0.0f; m[5] = 1.0f; m[9]  = 0.0f; m[13] = 0.0f;
@@ -66,6 +243,9 @@ Base4x4Matrix::Base4x4Matrix()
 
 std::string Base4x4Matrix::to_s(unsigned int in_iDecimalPlaces, bool in_bOneLiner) const
 {
+    // Makes sure a lazy inverse is up to date.
+    const float *im = this->array16fInverse();
+
     std::ostringstream ss;
     ss.precision(in_iDecimalPlaces);
     ss.fill(' ');
@@ -123,8 +303,6 @@ AffineMatrix::~AffineMatrix()
 
 AffineMatrix::AffineMatrix()
     : Base4x4Matrix()
-    , m3(9)
-    , im3(9)
 {
     m3[0] = m[0]; m3[3] = m[4]; m3[6] = m[8];
     m3[1] = m[1]; m3[4] = m[5]; m3[7] = m[9];
@@ -136,8 +314,6 @@ AffineMatrix::AffineMatrix()
 
 AffineMatrix::AffineMatrix(const AffineMatrix& in_m)
     : Base4x4Matrix()
-    , m3(9)
-    , im3(9)
 {
     m[0] = in_m.m[0]; m[4] = in_m.m[4]; m[8]  = in_m.m[8];  m[12] = in_m.m[12];
     m[1] = in_m.m[1]; m[5] = in_m.m[5]; m[9]  = in_m.m[9];  m[13] = in_m.m[13];
@@ -153,10 +329,16 @@ AffineMatrix::AffineMatrix(const AffineMatrix& in_m)
     im3[0] = in_m.im3[0]; im3[3] = in_m.im3[3]; im3[6] = in_m.im3[6];
     im3[1] = in_m.im3[1]; im3[4] = in_m.im3[4]; im3[7] = in_m.im3[7];
     im3[2] = in_m.im3[2]; im3[5] = in_m.im3[5]; im3[8] = in_m.im3[8];
+    m_bInverseDirty = in_m.m_bInverseDirty;
+    m_bLazyInverse = in_m.m_bLazyInverse;
 }
 
 const AffineMatrix& AffineMatrix::operator=(const AffineMatrix& in_m)
 {
+    // We keep our own way of handling the inverse, which may need it now.
+    if(!m_bLazyInverse)
+        in_m.array16fInverse();
+
     m[0] = in_m.m[0]; m[4] = in_m.m[4]; m[8]  = in_m.m[8];  m[12] = in_m.m[12];
     m[1] = in_m.m[1]; m[5] = in_m.m[5]; m[9]  = in_m.m[9];  m[13] = in_m.m[13];
     m[2] = in_m.m[2]; m[6] = in_m.m[6]; m[10] = in_m.m[10]; m[14] = in_m.m[14];
@@ -171,31 +353,11 @@ const AffineMatrix& AffineMatrix::operator=(const AffineMatrix& in_m)
     im3[0] = in_m.im3[0]; im3[3] = in_m.im3[3]; im3[6] = in_m.im3[6];
     im3[1] = in_m.im3[1]; im3[4] = in_m.im3[4]; im3[7] = in_m.im3[7];
     im3[2] = in_m.im3[2]; im3[5] = in_m.im3[5]; im3[8] = in_m.im3[8];
+    m_bInverseDirty = in_m.m_bInverseDirty;
 
     return *this;
 }
 
-#ifdef BOUGE_COMPILE_CPP0X
-AffineMatrix::AffineMatrix(AffineMatrix&& in_m)
-    : m(std::move(in_m.m))
-    , im(std::move(in_m.im))
-    , m3(std::move(in_m.m3))
-    , im3(std::move(in_m.im3))
-{
-    this->operator=(std::move(in_m));
-}
-
-const AffineMatrix& AffineMatrix::operator=(AffineMatrix&& in_m)
-{
-    this->m = std::move(in_m.m);
-    this->im = std::move(in_m.im);
-    this->m3 = std::move(in_m.m3);
-    this->im3 = std::move(in_m.im3);
-
-    return *this;
-}
-#endif // BOUGE_COMPILE_CPP0X
-
 //////////////////////////////////
 // Special matrix constructors. //
 //////////////////////////////////
@@ -458,6 +620,7 @@ AffineMatrix& AffineMatrix::setTransformation(const Vector& in_trans, const Quat
     im[12] = -in_trans.x()*im[0] - in_trans.y()*im[4] - in_trans.z()*im[8];
     im[13] = -in_trans.x()*im[1] - in_trans.y()*im[5] - in_trans.z()*im[9];
     im[14] = -in_trans.x()*im[2] - in_trans.y()*im[6] - in_trans.z()*im[10];
+    m_bInverseDirty = false;
 
     return *this;
 }
@@ -485,51 +648,23 @@ AffineMatrix& AffineMatrix::setTransformation(const Vector& in_trans, const Quat
     im3[0] = im[0]; im3[3] = im[4]; im3[6] = im[8];
     im3[1] = im[1]; im3[4] = im[5]; im3[7] = im[9];
     im3[2] = im[2]; im3[5] = im[6]; im3[8] = im[10];
+    m_bInverseDirty = false;
 
     return *this;
 }
 
 void AffineMatrix::operator *=(const AffineMatrix& o)
 {
-    // Operation optimized for affine matrices: the lower row is 0 0 0 1.
-
-    float oldm[] = {m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10], m[11], m[12], m[13], m[14], m[15]};
-
-    m[0]  = oldm[0] * o.m[0]  + oldm[4] * o.m[1]  + oldm[8]  * o.m[2];
-    m[1]  = oldm[1] * o.m[0]  + oldm[5] * o.m[1]  + oldm[9]  * o.m[2];
-    m[2]  = oldm[2] * o.m[0]  + oldm[6] * o.m[1]  + oldm[10] * o.m[2];
-
-    m[4]  = oldm[0] * o.m[4]  + oldm[4] * o.m[5]  + oldm[8]  * o.m[6];
-    m[5]  = oldm[1] * o.m[4]  + oldm[5] * o.m[5]  + oldm[9]  * o.m[6];
-    m[6]  = oldm[2] * o.m[4]  + oldm[6] * o.m[5]  + oldm[10] * o.m[6];
+    D_PYGLM_ALIGN(16) float tmp[16];
 
-    m[8]  = oldm[0] * o.m[8]  + oldm[4] * o.m[9]  + oldm[8]  * o.m[10];
-    m[9]  = oldm[1] * o.m[8]  + oldm[5] * o.m[9]  + oldm[9]  * o.m[10];
-    m[10] = oldm[2] * o.m[8]  + oldm[6] * o.m[9]  + oldm[10] * o.m[10];
-
-    m[12] = oldm[0] * o.m[12] + oldm[4] * o.m[13] + oldm[8]  * o.m[14] + oldm[12] * o.m[15];
-    m[13] = oldm[1] * o.m[12] + oldm[5] * o.m[13] + oldm[9]  * o.m[14] + oldm[13] * o.m[15];
-    m[14] = oldm[2] * o.m[12] + oldm[6] * o.m[13] + oldm[10] * o.m[14] + oldm[14] * o.m[15];
-
-    // Inverses are multiplied from the left.
-
-    float oldim[] = {im[0], im[1], im[2], im[3], im[4], im[5], im[6], im[7], im[8], im[9], im[10], im[11], im[12], im[13], im[14], im[15]};
-
-    im[0]  = o.im[0] * oldim[0]  + o.im[4] * oldim[1]  + o.im[8]  * oldim[2];
-    im[1]  = o.im[1] * oldim[0]  + o.im[5] * oldim[1]  + o.im[9]  * oldim[2];
-    im[2]  = o.im[2] * oldim[0]  + o.im[6] * oldim[1]  + o.im[10] * oldim[2];
-
-    im[4]  = o.im[0] * oldim[4]  + o.im[4] * oldim[5]  + o.im[8]  * oldim[6];
-    im[5]  = o.im[1] * oldim[4]  + o.im[5] * oldim[5]  + o.im[9]  * oldim[6];
-    im[6]  = o.im[2] * oldim[4]  + o.im[6] * oldim[5]  + o.im[10] * oldim[6];
-
-    im[8]  = o.im[0] * oldim[8]  + o.im[4] * oldim[9]  + o.im[8]  * oldim[10];
-    im[9]  = o.im[1] * oldim[8]  + o.im[5] * oldim[9]  + o.im[9]  * oldim[10];
-    im[10] = o.im[2] * oldim[8]  + o.im[6] * oldim[9]  + o.im[10] * oldim[10];
+    // Both inverses need to be up to date before we touch anything.
+    if(!m_bLazyInverse) {
+        o.array16fInverse();
+        this->array16fInverse();
+    }
 
-    im[12] = o.im[0] * oldim[12] + o.im[4] * oldim[13] + o.im[8]  * oldim[14] + o.im[12] * oldim[15];
-    im[13] = o.im[1] * oldim[12] + o.im[5] * oldim[13] + o.im[9]  * oldim[14] + o.im[13] * oldim[15];
-    im[14] = o.im[2] * oldim[12] + o.im[6] * oldim[13] + o.im[10] * oldim[14] + o.im[14] * oldim[15];
+    mul4x4affine(m, o.m, tmp);
+    std::memcpy(m, tmp, sizeof(m));
 
     // 3x3 parts are just copied over.
 
@@ -537,6 +672,15 @@ void AffineMatrix::operator *=(const AffineMatrix& o)
     m3[1] = m[1]; m3[4] = m[5]; m3[7] = m[9];
     m3[2] = m[2]; m3[5] = m[6]; m3[8] = m[10];
 
+    if(m_bLazyInverse) {
+        m_bInverseDirty = true;
+        return;
+    }
+
+    // Inverses are multiplied from the left.
+    mul4x4affine(o.im, im, tmp);
+    std::memcpy(im, tmp, sizeof(im));
+
     im3[0] = im[0]; im3[3] = im[4]; im3[6] = im[8];
     im3[1] = im[1]; im3[4] = im[5]; im3[7] = im[9];
     im3[2] = im[2]; im3[5] = im[6]; im3[8] = im[10];
@@ -623,7 +767,11 @@ AffineMatrix AffineMatrix::ortho2DProjection(float in_fW, float in_fH)
 
 AffineMatrix AffineMatrix::inverse() const
 {
+    // Makes sure a lazy inverse is up to date.
+    this->array16fInverse();
+
     AffineMatrix result;
+    result.m_bLazyInverse = m_bLazyInverse;
     result.m[0] = im[0]; result.m[4] = im[4]; result.m[8]  = im[8];  result.m[12] = im[12];
     result.m[1] = im[1]; result.m[5] = im[5]; result.m[9]  = im[9];  result.m[13] = im[13];
     result.m[2] = im[2]; result.m[6] = im[6]; result.m[10] = im[10]; result.m[14] = im[14];
@@ -656,49 +804,70 @@ Vector AffineMatrix::front() const
     return Vector(-m[2], -m[6], -m[10]);
 }
 
-////////////////////////////
-// Matrix-Matrix product. //
-////////////////////////////
+//////////////////////////////
+// Batched transformations. //
+//////////////////////////////
 
-AffineMatrix AffineMatrix::operator *(const AffineMatrix& o) const
+void AffineMatrix::transformPoints(const float *in_pts, float *out_pts, std::size_t in_n, std::size_t in_iStride) const
 {
-    AffineMatrix result;
-
-    // Operation optimized for affine matrices: the lower row is 0 0 0 1.
-
-    result.m[0]  = m[0] * o.m[0]  + m[4] * o.m[1]  + m[8]  * o.m[2];
-    result.m[1]  = m[1] * o.m[0]  + m[5] * o.m[1]  + m[9]  * o.m[2];
-    result.m[2]  = m[2] * o.m[0]  + m[6] * o.m[1]  + m[10] * o.m[2];
+    TransformTask task = {m, in_pts, out_pts, in_iStride};
+    ThreadPool::instance().parallelFor(in_n, transform_grain, &transform_range<true>, &task);
+}
 
-    result.m[4]  = m[0] * o.m[4]  + m[4] * o.m[5]  + m[8]  * o.m[6];
-    result.m[5]  = m[1] * o.m[4]  + m[5] * o.m[5]  + m[9]  * o.m[6];
-    result.m[6]  = m[2] * o.m[4]  + m[6] * o.m[5]  + m[10] * o.m[6];
+void AffineMatrix::transformDirections(const float *in_dirs, float *out_dirs, std::size_t in_n, std::size_t in_iStride) const
+{
+    TransformTask task = {m, in_dirs, out_dirs, in_iStride};
+    ThreadPool::instance().parallelFor(in_n, transform_grain, &transform_range<false>, &task);
+}
 
-    result.m[8]  = m[0] * o.m[8]  + m[4] * o.m[9]  + m[8]  * o.m[10];
-    result.m[9]  = m[1] * o.m[8]  + m[5] * o.m[9]  + m[9]  * o.m[10];
-    result.m[10] = m[2] * o.m[8]  + m[6] * o.m[9]  + m[10] * o.m[10];
+//////////////////////////
+// Inverse maintenance. //
+//////////////////////////
 
-    result.m[12] = m[0] * o.m[12] + m[4] * o.m[13] + m[8]  * o.m[14] + m[12] * o.m[15];
-    result.m[13] = m[1] * o.m[12] + m[5] * o.m[13] + m[9]  * o.m[14] + m[13] * o.m[15];
-    result.m[14] = m[2] * o.m[12] + m[6] * o.m[13] + m[10] * o.m[14] + m[14] * o.m[15];
+void AffineMatrix::updateInverse() const
+{
+    // The inverse of [A t; 0 1] is [A^-1 -A^-1*t; 0 1], A^-1 going through
+    // the cofactors of the 3x3 part, which is what m3 holds.
+    const float *a = m3;
+
+    float c[9];
+    c[0] = a[4]*a[8] - a[7]*a[5]; c[3] = a[6]*a[5] - a[3]*a[8]; c[6] = a[3]*a[7] - a[6]*a[4];
+    c[1] = a[7]*a[2] - a[1]*a[8]; c[4] = a[0]*a[8] - a[6]*a[2]; c[7] = a[6]*a[1] - a[0]*a[7];
+    c[2] = a[1]*a[5] - a[4]*a[2]; c[5] = a[3]*a[2] - a[0]*a[5]; c[8] = a[0]*a[4] - a[3]*a[1];
+
+    float det = a[0]*c[0] + a[3]*c[1] + a[6]*c[2];
+    if(det == 0.0f) {
+        im3[0] = 1.0f; im3[3] = 0.0f; im3[6] = 0.0f;
+        im3[1] = 0.0f; im3[4] = 1.0f; im3[7] = 0.0f;
+        im3[2] = 0.0f; im3[5] = 0.0f; im3[8] = 1.0f;
+    } else {
+        float one_over_det = 1.0f / det;
+        for(unsigned int i = 0 ; i < 9 ; ++i)
+            im3[i] = c[i] * one_over_det;
+    }
 
-    // Inverses are multiplied from the left.
+    im[0] = im3[0]; im[4] = im3[3]; im[8]  = im3[6];
+    im[1] = im3[1]; im[5] = im3[4]; im[9]  = im3[7];
+    im[2] = im3[2]; im[6] = im3[5]; im[10] = im3[8];
+    im[12] = -m[12]*im[0] - m[13]*im[4] - m[14]*im[8];
+    im[13] = -m[12]*im[1] - m[13]*im[5] - m[14]*im[9];
+    im[14] = -m[12]*im[2] - m[13]*im[6] - m[14]*im[10];
+    im[3] = im[7] = im[11] = 0.0f;
+    im[15] = 1.0f;
 
-    result.im[0]  = o.im[0] * im[0]  + o.im[4] * im[1]  + o.im[8]  * im[2];
-    result.im[1]  = o.im[1] * im[0]  + o.im[5] * im[1]  + o.im[9]  * im[2];
-    result.im[2]  = o.im[2] * im[0]  + o.im[6] * im[1]  + o.im[10] * im[2];
+    m_bInverseDirty = false;
+}
 
-    result.im[4]  = o.im[0] * im[4]  + o.im[4] * im[5]  + o.im[8]  * im[6];
-    result.im[5]  = o.im[1] * im[4]  + o.im[5] * im[5]  + o.im[9]  * im[6];
-    result.im[6]  = o.im[2] * im[4]  + o.im[6] * im[5]  + o.im[10] * im[6];
+////////////////////////////
+// Matrix-Matrix product. //
+////////////////////////////
 
-    result.im[8]  = o.im[0] * im[8]  + o.im[4] * im[9]  + o.im[8]  * im[10];
-    result.im[9]  = o.im[1] * im[8]  + o.im[5] * im[9]  + o.im[9]  * im[10];
-    result.im[10] = o.im[2] * im[8]  + o.im[6] * im[9]  + o.im[10] * im[10];
+AffineMatrix AffineMatrix::operator *(const AffineMatrix& o) const
+{
+    AffineMatrix result;
+    result.m_bLazyInverse = m_bLazyInverse;
 
-    result.im[12] = o.im[0] * im[12] + o.im[4] * im[13] + o.im[8]  * im[14] + o.im[12] * im[15];
-    result.im[13] = o.im[1] * im[12] + o.im[5] * im[13] + o.im[9]  * im[14] + o.im[13] * im[15];
-    result.im[14] = o.im[2] * im[12] + o.im[6] * im[13] + o.im[10] * im[14] + o.im[14] * im[15];
+    mul4x4affine(m, o.m, result.m);
 
     // 3x3 parts are just copied over.
 
@@ -706,6 +875,14 @@ AffineMatrix AffineMatrix::operator *(const AffineMatrix& o) const
     result.m3[1] = result.m[1]; result.m3[4] = result.m[5]; result.m3[7] = result.m[9];
     result.m3[2] = result.m[2]; result.m3[5] = result.m[6]; result.m3[8] = result.m[10];
 
+    if(m_bLazyInverse) {
+        result.m_bInverseDirty = true;
+        return result;
+    }
+
+    // Inverses are multiplied from the left.
+    mul4x4affine(o.array16fInverse(), this->array16fInverse(), result.im);
+
     result.im3[0] = result.im[0]; result.im3[3] = result.im[4]; result.im3[6] = result.im[8];
     result.im3[1] = result.im[1]; result.im3[4] = result.im[5]; result.im3[7] = result.im[9];
     result.im3[2] = result.im[2]; result.im3[5] = result.im[6]; result.im3[8] = result.im[10];
@@ -745,11 +922,16 @@ General4x4Matrix::General4x4Matrix()
 General4x4Matrix::General4x4Matrix(const General4x4Matrix& in_m)
     : Base4x4Matrix()
 {
+    m_bLazyInverse = in_m.m_bLazyInverse;
     this->operator=(in_m);
 }
 
 const General4x4Matrix& General4x4Matrix::operator=(const General4x4Matrix& in_m)
 {
+    // We keep our own way of handling the inverse, which may need it now.
+    if(!m_bLazyInverse)
+        in_m.array16fInverse();
+
     m[0] = in_m.m[0]; m[4] = in_m.m[4]; m[8]  = in_m.m[8];  m[12] = in_m.m[12];
     m[1] = in_m.m[1]; m[5] = in_m.m[5]; m[9]  = in_m.m[9];  m[13] = in_m.m[13];
     m[2] = in_m.m[2]; m[6] = in_m.m[6]; m[10] = in_m.m[10]; m[14] = in_m.m[14];
@@ -758,25 +940,11 @@ const General4x4Matrix& General4x4Matrix::operator=(const General4x4Matrix& in_m
     im[1] = in_m.im[1]; im[5] = in_m.im[5]; im[9]  = in_m.im[9];  im[13] = in_m.im[13];
     im[2] = in_m.im[2]; im[6] = in_m.im[6]; im[10] = in_m.im[10]; im[14] = in_m.im[14];
     im[3] = in_m.im[3]; im[7] = in_m.im[7]; im[11] = in_m.im[11]; im[15] = in_m.im[15];
+    m_bInverseDirty = in_m.m_bInverseDirty;
 
     return *this;
 }
 
-#ifdef BOUGE_COMPILE_CPP0X
-General4x4Matrix::General4x4Matrix(General4x4Matrix&& in_m)
-    : m(std::move(in_m.m))
-    , im(std::move(in_m.im))
-{ }
-
-const General4x4Matrix& General4x4Matrix::operator=(General4x4Matrix&& in_m)
-{
-    m = std::move(in_m.m);
-    im = std::move(in_m.im);
-
-    return *this;
-}
-#endif // BOUGE_COMPILE_CPP0X
-
 //////////////////////////////////
 // Special matrix constructors. //
 //////////////////////////////////
@@ -784,11 +952,16 @@ const General4x4Matrix& General4x4Matrix::operator=(General4x4Matrix&& in_m)
 General4x4Matrix::General4x4Matrix(const AffineMatrix& in_m)
     : Base4x4Matrix()
 {
+    m_bLazyInverse = in_m.m_bLazyInverse;
     this->operator=(in_m);
 }
 
 const General4x4Matrix& General4x4Matrix::operator=(const AffineMatrix& in_m)
 {
+    // We keep our own way of handling the inverse, which may need it now.
+    if(!m_bLazyInverse)
+        in_m.array16fInverse();
+
     m[0] = in_m.m[0]; m[4] = in_m.m[4]; m[8]  = in_m.m[8];  m[12] = in_m.m[12];
     m[1] = in_m.m[1]; m[5] = in_m.m[5]; m[9]  = in_m.m[9];  m[13] = in_m.m[13];
     m[2] = in_m.m[2]; m[6] = in_m.m[6]; m[10] = in_m.m[10]; m[14] = in_m.m[14];
@@ -797,25 +970,11 @@ const General4x4Matrix& General4x4Matrix::operator=(const AffineMatrix& in_m)
     im[1] = in_m.im[1]; im[5] = in_m.im[5]; im[9]  = in_m.im[9];  im[13] = in_m.im[13];
     im[2] = in_m.im[2]; im[6] = in_m.im[6]; im[10] = in_m.im[10]; im[14] = in_m.im[14];
     im[3] = in_m.im[3]; im[7] = in_m.im[7]; im[11] = in_m.im[11]; im[15] = in_m.im[15];
+    m_bInverseDirty = in_m.m_bInverseDirty;
 
     return *this;
 }
 
-#ifdef BOUGE_COMPILE_CPP0X
-General4x4Matrix::General4x4Matrix(AffineMatrix&& in_m)
-    : m(std::move(in_m.m))
-    , im(std::move(in_m.im))
-{ }
-
-const General4x4Matrix& General4x4Matrix::operator=(AffineMatrix&& in_m)
-{
-    m = std::move(in_m.m);
-    im = std::move(in_m.im);
-
-    return *this;
-}
-#endif // BOUGE_COMPILE_CPP0X
-
 General4x4Matrix General4x4Matrix::perspectiveProjection(float in_fFoV, float in_fAspectRatio, float in_fNearPlane, float in_fFarPlane)
 {
     // Check for ill-formated input.
@@ -847,8 +1006,8 @@ General4x4Matrix General4x4Matrix::perspectiveProjection(float in_fFoV, float in
                                             result.m[11] = -1.0f;        result.m[15] = 0.0f;
     result.im[0] = t*in_fAspectRatio;
                         result.im[5] = t;
-                                                                               result.im[14] = -1.0f;
-                                            result.im[11] = -0.5f*(f-n)/(f*n); result.im[15] = 0.5f*(f+n)/(f-n);
+                                            result.im[10] = 0.0f;              result.im[14] = -1.0f;
+                                            result.im[11] = -0.5f*(f-n)/(f*n); result.im[15] = 0.5f*(f+n)/(f*n);
     return result;
 }
 
@@ -858,7 +1017,11 @@ General4x4Matrix General4x4Matrix::perspectiveProjection(float in_fFoV, float in
 
 General4x4Matrix General4x4Matrix::inverse() const
 {
+    // Makes sure a lazy inverse is up to date.
+    this->array16fInverse();
+
     General4x4Matrix result;
+    result.m_bLazyInverse = m_bLazyInverse;
     result.m[0] = im[0]; result.m[4] = im[4]; result.m[8]  = im[8];  result.m[12] = im[12];
     result.m[1] = im[1]; result.m[5] = im[5]; result.m[9]  = im[9];  result.m[13] = im[13];
     result.m[2] = im[2]; result.m[6] = im[6]; result.m[10] = im[10]; result.m[14] = im[14];
@@ -870,6 +1033,59 @@ General4x4Matrix General4x4Matrix::inverse() const
     return result;
 }
 
+//////////////////////////
+// Inverse maintenance. //
+//////////////////////////
+
+void General4x4Matrix::updateInverse() const
+{
+    // Cofactor expansion through the 2x2 sub-determinants of the two upper
+    // and the two lower rows. Transposing both sides of the inverse doesn't
+    // change anything, so the storage order doesn't matter either.
+    float s0 = m[0]*m[5]  - m[4]*m[1];
+    float s1 = m[0]*m[9]  - m[8]*m[1];
+    float s2 = m[0]*m[13] - m[12]*m[1];
+    float s3 = m[4]*m[9]  - m[8]*m[5];
+    float s4 = m[4]*m[13] - m[12]*m[5];
+    float s5 = m[8]*m[13] - m[12]*m[9];
+    float c5 = m[10]*m[15] - m[14]*m[11];
+    float c4 = m[6]*m[15]  - m[14]*m[7];
+    float c3 = m[6]*m[11]  - m[10]*m[7];
+    float c2 = m[2]*m[15]  - m[14]*m[3];
+    float c1 = m[2]*m[11]  - m[10]*m[3];
+    float c0 = m[2]*m[7]   - m[6]*m[3];
+
+    float det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+    if(det == 0.0f) {
+        im[0] = 1.0f; im[4] = 0.0f; im[8]  = 0.0f; im[12] = 0.0f;
+        im[1] = 0.0f; im[5] = 1.0f; im[9]  = 0.0f; im[13] = 0.0f;
+        im[2] = 0.0f; im[6] = 0.0f; im[10] = 1.0f; im[14] = 0.0f;
+        im[3] = 0.0f; im[7] = 0.0f; im[11] = 0.0f; im[15] = 1.0f;
+        m_bInverseDirty = false;
+        return;
+    }
+
+    float d = 1.0f / det;
+    im[0]  = ( m[5]*c5  - m[9]*c4  + m[13]*c3) * d;
+    im[1]  = (-m[1]*c5  + m[9]*c2  - m[13]*c1) * d;
+    im[2]  = ( m[1]*c4  - m[5]*c2  + m[13]*c0) * d;
+    im[3]  = (-m[1]*c3  + m[5]*c1  - m[9]*c0)  * d;
+    im[4]  = (-m[4]*c5  + m[8]*c4  - m[12]*c3) * d;
+    im[5]  = ( m[0]*c5  - m[8]*c2  + m[12]*c1) * d;
+    im[6]  = (-m[0]*c4  + m[4]*c2  - m[12]*c0) * d;
+    im[7]  = ( m[0]*c3  - m[4]*c1  + m[8]*c0)  * d;
+    im[8]  = ( m[7]*s5  - m[11]*s4 + m[15]*s3) * d;
+    im[9]  = (-m[3]*s5  + m[11]*s2 - m[15]*s1) * d;
+    im[10] = ( m[3]*s4  - m[7]*s2  + m[15]*s0) * d;
+    im[11] = (-m[3]*s3  + m[7]*s1  - m[11]*s0) * d;
+    im[12] = (-m[6]*s5  + m[10]*s4 - m[14]*s3) * d;
+    im[13] = ( m[2]*s5  - m[10]*s2 + m[14]*s1) * d;
+    im[14] = (-m[2]*s4  + m[6]*s2  - m[14]*s0) * d;
+    im[15] = ( m[2]*s3  - m[6]*s1  + m[10]*s0) * d;
+
+    m_bInverseDirty = false;
+}
+
 ////////////////////////////
 // Matrix-Matrix product. //
 ////////////////////////////
@@ -877,55 +1093,42 @@ General4x4Matrix General4x4Matrix::inverse() const
 General4x4Matrix General4x4Matrix::operator *(const General4x4Matrix& o) const
 {
     General4x4Matrix result;
+    result.m_bLazyInverse = m_bLazyInverse;
 
-    result.m[0]  = m[0] * o.m[0]  + m[4] * o.m[1]  + m[8]  * o.m[2]  + m[12] * o.m[3];
-    result.m[1]  = m[1] * o.m[0]  + m[5] * o.m[1]  + m[9]  * o.m[2]  + m[13] * o.m[3];
-    result.m[2]  = m[2] * o.m[0]  + m[6] * o.m[1]  + m[10] * o.m[2]  + m[14] * o.m[3];
-    result.m[3]  = m[3] * o.m[0]  + m[7] * o.m[1]  + m[11] * o.m[2]  + m[15] * o.m[3];
-
-    result.m[4]  = m[0] * o.m[4]  + m[4] * o.m[5]  + m[8]  * o.m[6]  + m[12] * o.m[7];
-    result.m[5]  = m[1] * o.m[4]  + m[5] * o.m[5]  + m[9]  * o.m[6]  + m[13] * o.m[7];
-    result.m[6]  = m[2] * o.m[4]  + m[6] * o.m[5]  + m[10] * o.m[6]  + m[14] * o.m[7];
-    result.m[7]  = m[3] * o.m[4]  + m[7] * o.m[5]  + m[11] * o.m[6]  + m[15] * o.m[7];
+    mul4x4(m, o.m, result.m);
 
-    result.m[8]  = m[0] * o.m[8]  + m[4] * o.m[9]  + m[8]  * o.m[10] + m[12] * o.m[11];
-    result.m[9]  = m[1] * o.m[8]  + m[5] * o.m[9]  + m[9]  * o.m[10] + m[13] * o.m[11];
-    result.m[10] = m[2] * o.m[8]  + m[6] * o.m[9]  + m[10] * o.m[10] + m[14] * o.m[11];
-    result.m[11] = m[3] * o.m[8]  + m[7] * o.m[9]  + m[11] * o.m[10] + m[15] * o.m[11];
-
-    result.m[12] = m[0] * o.m[12] + m[4] * o.m[13] + m[8]  * o.m[14] + m[12] * o.m[15];
-    result.m[13] = m[1] * o.m[12] + m[5] * o.m[13] + m[9]  * o.m[14] + m[13] * o.m[15];
-    result.m[14] = m[2] * o.m[12] + m[6] * o.m[13] + m[10] * o.m[14] + m[14] * o.m[15];
-    result.m[15] = m[3] * o.m[12] + m[7] * o.m[13] + m[11] * o.m[14] + m[15] * o.m[15];
+    if(m_bLazyInverse) {
+        result.m_bInverseDirty = true;
+        return result;
+    }
 
     // Inverses are multiplied from the left.
-
-    result.im[0]  = o.im[0] * im[0]  + o.im[4] * im[1]  + o.im[8]  * im[2]  + o.im[12] * im[3];
-    result.im[1]  = o.im[1] * im[0]  + o.im[5] * im[1]  + o.im[9]  * im[2]  + o.im[13] * im[3];
-    result.im[2]  = o.im[2] * im[0]  + o.im[6] * im[1]  + o.im[10] * im[2]  + o.im[14] * im[3];
-    result.im[3]  = o.im[3] * im[0]  + o.im[7] * im[1]  + o.im[11] * im[2]  + o.im[15] * im[3];
-
-    result.im[4]  = o.im[0] * im[4]  + o.im[4] * im[5]  + o.im[8]  * im[6]  + o.im[12] * im[7];
-    result.im[5]  = o.im[1] * im[4]  + o.im[5] * im[5]  + o.im[9]  * im[6]  + o.im[13] * im[7];
-    result.im[6]  = o.im[2] * im[4]  + o.im[6] * im[5]  + o.im[10] * im[6]  + o.im[14] * im[7];
-    result.im[7]  = o.im[3] * im[4]  + o.im[7] * im[5]  + o.im[11] * im[6]  + o.im[15] * im[7];
-
-    result.im[8]  = o.im[0] * im[8]  + o.im[4] * im[9]  + o.im[8]  * im[10] + o.im[12] * im[11];
-    result.im[9]  = o.im[1] * im[8]  + o.im[5] * im[9]  + o.im[9]  * im[10] + o.im[13] * im[11];
-    result.im[10] = o.im[2] * im[8]  + o.im[6] * im[9]  + o.im[10] * im[10] + o.im[14] * im[11];
-    result.im[11] = o.im[3] * im[8]  + o.im[7] * im[9]  + o.im[11] * im[10] + o.im[15] * im[11];
-
-    result.im[12] = o.im[0] * im[12] + o.im[4] * im[13] + o.im[8]  * im[14] + o.im[12] * im[15];
-    result.im[13] = o.im[1] * im[12] + o.im[5] * im[13] + o.im[9]  * im[14] + o.im[13] * im[15];
-    result.im[14] = o.im[2] * im[12] + o.im[6] * im[13] + o.im[10] * im[14] + o.im[14] * im[15];
-    result.im[15] = o.im[3] * im[12] + o.im[7] * im[13] + o.im[11] * im[14] + o.im[15] * im[15];
+    mul4x4(o.array16fInverse(), this->array16fInverse(), result.im);
 
     return result;
 }
 
 void General4x4Matrix::operator *=(const General4x4Matrix& o)
 {
-    this->operator=(*this * o);
+    D_PYGLM_ALIGN(16) float tmp[16];
+
+    // Both inverses need to be up to date before we touch anything.
+    if(!m_bLazyInverse) {
+        o.array16fInverse();
+        this->array16fInverse();
+    }
+
+    mul4x4(m, o.m, tmp);
+    std::memcpy(m, tmp, sizeof(m));
+
+    if(m_bLazyInverse) {
+        m_bInverseDirty = true;
+        return;
+    }
+
+    // Inverses are multiplied from the left.
+    mul4x4(o.im, im, tmp);
+    std::memcpy(im, tmp, sizeof(im));
 }
 
 } // namespace PyGlMath
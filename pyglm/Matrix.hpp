@@ -24,14 +24,25 @@
 #ifndef PYGLM_MATRIX_H
 #define PYGLM_MATRIX_H
 
+#include "Util.hpp"
+
+#include <cstddef>
 #include <string>
-#include <vector>
+
+/// Whether matrices only compute their inverse when it's asked for, instead
+/// of along with every product. This is only the default for new matrices,
+/// see Base4x4Matrix::setLazyInverse. You may want to redefine it to 1.
+#ifndef D_PYGLM_LAZY_INVERSE
+#  define D_PYGLM_LAZY_INVERSE 0
+#endif
 
 namespace PyGlMath {
     class AffineMatrix;
     class General4x4Matrix;
     class Vector;
     class Quaternion;
+    class BinaryFormat;
+    class MappedAffineMatrices;
 
 /// This class is just a container for some of the common code of both other
 /// 4x4 matrix classes (AffineMatrix and General4x4Matrix).
@@ -62,7 +73,9 @@ public:
     inline const float *array16f() const {return &m[0];};
     /// \return A read-only array of 16 floats holding the values of the
     ///         inverse of the matrix in column-wise representation.
-    inline const float *array16fInverse() const {return &im[0];};
+    /// \note With a lazy inverse, this is where it gets computed if needed,
+    ///       which makes it unsafe to call from several threads, \see setLazyInverse.
+    inline const float *array16fInverse() const {if(m_bInverseDirty) this->updateInverse(); return &im[0];};
 
     /// \return A string-representation of the matrix and its inverse.
     /// \param in_iDecimalPlaces The amount of numbers to print behind the dot.
@@ -89,11 +102,45 @@ public:
     /// \note For example, the element [4, 1] is the element at the bottom left.
     float operator()(unsigned int i, unsigned int j) const;
 
+    ////////////////////////////
+    // Inverse maintenance.   //
+    ////////////////////////////
+
+    /// By default, every operation computes the inverse along with the matrix,
+    /// which roughly doubles the cost of the products. A matrix with a lazy
+    /// inverse only marks it as outdated instead, and computes it from the
+    /// matrix once it is needed, keeping it until the matrix changes again.\n
+    /// Products take this setting from their left operand, copies from the
+    /// copied matrix. Assignments keep the setting of the assigned-to matrix.
+    /// \param in_bLazy Whether to compute the inverse only when it's needed.
+    /// \note The default is given by D_PYGLM_LAZY_INVERSE.
+    /// \note An inverse computed from the matrix is slightly less precise than
+    ///       one built along with it. A singular matrix gets the identity as
+    ///       inverse.
+    /// \note Computing a lazy inverse writes to the matrix even through const
+    ///       access, whenever anything needs the inverse: array16fInverse,
+    ///       inverse, products and assignments to matrices whose inverse isn't
+    ///       lazy. A lazy matrix is thus not safe to use from several threads
+    ///       at once, not even only for reading; give each thread a copy. The
+    ///       bindings only work without the GIL on such copies or under a lock.
+    inline void setLazyInverse(bool in_bLazy) {m_bLazyInverse = in_bLazy;};
+    /// \return Whether this matrix computes its inverse only when it's needed.
+    inline bool lazyInverse() const {return m_bLazyInverse;};
+
 protected:
+    /// Computes the inverse (im and anything derived from it) from the matrix
+    /// and marks it as up to date.
+    virtual void updateInverse() const = 0;
+
     /// The matrix-data, in row-wise order.
-    std::vector<float> m;
-    /// The inverse matrix-data, in row-wise order.
-    std::vector<float> im;
+    D_PYGLM_ALIGN(16) float m[16];
+    /// The inverse matrix-data, in row-wise order. It's a cache when the
+    /// inverse is lazy, hence mutable.
+    D_PYGLM_ALIGN(16) mutable float im[16];
+    /// Whether im is outdated and needs to be computed before being read.
+    mutable bool m_bInverseDirty;
+    /// Whether products leave the inverse outdated instead of computing it.
+    bool m_bLazyInverse;
 };
 
 /// This matrix class defines a four-by-four matrix that is intended to be used
@@ -113,6 +160,8 @@ class AffineMatrix : public Base4x4Matrix {
     template<class T>
     friend T& operator>>(T& f, AffineMatrix& m);
     friend class General4x4Matrix;
+    friend class BinaryFormat;
+    friend class MappedAffineMatrices;
 public:
     virtual ~AffineMatrix();
 
@@ -129,15 +178,6 @@ public:
     /// \param in_m The matrix to be copied.
     /// \return a const reference to myself that might be used as a rvalue.
     const AffineMatrix& operator=(const AffineMatrix& in_m);
-#ifdef BOUGE_COMPILE_CPP0X
-    /// Moves a matrix.
-    /// \param in_m The matrix to be moved.
-    AffineMatrix(AffineMatrix&& in_m);
-    /// Moves a matrix.
-    /// \param in_m The matrix to be moved.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const AffineMatrix& operator=(AffineMatrix&& in_m);
-#endif // BOUGE_COMPILE_CPP0X
 
     //////////////////////////////////
     // Special matrix constructors. //
@@ -255,7 +295,9 @@ public:
     /// \return A read-only array of 9 floats holding the values of the
     ///         upper left 3x3 part of the inverse of the matrix in
     ///         column-wise representation.
-    inline const float *array9fInverse() const {return &im3[0];};
+    /// \note With a lazy inverse, this is where it gets computed if needed,
+    ///       which makes it unsafe to call from several threads, \see setLazyInverse.
+    inline const float *array9fInverse() const {if(m_bInverseDirty) this->updateInverse(); return &im3[0];};
 
     /// \return An AffineMatrix representing the inverse of myself. (Having
     ///         myself as its inverse again.)
@@ -276,6 +318,39 @@ public:
     /// \note It is not normalized, but if this matrix does no scaling it should be normal.
     Vector front() const;
 
+    //////////////////////////////
+    // Batched transformations. //
+    //////////////////////////////
+
+    /// Transforms many points at once, which is a lot faster than transforming
+    /// them one by one using operator*.
+    /// \param in_pts The points to transform, \a in_iStride floats each.
+    /// \param out_pts Where to write the transformed points. This may be the
+    ///                same as \a in_pts for transforming in-place, but the two
+    ///                may not overlap otherwise.
+    /// \param in_n The amount of points to transform.
+    /// \param in_iStride The amount of floats per point:
+    ///                   - 3: x y z and an implied w of 1.
+    ///                   - 4: x y z w, which is what operator* does.
+    ///                   - more: x y z as with 3, the other floats being
+    ///                     left untouched. For example interleaved vertices.
+    /// \note Strides of 3 and 4 are the fast ones.
+    /// \note Tens of thousands of points and more get split over the ThreadPool,
+    ///       and so do directions.
+    void transformPoints(const float *in_pts, float *out_pts, std::size_t in_n, std::size_t in_iStride = 3) const;
+
+    /// Transforms many directions at once, that is without translating them.
+    /// \param in_dirs The directions to transform, \a in_iStride floats each.
+    /// \param out_dirs Where to write the transformed directions. This may be
+    ///                 the same as \a in_dirs for transforming in-place, but the
+    ///                 two may not overlap otherwise.
+    /// \param in_n The amount of directions to transform.
+    /// \param in_iStride The amount of floats per direction: x y z followed
+    ///                   by floats left untouched, except for 4 where w is copied.
+    /// \note To transform normals, use the inverse transpose, which is
+    ///       array9fInverse read row-wise.
+    void transformDirections(const float *in_dirs, float *out_dirs, std::size_t in_n, std::size_t in_iStride = 3) const;
+
     ////////////////////////////
     // Matrix-Matrix product. //
     ////////////////////////////
@@ -300,13 +375,16 @@ public:
     /// \note The result is a general matrix, not an affine one anymore.
     General4x4Matrix operator *(const General4x4Matrix& o) const;
 
+protected:
+    virtual void updateInverse() const;
+
 private:
     /// The upper-left 3x3 part of the matrix-data, used to pass it to
     /// OpenGl as a pointer.
-    std::vector<float> m3;
+    D_PYGLM_ALIGN(16) float m3[9];
     /// The upper-left 3x3 part of the inverse matrix-data, used to pass it to
     /// OpenGl as a pointer.
-    std::vector<float> im3;
+    D_PYGLM_ALIGN(16) mutable float im3[9];
 };
 
 /// This matrix class defines a more general four-by-four matrix.
@@ -324,6 +402,7 @@ class General4x4Matrix : public Base4x4Matrix {
     template<class T>
     friend T& operator>>(T& f, General4x4Matrix& m);
     friend class AffineMatrix;
+    friend class BinaryFormat;
 public:
     virtual ~General4x4Matrix();
 
@@ -340,15 +419,6 @@ public:
     /// \param in_m The matrix to be copied.
     /// \return a const reference to myself that might be used as a rvalue.
     const General4x4Matrix& operator=(const General4x4Matrix& in_m);
-#ifdef BOUGE_COMPILE_CPP0X
-    /// Moves a matrix.
-    /// \param in_m The matrix to be moved.
-    General4x4Matrix(General4x4Matrix&& in_m);
-    /// Moves a matrix.
-    /// \param in_m The matrix to be moved.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const General4x4Matrix& operator=(General4x4Matrix&& in_m);
-#endif // BOUGE_COMPILE_CPP0X
 
     //////////////////////////////////
     // Special matrix constructors. //
@@ -361,15 +431,6 @@ public:
     /// \param in_m The affine matrix to be copied.
     /// \return a const reference to myself that might be used as a rvalue.
     const General4x4Matrix& operator=(const AffineMatrix& in_m);
-#ifdef BOUGE_COMPILE_CPP0X
-    /// Moves an affine matrix into a general matrix.
-    /// \param in_m The affine matrix to be moved.
-    General4x4Matrix(AffineMatrix&& in_m);
-    /// Moves an affine matrix into a general matrix.
-    /// \param in_m The affine matrix to be moved.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const General4x4Matrix& operator=(AffineMatrix&& in_m);
-#endif // BOUGE_COMPILE_CPP0X
 
     /// Creates a perspective projection matrix and its inverse the unprojection
     /// matrix.\n
@@ -404,6 +465,9 @@ public:
     /// \param o The other matrix that has to be multiplied from the right.
     /// \note Of course, for the inverse the multiplication is done from the left.
     void operator *=(const General4x4Matrix& o);
+
+protected:
+    virtual void updateInverse() const;
 };
 
 #include "Matrix.inl"
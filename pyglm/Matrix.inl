@@ -57,6 +57,7 @@ T& operator>>(T& f, AffineMatrix& m) {
 
     m.im[3] = m.im[7] = m.im[11] = 0.0f;
     m.im[15] = 1.0f;
+    m.m_bInverseDirty = false;
 
     // 3x3 parts are just copied over.
 
@@ -97,6 +98,7 @@ T& operator>>(T& f, General4x4Matrix& m) {
         f >> m.m[i];
     for(unsigned int i = 0 ; i < 16 ; ++i)
         f >> m.im[i];
+    m.m_bInverseDirty = false;
 
     return f;
 }
@@ -0,0 +1,463 @@
+#include "Matrix_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Quaternion_wrap.hpp"
+#include "Util_wrap.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Takes either a Quaternion or anything the Quaternion constructor accepts.
+PyGlMath::Quaternion rotation_from(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() == 1 && kwargs.length() == 0 && Quaternion::check(args[0])) {
+        Quaternion::QuaternionObject q(args[0]);
+        return q.getCxxObject()->m_quat;
+    }
+
+    Quaternion::QuaternionObject q(Py::Callable(Quaternion::type()).apply(args, kwargs));
+    return q.getCxxObject()->m_quat;
+}
+
+// A 4x4 matrix, indexed as [row, column] but stored column-major. Read-only
+// as writing to it would get the inverse out of sync.
+FloatBuffer matrix_buffer(const PyGlMath::Base4x4Matrix& m)
+{
+    static Py_ssize_t shape[] = {4, 4};
+    static Py_ssize_t strides[] = {sizeof(float), 4*sizeof(float)};
+    static Py_ssize_t size = 16;
+    FloatBuffer b = {const_cast<float*>(m.array16f()), 2, shape, strides, &size, true};
+    return b;
+}
+
+// The common part of AffineMatrix.transformPoints and transformDirections.
+// Large batches are transformed without the GIL, hence by a copy of the matrix.
+Py::Object transform(const PyGlMath::AffineMatrix& mat, const Py::Tuple& args, const Py::Dict& kwargs, bool points, const char* name)
+{
+    const PyGlMath::AffineMatrix m(mat);
+
+    if(args.length() + kwargs.length() < 1 || args.length() + kwargs.length() > 2) {
+        throw Py::TypeError(std::string("AffineMatrix.") + name + " takes a buffer of floats and optionally an 'out' buffer of the same size.");
+    }
+
+    static const char* const point_keys[] = {"points", "out", NULL};
+    static const char* const direction_keys[] = {"directions", "out", NULL};
+    check_keywords(args, kwargs, points ? point_keys : direction_keys, (std::string("AffineMatrix.") + name).c_str());
+
+    Py::Object in_arg = argument(args, kwargs, 0, points ? "points" : "directions");
+    if(in_arg.isNone()) {
+        throw Py::TypeError(std::string("AffineMatrix.") + name + " takes a buffer of floats and optionally an 'out' buffer of the same size.");
+    }
+    FloatBufferArg in(in_arg, false, name);
+    const std::size_t stride = in.group(3);
+    if(stride < 3 || in.size() % stride != 0) {
+        throw Py::ValueError(std::string("AffineMatrix.") + name + " needs groups of at least three floats (x y z ...).");
+    }
+    const std::size_t n = in.size() / stride;
+
+    Py::Object out_arg = argument(args, kwargs, 1, "out");
+    if(out_arg.isNone()) {
+        // Copying the untouched floats over too.
+        std::vector<float> out;
+        resize_or_raise(out, in.size());
+        std::copy(in.data(), in.data() + in.size(), out.begin());
+        {
+            AllowThreads nogil(in.size());
+            if(points) {
+                m.transformPoints(in.data(), out.empty() ? 0 : &out[0], n, stride);
+            } else {
+                m.transformDirections(in.data(), out.empty() ? 0 : &out[0], n, stride);
+            }
+        }
+        return float_array(out.empty() ? 0 : &out[0], out.size());
+    }
+
+    FloatBufferArg out(out_arg, true, "out");
+    if(out.size() != in.size() || out.group(stride) != stride) {
+        throw Py::ValueError(std::string("The output of AffineMatrix.") + name + " needs to be of the same size and shape as the input.");
+    }
+
+    {
+        AllowThreads nogil(in.size());
+        if(points) {
+            m.transformPoints(in.data(), out.data(), n, stride);
+        } else {
+            m.transformDirections(in.data(), out.data(), n, stride);
+        }
+    }
+    return out_arg;
+}
+
+Py::Object matrix_repr(const char* name, const PyGlMath::Base4x4Matrix& m)
+{
+    // Given row-wise for readability, just like Base4x4Matrix::to_s does.
+    std::OSTRSTREAM ss;
+    ss << name << "(" << m[0] << "," << m[4] << "," << m[8]  << "," << m[12] << "; "
+                      << m[1] << "," << m[5] << "," << m[9]  << "," << m[13] << "; "
+                      << m[2] << "," << m[6] << "," << m[10] << "," << m[14] << "; "
+                      << m[3] << "," << m[7] << "," << m[11] << "," << m[15] << ")";
+    return Py::String(ss.str());
+}
+
+}
+
+////////////////////////////////
+////////////////////////////////
+//// The Affine Matrix part ////
+////////////////////////////////
+////////////////////////////////
+
+AffineMatrix::AffineMatrix(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<AffineMatrix>::PythonClass(self, args, kwds)
+    , m_mat()
+{
+    if(args.length() == 0 && kwds.length() == 0) {
+        // no-op, identity.
+    } else if(args.length() == 1 && kwds.length() == 0 && AffineMatrix::check(args[0])) {
+        AffineMatrixObject other(args[0]);
+        m_mat = other.getCxxObject()->m_mat;
+    } else {
+        throw Py::ValueError("AffineMatrix can only be created as an identity or as a copy of another AffineMatrix. Use translation, rotation, scale or transformation for the others.");
+    }
+}
+
+AffineMatrix::AffineMatrix(Py::PythonClassInstance *self, const PyGlMath::AffineMatrix& m)
+    : Py::PythonClass<AffineMatrix>::PythonClass(self, no_args(), no_kwds())
+    , m_mat(m)
+{ }
+
+AffineMatrix::AffineMatrixObject AffineMatrix::make_inst(const PyGlMath::AffineMatrix& m)
+{
+    return make_wrapped_inst<AffineMatrix>(m);
+}
+
+AffineMatrix::~AffineMatrix()
+{ }
+
+void AffineMatrix::init_type()
+{
+    behaviors().name("AffineMatrix");
+    behaviors().doc("A 4x4 matrix for affine transformations which always keeps its inverse at hand.");
+    behaviors().supportRepr();
+    behaviors().supportStr();
+    behaviors().supportSequenceType();
+    behaviors().supportNumberType();
+    behaviors().type_object()->tp_as_number->nb_inplace_multiply = &number_inplace_handler<AffineMatrix, &AffineMatrix::number_inplace_multiply>;
+    support_float_buffer<AffineMatrix>(behaviors());
+
+    PYCXX_ADD_NOARGS_METHOD(inverse, inverse, "Returns the inverse of this matrix. This is a mere copy, unless the inverse is lazy and needs to be computed first.");
+    PYCXX_ADD_NOARGS_METHOD(lazyInverse, lazyInverse, "Whether this matrix only computes its inverse when it's needed, instead of along with every product.");
+    PYCXX_ADD_VARARGS_METHOD(setLazyInverse, setLazyInverse, "Sets whether this matrix only computes its inverse when it's needed. Products take this from their left operand.");
+    PYCXX_ADD_NOARGS_METHOD(right, right, "Returns the 'right' (X) vector of this matrix's local coordinate system.");
+    PYCXX_ADD_NOARGS_METHOD(up, up, "Returns the 'up' (Y) vector of this matrix's local coordinate system.");
+    PYCXX_ADD_NOARGS_METHOD(front, front, "Returns the 'front' (-Z) vector of this matrix's local coordinate system.");
+    PYCXX_ADD_KEYWORDS_METHOD(transformPoints, transformPoints, "Transforms all points of a buffer of floats (x y z [w] ...) at once: transformPoints(points, out=None). Writes to 'out', which may be 'points' itself, or returns an array.array if not given.");
+    PYCXX_ADD_KEYWORDS_METHOD(transformDirections, transformDirections, "Same as transformPoints, but without translating: transformDirections(directions, out=None).");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object AffineMatrix::translation(const Py::Tuple& args)
+{
+    if(args.length() == 3) {
+        return make_inst(PyGlMath::AffineMatrix::translation(Py::Float(args[0]), Py::Float(args[1]), Py::Float(args[2])));
+    } else if(args.length() == 1) {
+        return make_inst(PyGlMath::AffineMatrix::translation(vector_from(args[0], "translation takes a Vector or an iterable as single argument")));
+    }
+
+    throw Py::TypeError("translation takes either three numbers or a single Vector.");
+}
+
+Py::Object AffineMatrix::rotation(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return make_inst(PyGlMath::AffineMatrix::rotation(rotation_from(args, kwargs)));
+}
+
+Py::Object AffineMatrix::scale(const Py::Tuple& args)
+{
+    if(args.length() == 3) {
+        return make_inst(PyGlMath::AffineMatrix::scale(Py::Float(args[0]), Py::Float(args[1]), Py::Float(args[2])));
+    } else if(args.length() == 1 && (Vector::check(args[0]) || args[0].isSequence())) {
+        return make_inst(PyGlMath::AffineMatrix::scale(vector_from(args[0], "scale takes a number, a Vector or an iterable as single argument")));
+    } else if(args.length() == 1) {
+        return make_inst(PyGlMath::AffineMatrix::scale(Py::Float(args[0])));
+    }
+
+    throw Py::TypeError("scale takes either one number, three numbers or a single Vector.");
+}
+
+Py::Object AffineMatrix::transformation(const Py::Tuple& args)
+{
+    if(args.length() != 2 && args.length() != 3) {
+        throw Py::TypeError("transformation takes a translation Vector, a rotation Quaternion and optionally a scaling Vector.");
+    }
+
+    PyGlMath::Vector trans = vector_from(args[0], "The first argument to transformation ('translation') needs to be a Vector or an iterable.");
+    PyGlMath::Quaternion rot = rotation_from(Py::TupleN(args[1]), Py::Dict());
+
+    if(args.length() == 2) {
+        return make_inst(PyGlMath::AffineMatrix::transformation(trans, rot));
+    }
+
+    PyGlMath::Vector scale = vector_from(args[2], "The third argument to transformation ('scale') needs to be a Vector or an iterable.");
+    return make_inst(PyGlMath::AffineMatrix::transformation(trans, rot, scale));
+}
+
+FloatBuffer AffineMatrix::float_buffer()
+{
+    return matrix_buffer(m_mat);
+}
+
+Py::Object AffineMatrix::repr()
+{
+    return matrix_repr("AffineMatrix", m_mat);
+}
+
+Py::Object AffineMatrix::str()
+{
+    return Py::String(m_mat.to_s());
+}
+
+int AffineMatrix::sequence_length()
+{
+    return 16;
+}
+
+Py::Object AffineMatrix::sequence_item(Py_ssize_t i)
+{
+    if(i < 0 || i >= 16) {
+        throw Py::IndexError("AffineMatrix index out of range, it holds 16 elements in column-major order.");
+    }
+
+    return Py::Float(m_mat[i]);
+}
+
+Py::Object AffineMatrix::number_multiply(const Py::Object& other_)
+{
+    if(AffineMatrix::check(other_)) {
+        AffineMatrixObject other(other_);
+        return make_inst(m_mat * other.getCxxObject()->m_mat);
+    } else if(General4x4Matrix::check(other_)) {
+        General4x4Matrix::General4x4MatrixObject other(other_);
+        return General4x4Matrix::make_inst(m_mat * other.getCxxObject()->m_mat);
+    } else if(Vector::check(other_)) {
+        Vector::VectorObject other(other_);
+        return Vector::make_inst(m_mat * other.getCxxObject()->m_vec);
+    }
+
+    throw Py::TypeError("An AffineMatrix may only be multiplied by another matrix or by a Vector.");
+}
+
+bool AffineMatrix::number_inplace_multiply(const Py::Object& other_)
+{
+    // The product with a General4x4Matrix or a Vector is of another type.
+    if(!AffineMatrix::check(other_)) {
+        return false;
+    }
+
+    m_mat *= cxx_object<AffineMatrix>(other_.ptr())->m_mat;
+    return true;
+}
+
+Py::Object AffineMatrix::inverse()
+{
+    return make_inst(m_mat.inverse());
+}
+
+Py::Object AffineMatrix::lazyInverse()
+{
+    return Py::Boolean(m_mat.lazyInverse());
+}
+
+Py::Object AffineMatrix::setLazyInverse(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("AffineMatrix.setLazyInverse takes one argument");
+    }
+
+    m_mat.setLazyInverse(args[0].isTrue());
+    return Py::None();
+}
+
+Py::Object AffineMatrix::right()
+{
+    return Vector::make_inst(m_mat.right());
+}
+
+Py::Object AffineMatrix::up()
+{
+    return Vector::make_inst(m_mat.up());
+}
+
+Py::Object AffineMatrix::front()
+{
+    return Vector::make_inst(m_mat.front());
+}
+
+Py::Object AffineMatrix::transformPoints(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return transform(m_mat, args, kwargs, true, "transformPoints");
+}
+
+Py::Object AffineMatrix::transformDirections(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return transform(m_mat, args, kwargs, false, "transformDirections");
+}
+
+/////////////////////////////////
+/////////////////////////////////
+//// The General Matrix part ////
+/////////////////////////////////
+/////////////////////////////////
+
+General4x4Matrix::General4x4Matrix(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<General4x4Matrix>::PythonClass(self, args, kwds)
+    , m_mat()
+{
+    if(args.length() == 0 && kwds.length() == 0) {
+        // no-op, identity.
+    } else if(args.length() == 1 && kwds.length() == 0 && General4x4Matrix::check(args[0])) {
+        General4x4MatrixObject other(args[0]);
+        m_mat = other.getCxxObject()->m_mat;
+    } else if(args.length() == 1 && kwds.length() == 0 && AffineMatrix::check(args[0])) {
+        AffineMatrix::AffineMatrixObject other(args[0]);
+        m_mat = other.getCxxObject()->m_mat;
+    } else {
+        throw Py::ValueError("General4x4Matrix can only be created as an identity or as a copy of another matrix. Use perspectiveProjection for the others.");
+    }
+}
+
+General4x4Matrix::General4x4Matrix(Py::PythonClassInstance *self, const PyGlMath::General4x4Matrix& m)
+    : Py::PythonClass<General4x4Matrix>::PythonClass(self, no_args(), no_kwds())
+    , m_mat(m)
+{ }
+
+General4x4Matrix::General4x4MatrixObject General4x4Matrix::make_inst(const PyGlMath::General4x4Matrix& m)
+{
+    return make_wrapped_inst<General4x4Matrix>(m);
+}
+
+General4x4Matrix::~General4x4Matrix()
+{ }
+
+void General4x4Matrix::init_type()
+{
+    behaviors().name("General4x4Matrix");
+    behaviors().doc("A general 4x4 matrix, for example a perspective projection, which always keeps its inverse at hand.");
+    behaviors().supportRepr();
+    behaviors().supportStr();
+    behaviors().supportSequenceType();
+    behaviors().supportNumberType();
+    behaviors().type_object()->tp_as_number->nb_inplace_multiply = &number_inplace_handler<General4x4Matrix, &General4x4Matrix::number_inplace_multiply>;
+    support_float_buffer<General4x4Matrix>(behaviors());
+
+    PYCXX_ADD_NOARGS_METHOD(inverse, inverse, "Returns the inverse of this matrix. This is a mere copy, unless the inverse is lazy and needs to be computed first.");
+    PYCXX_ADD_NOARGS_METHOD(lazyInverse, lazyInverse, "Whether this matrix only computes its inverse when it's needed, instead of along with every product.");
+    PYCXX_ADD_VARARGS_METHOD(setLazyInverse, setLazyInverse, "Sets whether this matrix only computes its inverse when it's needed. Products take this from their left operand.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object General4x4Matrix::perspectiveProjection(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() < 2 || args.length() + kwargs.length() > 4) {
+        throw Py::TypeError("perspectiveProjection takes the field of view (in degrees), the aspect ratio and optionally the 'near' and 'far' plane distances.");
+    }
+
+    static const char* const keys[] = {"fov", "aspect", "near", "far", NULL};
+    check_keywords(args, kwargs, keys, "perspectiveProjection");
+
+    float near = 2.5f, far = 1000.0f;
+    if(args.length() > 2) {
+        near = Py::Float(args[2]);
+    } else if(kwargs.hasKey("near")) {
+        near = Py::Float(kwargs.getItem("near"));
+    }
+    if(args.length() > 3) {
+        far = Py::Float(args[3]);
+    } else if(kwargs.hasKey("far")) {
+        far = Py::Float(kwargs.getItem("far"));
+    }
+
+    return make_inst(PyGlMath::General4x4Matrix::perspectiveProjection(Py::Float(args[0]), Py::Float(args[1]), near, far));
+}
+
+FloatBuffer General4x4Matrix::float_buffer()
+{
+    return matrix_buffer(m_mat);
+}
+
+Py::Object General4x4Matrix::repr()
+{
+    return matrix_repr("General4x4Matrix", m_mat);
+}
+
+Py::Object General4x4Matrix::str()
+{
+    return Py::String(m_mat.to_s());
+}
+
+int General4x4Matrix::sequence_length()
+{
+    return 16;
+}
+
+Py::Object General4x4Matrix::sequence_item(Py_ssize_t i)
+{
+    if(i < 0 || i >= 16) {
+        throw Py::IndexError("General4x4Matrix index out of range, it holds 16 elements in column-major order.");
+    }
+
+    return Py::Float(m_mat[i]);
+}
+
+Py::Object General4x4Matrix::number_multiply(const Py::Object& other_)
+{
+    if(General4x4Matrix::check(other_)) {
+        General4x4MatrixObject other(other_);
+        return make_inst(m_mat * other.getCxxObject()->m_mat);
+    } else if(AffineMatrix::check(other_)) {
+        AffineMatrix::AffineMatrixObject other(other_);
+        return make_inst(m_mat * PyGlMath::General4x4Matrix(other.getCxxObject()->m_mat));
+    } else if(Vector::check(other_)) {
+        Vector::VectorObject other(other_);
+        return Vector::make_inst(m_mat * other.getCxxObject()->m_vec);
+    }
+
+    throw Py::TypeError("A General4x4Matrix may only be multiplied by another matrix or by a Vector.");
+}
+
+bool General4x4Matrix::number_inplace_multiply(const Py::Object& other_)
+{
+    if(General4x4Matrix::check(other_)) {
+        m_mat *= cxx_object<General4x4Matrix>(other_.ptr())->m_mat;
+        return true;
+    } else if(AffineMatrix::check(other_)) {
+        m_mat *= PyGlMath::General4x4Matrix(cxx_object<AffineMatrix>(other_.ptr())->m_mat);
+        return true;
+    }
+
+    return false;
+}
+
+Py::Object General4x4Matrix::inverse()
+{
+    return make_inst(m_mat.inverse());
+}
+
+Py::Object General4x4Matrix::lazyInverse()
+{
+    return Py::Boolean(m_mat.lazyInverse());
+}
+
+Py::Object General4x4Matrix::setLazyInverse(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("General4x4Matrix.setLazyInverse takes one argument");
+    }
+
+    m_mat.setLazyInverse(args[0].isTrue());
+    return Py::None();
+}
@@ -0,0 +1,95 @@
+#include "Matrix.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+class AffineMatrix : public Py::PythonClass<AffineMatrix>
+{
+public:
+    AffineMatrix(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing matrix without parsing arguments.
+    AffineMatrix(Py::PythonClassInstance *self, const PyGlMath::AffineMatrix& m);
+    virtual ~AffineMatrix();
+
+    static void init_type();
+
+    typedef Py::PythonClassObject<AffineMatrix> AffineMatrixObject;
+    static AffineMatrixObject make_inst(const PyGlMath::AffineMatrix& m);
+
+    static Py::Object translation(const Py::Tuple& args);
+    static Py::Object rotation(const Py::Tuple& args, const Py::Dict& kwargs);
+    static Py::Object scale(const Py::Tuple& args);
+    static Py::Object transformation(const Py::Tuple& args);
+
+    PyGlMath::AffineMatrix m_mat;
+
+    /// Used by the buffer protocol, \see get_float_buffer.
+    FloatBuffer float_buffer();
+
+private:
+    Py::Object repr();
+    Py::Object str();
+
+    int sequence_length();
+    Py::Object sequence_item(Py_ssize_t i);
+
+    Py::Object number_multiply(const Py::Object& other_);
+    bool number_inplace_multiply(const Py::Object& other_);
+
+    Py::Object inverse();
+    PYCXX_NOARGS_METHOD_DECL(AffineMatrix, inverse);
+    Py::Object right();
+    PYCXX_NOARGS_METHOD_DECL(AffineMatrix, right);
+    Py::Object up();
+    PYCXX_NOARGS_METHOD_DECL(AffineMatrix, up);
+    Py::Object front();
+    PYCXX_NOARGS_METHOD_DECL(AffineMatrix, front);
+    Py::Object transformPoints(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(AffineMatrix, transformPoints);
+    Py::Object transformDirections(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(AffineMatrix, transformDirections);
+    Py::Object lazyInverse();
+    PYCXX_NOARGS_METHOD_DECL(AffineMatrix, lazyInverse);
+    Py::Object setLazyInverse(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(AffineMatrix, setLazyInverse);
+};
+
+class General4x4Matrix : public Py::PythonClass<General4x4Matrix>
+{
+public:
+    General4x4Matrix(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing matrix without parsing arguments.
+    General4x4Matrix(Py::PythonClassInstance *self, const PyGlMath::General4x4Matrix& m);
+    virtual ~General4x4Matrix();
+
+    static void init_type();
+
+    typedef Py::PythonClassObject<General4x4Matrix> General4x4MatrixObject;
+    static General4x4MatrixObject make_inst(const PyGlMath::General4x4Matrix& m);
+
+    static Py::Object perspectiveProjection(const Py::Tuple& args, const Py::Dict& kwargs);
+
+    PyGlMath::General4x4Matrix m_mat;
+
+    /// Used by the buffer protocol, \see get_float_buffer.
+    FloatBuffer float_buffer();
+
+private:
+    Py::Object repr();
+    Py::Object str();
+
+    int sequence_length();
+    Py::Object sequence_item(Py_ssize_t i);
+
+    Py::Object number_multiply(const Py::Object& other_);
+    bool number_inplace_multiply(const Py::Object& other_);
+
+    Py::Object inverse();
+    PYCXX_NOARGS_METHOD_DECL(General4x4Matrix, inverse);
+    Py::Object lazyInverse();
+    PYCXX_NOARGS_METHOD_DECL(General4x4Matrix, lazyInverse);
+    Py::Object setLazyInverse(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(General4x4Matrix, setLazyInverse);
+};
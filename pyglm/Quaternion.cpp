@@ -24,10 +24,262 @@
 
 #include "Quaternion.hpp"
 #include "Vector.hpp"
+#include "ThreadPool.hpp"
 #include "Util.hpp"
 
 #include <sstream>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+// Kernels of the batched interpolations. They take all arrays through
+// restrict pointers and have no branches, so that the compiler can turn
+// each of them into SIMD code.
+
+// Scales the quaternion (x y z w) to unit length, unless it is too short to do
+// so reliably, in which case it's left untouched and 1 is returned. Those need
+// Quaternion::normalize's special treatment.
+inline int normalize_or_keep(float& x, float& y, float& z, float& w)
+{
+    const float eps = D_PYGLM_EPSILON;
+
+    float l = std::sqrt(x*x + y*y + z*z + w*w);
+    float largest = std::max(std::max(std::abs(x), std::abs(y)), std::max(std::abs(z), std::abs(w)));
+    int special = (largest < eps) | (l < eps);
+    float keep = static_cast<float>(special);
+    float m = keep + (1.0f - keep) / std::max(l, eps);
+    x *= m;
+    y *= m;
+    z *= m;
+    w *= m;
+    return special;
+}
+
+// acos on [-1, 1], using Abramowitz and Stegun 4.4.46 for the positive half:
+// the absolute error is below 2e-8, on top of float rounding. Values beyond
+// [-1, 1] are clamped.
+inline float acos_poly(float x)
+{
+    const float pi = 3.14159265358979f;
+    float a = std::abs(x);
+    float p = -0.0012624911f;
+    p = p*a + 0.0066700901f;
+    p = p*a - 0.0170881256f;
+    p = p*a + 0.0308918810f;
+    p = p*a - 0.0501743046f;
+    p = p*a + 0.0889789874f;
+    p = p*a - 0.2145988016f;
+    p = p*a + 1.5707963050f;
+    float r = std::sqrt(std::max(1.0f - a, 0.0f)) * p;
+
+    // acos(-x) = pi - acos(x), by moving the sign instead of branching.
+    return 0.5f*pi + std::copysign(1.0f, x)*(r - 0.5f*pi);
+}
+
+// sin on [-pi/2, 3pi/2], mirrored onto [-pi/2, pi/2] where the Taylor series
+// up to x^11 is off by less than 6e-8. Near 0, the error is relative.
+inline float sin_poly(float x)
+{
+    const float half_pi = 1.57079632679490f;
+    float y = half_pi - std::abs(x - half_pi);
+    float y2 = y*y;
+    float p = -1.0f/39916800.0f;
+    p = p*y2 + 1.0f/362880.0f;
+    p = p*y2 - 1.0f/5040.0f;
+    p = p*y2 + 1.0f/120.0f;
+    p = p*y2 - 1.0f/6.0f;
+    p = p*y2 + 1.0f;
+    return y*p;
+}
+
+std::size_t nlerp(const float * D_PYGLM_RESTRICT q1, const float * D_PYGLM_RESTRICT q2, const float * D_PYGLM_RESTRICT t, float * D_PYGLM_RESTRICT out, std::size_t n)
+{
+    std::size_t nspecial = 0;
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        float x = q1[4*i+0] + (q2[4*i+0] - q1[4*i+0])*t[i];
+        float y = q1[4*i+1] + (q2[4*i+1] - q1[4*i+1])*t[i];
+        float z = q1[4*i+2] + (q2[4*i+2] - q1[4*i+2])*t[i];
+        float w = q1[4*i+3] + (q2[4*i+3] - q1[4*i+3])*t[i];
+        nspecial += normalize_or_keep(x, y, z, w);
+        out[4*i+0] = x;
+        out[4*i+1] = y;
+        out[4*i+2] = z;
+        out[4*i+3] = w;
+    }
+
+    return nspecial;
+}
+
+std::size_t slerp(const float * D_PYGLM_RESTRICT q1, const float * D_PYGLM_RESTRICT q2, const float * D_PYGLM_RESTRICT t, float * D_PYGLM_RESTRICT out, std::size_t n)
+{
+    const float eps = D_PYGLM_EPSILON;
+    std::size_t nspecial = 0;
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        float c = q1[4*i+0]*q2[4*i+0] + q1[4*i+1]*q2[4*i+1] + q1[4*i+2]*q2[4*i+2] + q1[4*i+3]*q2[4*i+3];
+        float theta = acos_poly(c);
+        float s = sin_poly(theta);
+
+        // Nearly the same quaternions get interpolated linearly. As theta is
+        // within [0, pi], s is never negative and the division always safe.
+        float linear = static_cast<float>(s < eps);
+        float one_over_s = (1.0f - linear) / (s + linear);
+        float w1 = linear*(1.0f - t[i]) + sin_poly((1.0f - t[i])*theta)*one_over_s;
+        float w2 = linear*t[i] + sin_poly(t[i]*theta)*one_over_s;
+
+        float x = q1[4*i+0]*w1 + q2[4*i+0]*w2;
+        float y = q1[4*i+1]*w1 + q2[4*i+1]*w2;
+        float z = q1[4*i+2]*w1 + q2[4*i+2]*w2;
+        float w = q1[4*i+3]*w1 + q2[4*i+3]*w2;
+        nspecial += normalize_or_keep(x, y, z, w);
+        out[4*i+0] = x;
+        out[4*i+1] = y;
+        out[4*i+2] = z;
+        out[4*i+3] = w;
+    }
+
+    return nspecial;
+}
+
+// v' = q v q*, which comes down to (w^2 - u.u) v + 2 (u.v) u + 2w (u x v),
+// u being x y z of q. Unlike the shorter v + 2w (u x v) + 2 u x (u x v), this
+// doesn't assume q to be of unit length, just like the quaternion products.
+inline void rotate3(float qx, float qy, float qz, float qw, float x, float y, float z, float& out_x, float& out_y, float& out_z)
+{
+    const float s = qw*qw - (qx*qx + qy*qy + qz*qz);
+    const float d = 2.0f*(qx*x + qy*y + qz*z);
+    const float w2 = 2.0f*qw;
+    out_x = s*x + d*qx + w2*(qy*z - qz*y);
+    out_y = s*y + d*qy + w2*(qz*x - qx*z);
+    out_z = s*z + d*qz + w2*(qx*y - qy*x);
+}
+
+// Rotates n vectors packed as x y z by the same quaternion q. As this is a
+// linear map, it's done by the 3x3 rotation matrix of q: only nine
+// multiply-adds per vector, and a loop the compiler vectorizes, which it
+// doesn't do with rotate3's dot and cross products. The input and output may
+// not alias.
+void rotate_one(const float *q, const float * D_PYGLM_RESTRICT in, float * D_PYGLM_RESTRICT out, std::size_t n)
+{
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    const float s = w*w - (x*x + y*y + z*z);
+    const float r0 = s + 2.0f*x*x,     r3 = 2.0f*(x*y - w*z), r6 = 2.0f*(x*z + w*y);
+    const float r1 = 2.0f*(x*y + w*z), r4 = s + 2.0f*y*y,     r7 = 2.0f*(y*z - w*x);
+    const float r2 = 2.0f*(x*z - w*y), r5 = 2.0f*(y*z + w*x), r8 = s + 2.0f*z*z;
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        const float vx = in[3*i], vy = in[3*i+1], vz = in[3*i+2];
+        out[3*i]   = r0*vx + r3*vy + r6*vz;
+        out[3*i+1] = r1*vx + r4*vy + r7*vz;
+        out[3*i+2] = r2*vx + r5*vy + r8*vz;
+    }
+}
+
+// Rotates each of the n vectors packed as x y z by its own quaternion.
+void rotate_each(const float *q, const float * D_PYGLM_RESTRICT in, float * D_PYGLM_RESTRICT out, std::size_t n)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        rotate3(q[4*i], q[4*i+1], q[4*i+2], q[4*i+3], in[3*i], in[3*i+1], in[3*i+2], out[3*i], out[3*i+1], out[3*i+2]);
+    }
+}
+
+// Runs either kernel block by block, getting the input through a small
+// buffer when working in-place.
+template<bool Each>
+void rotate_any(const float *q, const float *in, float *out, std::size_t n)
+{
+    const std::size_t block = 256;
+    D_PYGLM_ALIGN(16) float tmp[3*block];
+
+    for(std::size_t first = 0 ; first < n ; first += block) {
+        const std::size_t count = std::min(block, n - first);
+        const float *src = in + 3*first;
+        if(in == out) {
+            std::memcpy(tmp, src, 3*count*sizeof(float));
+            src = tmp;
+        }
+
+        if(Each) {
+            rotate_each(q + 4*first, src, out + 3*first, count);
+        } else {
+            rotate_one(q, src, out + 3*first, count);
+        }
+    }
+}
+
+typedef std::size_t (*interpolation_kernel)(const float *, const float *, const float *, float *, std::size_t);
+
+// Runs the kernel block by block, getting the input it's overwriting through
+// a small buffer when working in-place, and fixes up what it left over.
+void interpolate_any(interpolation_kernel kernel, const float *q1, const float *q2, const float *t, float *out, std::size_t n)
+{
+    const std::size_t block = 256;
+    D_PYGLM_ALIGN(16) float tmp[4*block];
+
+    std::size_t nspecial = 0;
+    for(std::size_t first = 0 ; first < n ; first += block) {
+        const std::size_t count = std::min(block, n - first);
+        const float *src1 = q1 + 4*first;
+        const float *src2 = q2 + 4*first;
+        if(q1 == out || q2 == out) {
+            std::memcpy(tmp, out + 4*first, 4*count*sizeof(float));
+            src1 = q1 == out ? tmp : src1;
+            src2 = q2 == out ? tmp : src2;
+        }
+
+        nspecial += kernel(src1, src2, t + first, out + 4*first, count);
+    }
+
+    // The few quaternions left over by the vectorized pass get handled one by one.
+    for(std::size_t i = 0 ; nspecial > 0 && i < n ; ++i) {
+        PyGlMath::Quaternion q(out[4*i+0], out[4*i+1], out[4*i+2], out[4*i+3]);
+        if(q.len() < D_PYGLM_EPSILON
+        || (PyGlMath::nearZero(q.x()) && PyGlMath::nearZero(q.y()) && PyGlMath::nearZero(q.z()) && PyGlMath::nearZero(q.w()))) {
+            std::memcpy(out + 4*i, q.normalize().array4f(), 4*sizeof(float));
+            --nspecial;
+        }
+    }
+}
+
+// Rotating a vector takes a few nanoseconds, interpolating a pair of
+// quaternions a few more. A chunk of work for another thread needs many of
+// them to be worth waking it up.
+const std::size_t rotate_grain = 8192;
+const std::size_t interpolate_grain = 4096;
+
+struct RotateTask {
+    const float *q;
+    const float *in;
+    float *out;
+};
+
+// Rotates the vectors from begin up to end, for the thread pool.
+template<bool Each>
+void rotate_range(void *data, std::size_t begin, std::size_t end)
+{
+    const RotateTask& t = *static_cast<const RotateTask*>(data);
+    rotate_any<Each>(Each ? t.q + 4*begin : t.q, t.in + 3*begin, t.out + 3*begin, end - begin);
+}
+
+struct InterpolateTask {
+    interpolation_kernel kernel;
+    const float *q1;
+    const float *q2;
+    const float *t;
+    float *out;
+};
+
+// Interpolates the pairs from begin up to end, for the thread pool.
+void interpolate_range(void *data, std::size_t begin, std::size_t end)
+{
+    const InterpolateTask& t = *static_cast<const InterpolateTask*>(data);
+    interpolate_any(t.kernel, t.q1 + 4*begin, t.q2 + 4*begin, t.t + begin, t.out + 4*begin, end - begin);
+}
+
+}
 
 namespace PyGlMath {
 
@@ -36,7 +288,6 @@ namespace PyGlMath {
 ////////////////////////////////////////////
 
 Quaternion::Quaternion()
-    : m_q(4)
 {
     m_q[0] = 0.0f;
     m_q[1] = 0.0f;
@@ -45,7 +296,6 @@ Quaternion::Quaternion()
 }
 
 Quaternion::Quaternion(float in_v[4])
-    : m_q(4)
 {
     m_q[0] = in_v[0];
     m_q[1] = in_v[1];
@@ -53,27 +303,7 @@ Quaternion::Quaternion(float in_v[4])
     m_q[3] = in_v[3];
 }
 
-Quaternion::Quaternion(const Quaternion& in_q)
-    : m_q(4)
-{
-    m_q[0] = in_q.x();
-    m_q[1] = in_q.y();
-    m_q[2] = in_q.z();
-    m_q[3] = in_q.w();
-}
-
-const Quaternion& Quaternion::operator=(const Quaternion& in_q)
-{
-    m_q[0] = in_q.x();
-    m_q[1] = in_q.y();
-    m_q[2] = in_q.z();
-    m_q[3] = in_q.w();
-
-    return *this;
-}
-
 Quaternion::Quaternion(float in_fX, float in_fY, float in_fZ, float in_fW)
-    : m_q(4)
 {
     m_q[0] = in_fX;
     m_q[1] = in_fY;
@@ -81,20 +311,14 @@ Quaternion::Quaternion(float in_fX, float in_fY, float in_fZ, float in_fW)
     m_q[3] = in_fW;
 }
 
-#ifdef BOUGE_COMPILE_CPP0X
-Quaternion::Quaternion(Quaternion&& in_q)
-    : m_q(std::move(in_q.m_q))
-{ }
-
-const Quaternion& Quaternion::operator=(Quaternion&& in_q)
+Quaternion::Quaternion(const std::vector<float>& in_q)
 {
-    m_q = std::move(in_q.m_q);
-    return *this;
+    m_q[0] = m_q[1] = m_q[2] = 0.0f;
+    m_q[3] = 1.0f;
+    for(std::vector<float>::size_type i = 0 ; i < 4 && i < in_q.size() ; ++i) {
+        m_q[i] = in_q.at(i);
+    }
 }
-#endif // BOUGE_COMPILE_CPP0X
-
-Quaternion::~Quaternion()
-{ }
 
 //////////////////////////////////////
 // Special Quaternion constructors. //
@@ -369,6 +593,22 @@ Quaternion Quaternion::slerp(const Quaternion& q2, float between) const
     return ((*this)*w1 + q2*w2).normalize();
 }
 
+////////////////////////////
+// Batched interpolation. //
+////////////////////////////
+
+void Quaternion::nlerp(const float *in_q1, const float *in_q2, const float *in_t, float *out_q, std::size_t in_n)
+{
+    InterpolateTask task = {&::nlerp, in_q1, in_q2, in_t, out_q};
+    ThreadPool::instance().parallelFor(in_n, interpolate_grain, &interpolate_range, &task);
+}
+
+void Quaternion::slerp(const float *in_q1, const float *in_q2, const float *in_t, float *out_q, std::size_t in_n)
+{
+    InterpolateTask task = {&::slerp, in_q1, in_q2, in_t, out_q};
+    ThreadPool::instance().parallelFor(in_n, interpolate_grain, &interpolate_range, &task);
+}
+
 ///////////////////////////////////////
 // Quaternion comparison operations. //
 ///////////////////////////////////////
@@ -384,9 +624,21 @@ bool Quaternion::operator ==(const Quaternion &in_q) const
 
 Vector Quaternion::rotate(const Vector& in_v) const
 {
-    Quaternion vOrig = Quaternion(in_v.x(), in_v.y(), in_v.z(), 0.0f);
-    Quaternion vRotated = *this * vOrig * this->cnj();
-    return Vector(vRotated.x(), vRotated.y(), vRotated.z());
+    float x, y, z;
+    rotate3(m_q[0], m_q[1], m_q[2], m_q[3], in_v.x(), in_v.y(), in_v.z(), x, y, z);
+    return Vector(x, y, z);
+}
+
+void Quaternion::rotate(const float *in_v, float *out_v, std::size_t in_n) const
+{
+    RotateTask task = {m_q, in_v, out_v};
+    ThreadPool::instance().parallelFor(in_n, rotate_grain, &rotate_range<false>, &task);
+}
+
+void Quaternion::rotate(const float *in_q, const float *in_v, float *out_v, std::size_t in_n)
+{
+    RotateTask task = {in_q, in_v, out_v};
+    ThreadPool::instance().parallelFor(in_n, rotate_grain, &rotate_range<true>, &task);
 }
 
 } // namespace PyGlMath
@@ -24,6 +24,9 @@
 #ifndef PYGLM_QUATERNION_H
 #define PYGLM_QUATERNION_H
 
+#include "Util.hpp"
+
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -55,23 +58,9 @@ public:
     /// \param in_end An iterator pointing to one element past the last we can use.
     template<class FloatIterator>
     Quaternion(FloatIterator in_begin, const FloatIterator& in_end);
-    /// Copies a quaternion.
-    /// \param in_q The quaternion to be copied.
-    Quaternion(const Quaternion& in_q);
-    /// Copies a quaternion.
-    /// \param in_q The quaternion to be copied.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const Quaternion& operator=(const Quaternion& in_q);
-#ifdef BOUGE_COMPILE_CPP0X
-    /// Moves a quaternion.
-    /// \param in_q The quaternion to be moved.
-    Quaternion(Quaternion&& in_q);
-    /// Moves a quaternion.
-    /// \param in_q The quaternion to be moved.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const Quaternion& operator=(Quaternion&& in_q);
-#endif // BOUGE_COMPILE_CPP0X
-    ~Quaternion();
+
+    // Copying, assignment and destruction are left to the compiler: the data
+    // lives inline, so a quaternion is trivially copyable and never allocates.
 
     //////////////////////////////////////
     // Special Quaternion constructors. //
@@ -98,6 +87,9 @@ public:
     /// \return A read-only array of four floats holding the values of the
     ///         four components of this quaternion.
     inline const float *array4f() const {return &m_q[0];};
+    /// \return A writable array of four floats holding the values of the
+    ///         four components of this quaternion.
+    inline float *array4f() {return &m_q[0];};
 
     /// \return A string-representation of the quaternion.
     /// \param in_iDecimalPlaces The amount of numbers to print behind the dot.
@@ -245,6 +237,40 @@ public:
     ///       http://number-none.com/product/Understanding%20Slerp,%20Then%20Not%20Using%20It/
     Quaternion slerp(const Quaternion& v2, float between) const;
 
+    ////////////////////////////
+    // Batched interpolation. //
+    ////////////////////////////
+
+    /// Does the nlerp of \a in_n pairs of quaternions, each at its own time,
+    /// in one go. This is what animation samplers want, with the keyframes
+    /// before and after each bone's current time packed together.
+    /// \param in_q1 The first quaternion of every pair, packed as x y z w.
+    /// \param in_q2 The second quaternion of every pair, packed as x y z w.
+    /// \param in_t The time of interpolation of every pair.
+    /// \param out_q Where to write the \a in_n resulting quaternions. This may
+    ///              be \a in_q1 or \a in_q2, but no other overlap is allowed.
+    /// \param in_n The amount of pairs.
+    /// \note The results are the same as those of nlerp, up to rounding.
+    /// \note Like all batched operations of this class, large batches are
+    ///       split over the ThreadPool.
+    static void nlerp(const float *in_q1, const float *in_q2, const float *in_t, float *out_q, std::size_t in_n);
+
+    /// Does the slerp of \a in_n pairs of quaternions, each at its own time,
+    /// in one go. Instead of calling acos and sin, this uses polynomials which
+    /// the compiler can turn into SIMD code.
+    /// \param in_q1 The first quaternion of every pair, packed as x y z w.
+    /// \param in_q2 The second quaternion of every pair, packed as x y z w.
+    /// \param in_t The time of interpolation of every pair.
+    /// \param out_q Where to write the \a in_n resulting quaternions. This may
+    ///              be \a in_q1 or \a in_q2, but no other overlap is allowed.
+    /// \param in_n The amount of pairs.
+    /// \note For unit quaternions and times in [0, 1], every component is
+    ///       within 1e-6 of the one slerp computes as long as the dot product
+    ///       of the pair is above -0.9, and within 5e-6 above -0.99. Nearly
+    ///       opposite quaternions make slerp ill-conditioned, there both drift
+    ///       apart further. Times outside of [-0.5, 1.5] lose accuracy quickly.
+    static void slerp(const float *in_q1, const float *in_q2, const float *in_t, float *out_q, std::size_t in_n);
+
     ///////////////////////////////////////
     // Quaternion comparison operations. //
     ///////////////////////////////////////
@@ -269,12 +295,30 @@ public:
     /// Rotates a vector by this quaternion.
     /// \param in_v The vector to rotate.
     /// \return A new vector that is the result of having rotated the given
-    ///         vector by this quaternion. (ret = this * in_v * this.inv)
+    ///         vector by this quaternion. (ret = this * in_v * this.cnj)
+    /// \note This doesn't go through the quaternion products, but through
+    ///       the dot and cross products they come down to.
     Vector rotate(const Vector& in_v) const;
+    /// Rotates many vectors by this quaternion at once.
+    /// \param in_v The vectors to rotate, packed as x y z.
+    /// \param out_v Where to write the \a in_n rotated vectors. This may be
+    ///              \a in_v for rotating in-place, but no other overlap is allowed.
+    /// \param in_n The amount of vectors.
+    /// \note The results are the same as those of rotate, up to rounding.
+    void rotate(const float *in_v, float *out_v, std::size_t in_n) const;
+    /// Rotates every vector by its own quaternion, \a in_n pairs in one go.
+    /// This is what skeletons want, with the offset of each bone rotated by
+    /// the rotation of its parent.
+    /// \param in_q The quaternion of every pair, packed as x y z w.
+    /// \param in_v The vector of every pair, packed as x y z.
+    /// \param out_v Where to write the \a in_n rotated vectors. This may be
+    ///              \a in_v, but no other overlap is allowed.
+    /// \param in_n The amount of pairs.
+    static void rotate(const float *in_q, const float *in_v, float *out_v, std::size_t in_n);
 
 private:
     /// The four components of the quaternion.
-    std::vector<float> m_q;
+    D_PYGLM_ALIGN(16) float m_q[4];
 };
 
 #include "Quaternion.inl"
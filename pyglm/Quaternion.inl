@@ -50,8 +50,9 @@ T& operator>>(T& f, Quaternion& v) {
 
 template<class FloatIterator>
 Quaternion::Quaternion(FloatIterator in_begin, const FloatIterator& in_end)
-    : m_q(4)
 {
+    m_q[0] = m_q[1] = m_q[2] = m_q[3] = 0.0f;
+
     FloatIterator iter = in_begin;
     for(int i = 0 ; i < 4 && iter != in_end ; ++i, ++iter) {
         m_q[i] = *iter;
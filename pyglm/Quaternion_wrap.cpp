@@ -1,6 +1,135 @@
 #include "Quaternion_wrap.hpp"
 #include "Vector_wrap.hpp"
 #include "Util.hpp"
+#include "Util_wrap.hpp"
+#include "Swizzle_wrap.hpp"
+
+#include <vector>
+
+namespace {
+
+// The common part of Quaternion.nlerp and slerp.
+Py::Object interpolate(const PyGlMath::Quaternion& q, const Py::Tuple& args, const Py::Dict& kwargs, bool spherical, const char* name)
+{
+    if(args.length() + kwargs.length() != 2) {
+        throw Py::ValueError(std::string("Quaternion.") + name + " takes two arguments: first ('other') another quaternion and second ('between') a number.");
+    }
+
+    Py::Object other_arg = argument(args, kwargs, 0, "other");
+    if(!Quaternion::check(other_arg)) {
+        throw Py::TypeError(std::string("Quaternion.") + name + " takes a Quaternion as first argument ('other').");
+    }
+    Quaternion::QuaternionObject other(other_arg);
+
+    float between;
+    try {
+        between = Py::Float(argument(args, kwargs, 1, "between"));
+    } catch(const Py::Exception& ) {
+        throw Py::TypeError(std::string("The second argument to Quaternion.") + name + " ('between') needs to be a numeric value.");
+    }
+
+    const PyGlMath::Quaternion& q2 = other.getCxxObject()->m_quat;
+    return Quaternion::make_inst(spherical ? q.slerp(q2, between) : q.nlerp(q2, between));
+}
+
+// The common part of the nlerp and slerp module functions, which work on
+// whole buffers of quaternions.
+Py::Object interpolate_buffers(const Py::Tuple& args, const Py::Dict& kwargs, bool spherical, const char* name)
+{
+    if(args.length() + kwargs.length() < 3 || args.length() + kwargs.length() > 4) {
+        throw Py::TypeError(std::string(name) + " takes two buffers of quaternions (x y z w ...), a buffer of as many times and optionally an 'out' buffer.");
+    }
+
+    static const char* const keys[] = {"q1", "q2", "between", "out", NULL};
+    check_keywords(args, kwargs, keys, name);
+
+    FloatBufferArg q1(argument(args, kwargs, 0, "q1"), false, "q1");
+    FloatBufferArg q2(argument(args, kwargs, 1, "q2"), false, "q2");
+    FloatBufferArg t(argument(args, kwargs, 2, "between"), false, "between");
+    if(q1.group(4) != 4 || q1.size() % 4 != 0) {
+        throw Py::ValueError(std::string(name) + " needs groups of four floats (x y z w ...).");
+    }
+    const std::size_t n = q1.size() / 4;
+    if(q2.size() != q1.size() || q2.group(4) != 4 || t.size() != n) {
+        throw Py::ValueError(std::string(name) + " needs as many quaternions in both buffers as there are times.");
+    }
+
+    typedef void (*interpolation)(const float *, const float *, const float *, float *, std::size_t);
+    interpolation interpolate = &PyGlMath::Quaternion::nlerp;
+    if(spherical) {
+        interpolate = &PyGlMath::Quaternion::slerp;
+    }
+
+    Py::Object out_arg = argument(args, kwargs, 3, "out");
+    if(out_arg.isNone()) {
+        std::vector<float> out;
+        resize_or_raise(out, q1.size());
+        {
+            AllowThreads nogil(q1.size());
+            interpolate(q1.data(), q2.data(), t.data(), out.empty() ? 0 : &out[0], n);
+        }
+        return float_array(out.empty() ? 0 : &out[0], out.size());
+    }
+
+    FloatBufferArg out(out_arg, true, "out");
+    if(out.size() != q1.size() || out.group(4) != 4) {
+        throw Py::ValueError(std::string("The output of ") + name + " needs to be of the same size and shape as the quaternion buffers.");
+    }
+
+    {
+        AllowThreads nogil(q1.size());
+        interpolate(q1.data(), q2.data(), t.data(), out.data(), n);
+    }
+    return out_arg;
+}
+
+// Checks a buffer holds vectors packed as x y z, results in how many.
+std::size_t vector_count(const FloatBufferArg& v, const char* name)
+{
+    if(v.group(3) != 3 || v.size() % 3 != 0) {
+        throw Py::ValueError(std::string(name) + " needs groups of three floats (x y z ...).");
+    }
+    return v.size() / 3;
+}
+
+// The common part of Quaternion.rotateVectors and the rotate module function:
+// rotates the vectors by q, or by each of the quaternions qs if q is NULL.
+// Large batches are rotated without the GIL, hence by a copy of q.
+Py::Object rotate_buffers(const PyGlMath::Quaternion* q, const float* qs, const FloatBufferArg& v, const Py::Object& out_arg, const char* name)
+{
+    const PyGlMath::Quaternion copy = q ? *q : PyGlMath::Quaternion();
+    const std::size_t n = v.size() / 3;
+    if(out_arg.isNone()) {
+        std::vector<float> out;
+        resize_or_raise(out, v.size());
+        {
+            AllowThreads nogil(v.size());
+            if(q) {
+                copy.rotate(v.data(), out.empty() ? 0 : &out[0], n);
+            } else {
+                PyGlMath::Quaternion::rotate(qs, v.data(), out.empty() ? 0 : &out[0], n);
+            }
+        }
+        return float_array(out.empty() ? 0 : &out[0], out.size());
+    }
+
+    FloatBufferArg out(out_arg, true, "out");
+    if(out.size() != v.size() || out.group(3) != 3) {
+        throw Py::ValueError(std::string("The output of ") + name + " needs to be of the same size and shape as the vector buffer.");
+    }
+
+    {
+        AllowThreads nogil(v.size());
+        if(q) {
+            copy.rotate(v.data(), out.data(), n);
+        } else {
+            PyGlMath::Quaternion::rotate(qs, v.data(), out.data(), n);
+        }
+    }
+    return out_arg;
+}
+
+}
 
 Quaternion::Quaternion(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
     : Py::PythonClass<Quaternion>::PythonClass(self, args, kwds)
@@ -73,93 +202,162 @@ Quaternion::Quaternion(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict
     }
 }
 
+Quaternion::Quaternion(Py::PythonClassInstance *self, const PyGlMath::Quaternion& q)
+    : Py::PythonClass<Quaternion>::PythonClass(self, no_args(), no_kwds())
+    , m_quat(q)
+{ }
+
 Quaternion::QuaternionObject Quaternion::make_inst(const PyGlMath::Quaternion& v)
 {
-    Py::Callable type(Quaternion::type());
-    return QuaternionObject(type.apply( Py::TupleN(Py::Float(v.x()), Py::Float(v.y()), Py::Float(v.z()), Py::Float(v.w())), Py::Dict() ));
+    return make_recycled_inst<Quaternion>(v);
+}
+
+PyGlMath::Quaternion quaternion_from(const Py::Object& o, const char* errmsg)
+{
+    if(Quaternion::check(o)) {
+        return cxx_object<Quaternion>(o.ptr())->m_quat;
+    } else if(o.isSequence() && Py::Sequence(o).length() == 4) {
+        Py::Sequence s(o);
+        return PyGlMath::Quaternion(Py::Float(s[0]), Py::Float(s[1]), Py::Float(s[2]), Py::Float(s[3]));
+    }
+
+    throw Py::TypeError(errmsg);
 }
 
 Quaternion::~Quaternion()
 { }
 
+namespace {
+
+// The rotation the quaternion represents, as attributes. The Py::Exception
+// thrown on errors already set the Python exception, returning is enough.
+
+PyObject* get_angle(PyObject* self, void*)
+{
+    return PyFloat_FromDouble(cxx_object<Quaternion>(self)->m_quat.angle());
+}
+
+PyObject* get_degrees(PyObject* self, void*)
+{
+    return PyFloat_FromDouble(cxx_object<Quaternion>(self)->m_quat.angle()*PyGlMath::rad2deg);
+}
+
+PyObject* get_axis(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Vector::make_inst(cxx_object<Quaternion>(self)->m_quat.axis()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+// Shared by the setters, refusing to delete the attribute.
+bool check_set(PyObject* self, PyObject* value)
+{
+    if(value == NULL) {
+        PyErr_Format(PyExc_AttributeError, "The attributes of %s can't be deleted.", Py_TYPE(self)->tp_name);
+        return false;
+    }
+    return true;
+}
+
+int set_angle(PyObject* self, PyObject* value, void*)
+{
+    double angle = 0.0;
+    if(!check_set(self, value) || !float_from(value, angle)) {
+        return -1;
+    }
+
+    PyGlMath::Quaternion& q = cxx_object<Quaternion>(self)->m_quat;
+    q = PyGlMath::Quaternion::rotation(q.axis(), static_cast<float>(angle));
+    return 0;
+}
+
+int set_degrees(PyObject* self, PyObject* value, void*)
+{
+    double angle = 0.0;
+    if(!check_set(self, value) || !float_from(value, angle)) {
+        return -1;
+    }
+
+    PyGlMath::Quaternion& q = cxx_object<Quaternion>(self)->m_quat;
+    q = PyGlMath::Quaternion::rotation(q.axis(), static_cast<float>(angle)*PyGlMath::deg2rad);
+    return 0;
+}
+
+int set_axis(PyObject* self, PyObject* value, void*)
+{
+    if(!check_set(self, value)) {
+        return -1;
+    }
+
+    try {
+        Py::Object axis_obj(value);
+        if(!Vector::check(axis_obj)) {
+            axis_obj = Py::Callable(Vector::type()).apply(Py::TupleN(axis_obj), Py::Dict());
+        }
+        const PyGlMath::Vector& axis = Vector::VectorObject(axis_obj).getCxxObject()->m_vec;
+
+        PyGlMath::Quaternion& q = cxx_object<Quaternion>(self)->m_quat;
+        q = PyGlMath::Quaternion::rotation(axis, q.angle());
+        return 0;
+    } catch(const Py::Exception&) {
+        return -1;
+    }
+}
+
+PyGetSetDef quaternion_getset[] = {
+    {"x", &get_float_attr<Quaternion>, &set_float_attr<Quaternion>, "The X component of the quaternion.", reinterpret_cast<void*>(0)},
+    {"y", &get_float_attr<Quaternion>, &set_float_attr<Quaternion>, "The Y component of the quaternion.", reinterpret_cast<void*>(1)},
+    {"z", &get_float_attr<Quaternion>, &set_float_attr<Quaternion>, "The Z component of the quaternion.", reinterpret_cast<void*>(2)},
+    {"w", &get_float_attr<Quaternion>, &set_float_attr<Quaternion>, "The W component of the quaternion.", reinterpret_cast<void*>(3)},
+    {"angle", &get_angle, &set_angle, "The angle of the rotation, in radians. Setting it keeps the axis.", NULL},
+    {"rad", &get_angle, &set_angle, "Same as angle.", NULL},
+    {"radians", &get_angle, &set_angle, "Same as angle.", NULL},
+    {"deg", &get_degrees, &set_degrees, "The angle of the rotation, in degrees. Setting it keeps the axis.", NULL},
+    {"degrees", &get_degrees, &set_degrees, "Same as deg.", NULL},
+    {"axis", &get_axis, &set_axis, "The axis of the rotation, as a Vector. Setting it, to a Vector or an iterable, keeps the angle.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+}
+
 void Quaternion::init_type()
 {
     behaviors().name("Quaternion");
     behaviors().doc("documentation for Quaternion class");
-    behaviors().supportGetattro();
-    behaviors().supportSetattro();
     behaviors().supportRichCompare();
     behaviors().supportRepr();
     behaviors().supportStr();
     behaviors().supportHash();
     behaviors().supportNumberType();
+    behaviors().type_object()->tp_as_number->nb_inplace_add = &number_inplace_handler<Quaternion, &Quaternion::number_inplace_add>;
+    behaviors().type_object()->tp_as_number->nb_inplace_subtract = &number_inplace_handler<Quaternion, &Quaternion::number_inplace_subtract>;
+    behaviors().type_object()->tp_as_number->nb_inplace_multiply = &number_inplace_handler<Quaternion, &Quaternion::number_inplace_multiply>;
+    behaviors().set_tp_dealloc(&FreeList<Quaternion>::dealloc);
+    support_float_buffer<Quaternion>(behaviors());
+    support_getset(behaviors(), swizzle_getset(quaternion_getset, 4, &get_swizzle<Quaternion>, &set_swizzle<Quaternion>));
 
     PYCXX_ADD_VARARGS_METHOD(dot, dot, "Dot product of this vector with another one. Results in a float." );
     PYCXX_ADD_NOARGS_METHOD(len, len, "Returns the length of the vector. (Not the dimensions.)");
     PYCXX_ADD_NOARGS_METHOD(normalize, normalize, "Normalizes (gives unit length to) the vector itself, returns nothing.");
     PYCXX_ADD_NOARGS_METHOD(normalized, normalized, "Returns a normalized (unit length) copy of this vector. Self remains unchanged.");
+    PYCXX_ADD_KEYWORDS_METHOD(nlerp, nlerp, "Returns the normalized linear interpolation between self and the first argument 'other' at the second argument 'between'. Fast, but not at constant speed.");
+    PYCXX_ADD_KEYWORDS_METHOD(slerp, slerp, "Returns the spherical linear interpolation between self and the first argument 'other' at the second argument 'between'. At constant speed, but slow.");
+    PYCXX_ADD_VARARGS_METHOD(rotate, rotate, "Returns the Vector given as argument rotated by this quaternion.");
+    PYCXX_ADD_KEYWORDS_METHOD(rotateVectors, rotateVectors, "Rotates all vectors of a buffer of floats (x y z ...) by this quaternion at once: rotateVectors(vectors, out=None). Writes to 'out', which may be 'vectors' itself, or returns an array.array if not given.");
 //     PYCXX_ADD_KEYWORDS_METHOD(lerp, lerp, "Returns a new vector which is the linear interpolation between self and the first argument 'other' at the second argument 'between'.");
 
     // Call to make the type ready for use
     behaviors().readyType();
 }
 
-Py::Object Quaternion::getattro(const Py::String& name_)
-{
-    std::string name(name_.as_std_string("utf-8"));
-
-    if(name == "x") {
-        return Py::Float(m_quat.x());
-    } else if(name == "y") {
-        return Py::Float(m_quat.y());
-    } else if(name == "z") {
-        return Py::Float(m_quat.z());
-    } else if(name == "w") {
-        return Py::Float(m_quat.w());
-    } else if(name == "angle" || name == "rad" || name == "radians") {
-        return Py::Float(m_quat.angle());
-    } else if(name == "deg" || name == "degrees") {
-        return Py::Float(m_quat.angle()*PyGlMath::rad2deg);
-    } else if(name == "axis") {
-        return Vector::make_inst(m_quat.axis());
-    }
-
-    // TODO: support swizzling?
-    return genericGetAttro(name_);
-}
-
-int Quaternion::setattro(const Py::String& name_, const Py::Object &value)
-{
-    std::string name(name_.as_std_string("utf-8"));
-
-    if(name == "x") {
-        m_quat.x(Py::Float(value));
-    } else if(name == "y") {
-        m_quat.y(Py::Float(value));
-    } else if(name == "z") {
-        m_quat.z(Py::Float(value));
-    } else if(name == "w") {
-        m_quat.w(Py::Float(value));
-    // TODO: support swizzling?
-    } else if(name == "axis") {
-        if(Vector::check(value)) {
-            Vector::VectorObject axis_obj(value);
-            const PyGlMath::Vector& axis = axis_obj.getCxxObject()->m_vec;
-            m_quat = PyGlMath::Quaternion::rotation(axis, m_quat.angle());
-        } else {
-            Vector::VectorObject axis_obj(Py::Callable(Vector::type()).apply(value, Py::Dict()));
-            const PyGlMath::Vector& axis = axis_obj.getCxxObject()->m_vec;
-            m_quat = PyGlMath::Quaternion::rotation(axis, m_quat.angle());
-        }
-    } else if(name == "angle" || name == "rad" || name == "radians") {
-        m_quat = PyGlMath::Quaternion::rotation(m_quat.axis(), Py::Float(value));
-    } else if(name == "deg" || name == "degrees") {
-        m_quat = PyGlMath::Quaternion::rotation(m_quat.axis(), float(Py::Float(value))*PyGlMath::deg2rad);
-    } else {
-        return genericSetAttro(name_, value);
-    }
-
-    return 0;
+FloatBuffer Quaternion::float_buffer()
+{
+    static Py_ssize_t shape[] = {4};
+    static Py_ssize_t strides[] = {sizeof(float)};
+    FloatBuffer b = {m_quat.array4f(), 1, shape, strides, &shape[0], false};
+    return b;
 }
 
 Py::Object Quaternion::repr()
@@ -255,6 +453,40 @@ Py::Object Quaternion::number_multiply(const Py::Object& other_)
     }
 }
 
+bool Quaternion::number_inplace_add(const Py::Object& other_)
+{
+    if(!Quaternion::check(other_)) {
+        return false;
+    }
+
+    m_quat += cxx_object<Quaternion>(other_.ptr())->m_quat;
+    return true;
+}
+
+bool Quaternion::number_inplace_subtract(const Py::Object& other_)
+{
+    if(!Quaternion::check(other_)) {
+        return false;
+    }
+
+    m_quat -= cxx_object<Quaternion>(other_.ptr())->m_quat;
+    return true;
+}
+
+bool Quaternion::number_inplace_multiply(const Py::Object& other_)
+{
+    float f = 0.0f;
+    if(Quaternion::check(other_)) {
+        m_quat *= cxx_object<Quaternion>(other_.ptr())->m_quat;
+        return true;
+    } else if(plain_number(other_, f)) {
+        m_quat *= f;
+        return true;
+    }
+
+    return false;
+}
+
 Py::Object Quaternion::dot(const Py::Tuple &args)
 {
     if(args.length() != 1) {
@@ -287,6 +519,71 @@ Py::Object Quaternion::normalized()
     return make_inst(m_quat.normalized());
 }
 
+Py::Object Quaternion::nlerp(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return interpolate(m_quat, args, kwargs, false, "nlerp");
+}
+
+Py::Object Quaternion::slerp(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return interpolate(m_quat, args, kwargs, true, "slerp");
+}
+
+Py::Object Quaternion::rotate(const Py::Tuple& args)
+{
+    if(args.length() != 1 || !Vector::check(args[0])) {
+        throw Py::TypeError("Quaternion.rotate takes a Vector. Use rotateVectors for buffers of vectors.");
+    }
+
+    Vector::VectorObject v(args[0]);
+    return Vector::make_inst(m_quat.rotate(v.getCxxObject()->m_vec));
+}
+
+Py::Object Quaternion::rotateVectors(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() < 1 || args.length() + kwargs.length() > 2) {
+        throw Py::TypeError("Quaternion.rotateVectors takes a buffer of vectors (x y z ...) and optionally an 'out' buffer of the same size.");
+    }
+
+    static const char* const keys[] = {"vectors", "out", NULL};
+    check_keywords(args, kwargs, keys, "Quaternion.rotateVectors");
+
+    FloatBufferArg v(argument(args, kwargs, 0, "vectors"), false, "vectors");
+    vector_count(v, "Quaternion.rotateVectors");
+    return rotate_buffers(&m_quat, 0, v, argument(args, kwargs, 1, "out"), "Quaternion.rotateVectors");
+}
+
+Py::Object Quaternion::rotateBuffers(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() < 2 || args.length() + kwargs.length() > 3) {
+        throw Py::TypeError("rotate takes a buffer of quaternions (x y z w ...), a buffer of as many vectors (x y z ...) and optionally an 'out' buffer.");
+    }
+
+    static const char* const keys[] = {"q", "v", "out", NULL};
+    check_keywords(args, kwargs, keys, "rotate");
+
+    FloatBufferArg q(argument(args, kwargs, 0, "q"), false, "q");
+    FloatBufferArg v(argument(args, kwargs, 1, "v"), false, "v");
+    if(q.group(4) != 4 || q.size() % 4 != 0) {
+        throw Py::ValueError("rotate needs groups of four floats (x y z w ...) for the quaternions.");
+    }
+    if(vector_count(v, "rotate") != q.size() / 4) {
+        throw Py::ValueError("rotate needs as many quaternions as there are vectors.");
+    }
+
+    return rotate_buffers(0, q.data(), v, argument(args, kwargs, 2, "out"), "rotate");
+}
+
+Py::Object Quaternion::nlerpBuffers(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return interpolate_buffers(args, kwargs, false, "nlerp");
+}
+
+Py::Object Quaternion::slerpBuffers(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    return interpolate_buffers(args, kwargs, true, "slerp");
+}
+
 // Py::Object Quaternion::lerp(const Py::Tuple& args, const Py::Dict& kwargs)
 // {
 //     if(args.length() + kwargs.length() != 2) {
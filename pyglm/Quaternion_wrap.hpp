@@ -3,10 +3,14 @@
 #include "CXX/Objects.hxx"
 #include "CXX/Extensions.hxx"
 
+#include "Util_wrap.hpp"
+
 class Quaternion : public Py::PythonClass<Quaternion>
 {
 public:
     Quaternion(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing quaternion without parsing arguments.
+    Quaternion(Py::PythonClassInstance *self, const PyGlMath::Quaternion& q);
     virtual ~Quaternion();
 
     static void init_type();
@@ -14,10 +18,16 @@ public:
     typedef Py::PythonClassObject<Quaternion> QuaternionObject;
     static QuaternionObject make_inst(const PyGlMath::Quaternion& v);
 
-private:
-    Py::Object getattro(const Py::String& name_);
-    int setattro(const Py::String& name_, const Py::Object &value);
+    static Py::Object nlerpBuffers(const Py::Tuple& args, const Py::Dict& kwargs);
+    static Py::Object slerpBuffers(const Py::Tuple& args, const Py::Dict& kwargs);
+    static Py::Object rotateBuffers(const Py::Tuple& args, const Py::Dict& kwargs);
+
+    PyGlMath::Quaternion m_quat;
 
+    /// Used by the buffer protocol, \see get_float_buffer.
+    FloatBuffer float_buffer();
+
+private:
     Py::Object repr();
     Py::Object str();
     long hash();
@@ -29,6 +39,9 @@ private:
     Py::Object number_add(const Py::Object& other_);
     Py::Object number_subtract(const Py::Object& other_);
     Py::Object number_multiply(const Py::Object& other_);
+    bool number_inplace_add(const Py::Object& other_);
+    bool number_inplace_subtract(const Py::Object& other_);
+    bool number_inplace_multiply(const Py::Object& other_);
 
     Py::Object dot(const Py::Tuple &args);
     PYCXX_VARARGS_METHOD_DECL(Quaternion, dot);
@@ -38,8 +51,14 @@ private:
     PYCXX_NOARGS_METHOD_DECL(Quaternion, normalize);
     Py::Object normalized();
     PYCXX_NOARGS_METHOD_DECL(Quaternion, normalized);
+    Py::Object nlerp(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(Quaternion, nlerp);
+    Py::Object slerp(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(Quaternion, slerp);
+    Py::Object rotate(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(Quaternion, rotate);
+    Py::Object rotateVectors(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(Quaternion, rotateVectors);
 //     Py::Object lerp(const Py::Tuple& args, const Py::Dict& kwargs);
 //     PYCXX_KEYWORDS_METHOD_DECL(Quaternion, lerp);
-
-    PyGlMath::Quaternion m_quat;
 };
@@ -0,0 +1,341 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "Skinning.hpp"
+#include "DualQuaternion.hpp"
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+#include "Util.hpp"
+
+#include <cmath>
+#include <vector>
+
+#if defined(D_PYGLM_SSE)
+#  include <xmmintrin.h>
+#endif
+
+namespace {
+
+// The floats per bone of a packed palette: the four columns of its matrix
+// and then the three columns of the inverse transpose of its 3x3 part, which
+// is what transforms the normals. Each column has a fourth float of padding
+// (0) so that it fills a whole SIMD register.
+const std::size_t bone_floats = 28;
+
+void pack_palette(const PyGlMath::AffineMatrix *palette, std::size_t n, float *out)
+{
+    for(std::size_t b = 0 ; b < n ; ++b, out += bone_floats) {
+        const float *m = palette[b].array16f();
+        for(int i = 0 ; i < 16 ; ++i) {
+            out[i] = (i % 4 == 3) ? 0.0f : m[i];
+        }
+
+        // Row r of the inverse is column r of the inverse transpose.
+        const float *im3 = palette[b].array9fInverse();
+        for(int c = 0 ; c < 3 ; ++c) {
+            out[16 + 4*c + 0] = im3[c];
+            out[16 + 4*c + 1] = im3[3 + c];
+            out[16 + 4*c + 2] = im3[6 + c];
+            out[16 + 4*c + 3] = 0.0f;
+        }
+    }
+}
+
+// Normalizes the three floats at v, leaving them alone if they're all 0.
+inline void normalize3(float *v)
+{
+    const float l = v[0]*v[0] + v[1]*v[1] + v[2]*v[2];
+    if(l > 0.0f) {
+        const float f = 1.0f / std::sqrt(l);
+        v[0] *= f;
+        v[1] *= f;
+        v[2] *= f;
+    }
+}
+
+// Skins the vertices from begin up to end, as described by skinLinear. The
+// blended matrix of each vertex is built first, which is k multiply-adds of
+// whole columns, and then applied.
+void skin_linear(const float *palette, const unsigned int *bones, const float *weights, std::size_t k,
+                 const float *in_pos, float *out_pos, const float *in_nrm, float *out_nrm,
+                 std::size_t begin, std::size_t end)
+{
+    for(std::size_t i = begin ; i < end ; ++i) {
+        const unsigned int *b = bones + i*k;
+        const float *w = weights + i*k;
+        D_PYGLM_ALIGN(16) float p[4];
+        D_PYGLM_ALIGN(16) float n[4];
+
+#if defined(D_PYGLM_SSE)
+        __m128 c0 = _mm_setzero_ps(), c1 = c0, c2 = c0, c3 = c0;
+        __m128 n0 = c0, n1 = c0, n2 = c0;
+        for(std::size_t j = 0 ; j < k ; ++j) {
+            const float *m = palette + bone_floats*b[j];
+            const __m128 wj = _mm_set1_ps(w[j]);
+            c0 = _mm_add_ps(c0, _mm_mul_ps(wj, _mm_loadu_ps(m)));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(wj, _mm_loadu_ps(m+4)));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(wj, _mm_loadu_ps(m+8)));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(wj, _mm_loadu_ps(m+12)));
+            if(in_nrm) {
+                n0 = _mm_add_ps(n0, _mm_mul_ps(wj, _mm_loadu_ps(m+16)));
+                n1 = _mm_add_ps(n1, _mm_mul_ps(wj, _mm_loadu_ps(m+20)));
+                n2 = _mm_add_ps(n2, _mm_mul_ps(wj, _mm_loadu_ps(m+24)));
+            }
+        }
+
+        const float *v = in_pos + 3*i;
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])), _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+        r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(v[2])), c3));
+        _mm_store_ps(p, r);
+        if(in_nrm) {
+            const float *u = in_nrm + 3*i;
+            __m128 s = _mm_add_ps(_mm_mul_ps(n0, _mm_set1_ps(u[0])), _mm_mul_ps(n1, _mm_set1_ps(u[1])));
+            s = _mm_add_ps(s, _mm_mul_ps(n2, _mm_set1_ps(u[2])));
+            _mm_store_ps(n, s);
+        }
+#else
+        float c[28] = {0.0f};
+        for(std::size_t j = 0 ; j < k ; ++j) {
+            const float *m = palette + bone_floats*b[j];
+            const std::size_t floats = in_nrm ? 28 : 16;
+            for(std::size_t f = 0 ; f < floats ; ++f) {
+                c[f] += w[j]*m[f];
+            }
+        }
+
+        const float *v = in_pos + 3*i;
+        for(int f = 0 ; f < 3 ; ++f) {
+            p[f] = c[f]*v[0] + c[4+f]*v[1] + c[8+f]*v[2] + c[12+f];
+        }
+        if(in_nrm) {
+            const float *u = in_nrm + 3*i;
+            for(int f = 0 ; f < 3 ; ++f) {
+                n[f] = c[16+f]*u[0] + c[20+f]*u[1] + c[24+f]*u[2];
+            }
+        }
+#endif
+
+        out_pos[3*i+0] = p[0];
+        out_pos[3*i+1] = p[1];
+        out_pos[3*i+2] = p[2];
+        if(in_nrm) {
+            normalize3(n);
+            out_nrm[3*i+0] = n[0];
+            out_nrm[3*i+1] = n[1];
+            out_nrm[3*i+2] = n[2];
+        }
+    }
+}
+
+// The floats per bone of a packed dual quaternion palette: the real part
+// followed by the dual part, x y z w each.
+const std::size_t dq_floats = 8;
+
+void pack_dq_palette(const PyGlMath::DualQuaternion *palette, std::size_t n, float *out)
+{
+    for(std::size_t b = 0 ; b < n ; ++b, out += dq_floats) {
+        for(unsigned int i = 0 ; i < 4 ; ++i) {
+            out[i] = palette[b].real()[i];
+            out[4 + i] = palette[b].dual()[i];
+        }
+    }
+}
+
+#if defined(D_PYGLM_SSE)
+// The sum of the four components of x, in all four of them.
+inline __m128 hsum(__m128 x)
+{
+    x = _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// The cross product of the first three components of a and b.
+inline __m128 cross(__m128 a, __m128 b)
+{
+    return _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2))),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))));
+}
+#endif
+
+// Skins the vertices from begin up to end, as described by skinDualQuaternion.
+// Once blended and normalized, the real part r rotates and the dual part d
+// gives the translation 2 (rw dv - dw rv + rv x dv). Rotating v by r is
+// v + rw c + rv x c, where c is 2 rv x v.
+void skin_dual_quaternion(const float *palette, const unsigned int *bones, const float *weights, std::size_t k,
+                          const float *in_pos, float *out_pos, const float *in_nrm, float *out_nrm,
+                          std::size_t begin, std::size_t end)
+{
+    for(std::size_t i = begin ; i < end ; ++i) {
+        const unsigned int *b = bones + i*k;
+        const float *w = weights + i*k;
+        const float *v = in_pos + 3*i;
+        D_PYGLM_ALIGN(16) float p[4];
+        D_PYGLM_ALIGN(16) float n[4];
+
+        // Every bone is flipped to the side of the first one, so as to blend
+        // along the shortest way. That's the sign bit of the dot product of
+        // their real parts, which goes onto the weight without branching.
+        const float *pivot = palette + dq_floats*b[0];
+#if defined(D_PYGLM_SSE)
+        const __m128 first = _mm_loadu_ps(pivot);
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        __m128 r = _mm_setzero_ps(), d = r;
+        for(std::size_t j = 0 ; j < k ; ++j) {
+            const float *q = palette + dq_floats*b[j];
+            const __m128 qr = _mm_loadu_ps(q);
+            const __m128 wj = _mm_xor_ps(_mm_set1_ps(w[j]), _mm_and_ps(hsum(_mm_mul_ps(first, qr)), sign));
+            r = _mm_add_ps(r, _mm_mul_ps(wj, qr));
+            d = _mm_add_ps(d, _mm_mul_ps(wj, _mm_loadu_ps(q+4)));
+        }
+
+        const __m128 l2 = hsum(_mm_mul_ps(r, r));
+        const __m128 f = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(l2)), _mm_cmpgt_ps(l2, _mm_setzero_ps()));
+        r = _mm_mul_ps(r, f);
+        d = _mm_mul_ps(d, f);
+        const __m128 rw = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 dw = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 t = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(rw, d), cross(r, d)), _mm_mul_ps(dw, r));
+
+        const __m128 x = _mm_set_ps(0.0f, v[2], v[1], v[0]);
+        __m128 c = cross(r, x);
+        c = _mm_add_ps(c, c);
+        _mm_store_ps(p, _mm_add_ps(_mm_add_ps(x, _mm_add_ps(t, t)), _mm_add_ps(_mm_mul_ps(rw, c), cross(r, c))));
+        if(in_nrm) {
+            const float *u = in_nrm + 3*i;
+            const __m128 y = _mm_set_ps(0.0f, u[2], u[1], u[0]);
+            c = cross(r, y);
+            c = _mm_add_ps(c, c);
+            _mm_store_ps(n, _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(rw, c), cross(r, c))));
+        }
+#else
+        float r[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float d[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for(std::size_t j = 0 ; j < k ; ++j) {
+            const float *q = palette + dq_floats*b[j];
+            const float dot = q[0]*pivot[0] + q[1]*pivot[1] + q[2]*pivot[2] + q[3]*pivot[3];
+            const float wj = dot < 0.0f ? -w[j] : w[j];
+            for(int e = 0 ; e < 4 ; ++e) {
+                r[e] += wj*q[e];
+                d[e] += wj*q[4+e];
+            }
+        }
+
+        const float l2 = r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3];
+        const float f = l2 > 0.0f ? 1.0f / std::sqrt(l2) : 0.0f;
+        const float x = r[0]*f, y = r[1]*f, z = r[2]*f, rw = r[3]*f;
+        const float dx = d[0]*f, dy = d[1]*f, dz = d[2]*f, dw = d[3]*f;
+        const float tx = 2.0f*(rw*dx - dw*x + y*dz - z*dy);
+        const float ty = 2.0f*(rw*dy - dw*y + z*dx - x*dz);
+        const float tz = 2.0f*(rw*dz - dw*z + x*dy - y*dx);
+
+        float cx = 2.0f*(y*v[2] - z*v[1]), cy = 2.0f*(z*v[0] - x*v[2]), cz = 2.0f*(x*v[1] - y*v[0]);
+        p[0] = v[0] + rw*cx + (y*cz - z*cy) + tx;
+        p[1] = v[1] + rw*cy + (z*cx - x*cz) + ty;
+        p[2] = v[2] + rw*cz + (x*cy - y*cx) + tz;
+        if(in_nrm) {
+            const float *u = in_nrm + 3*i;
+            cx = 2.0f*(y*u[2] - z*u[1]);
+            cy = 2.0f*(z*u[0] - x*u[2]);
+            cz = 2.0f*(x*u[1] - y*u[0]);
+            n[0] = u[0] + rw*cx + (y*cz - z*cy);
+            n[1] = u[1] + rw*cy + (z*cx - x*cz);
+            n[2] = u[2] + rw*cz + (x*cy - y*cx);
+        }
+#endif
+
+        out_pos[3*i+0] = p[0];
+        out_pos[3*i+1] = p[1];
+        out_pos[3*i+2] = p[2];
+        if(in_nrm) {
+            out_nrm[3*i+0] = n[0];
+            out_nrm[3*i+1] = n[1];
+            out_nrm[3*i+2] = n[2];
+        }
+    }
+}
+
+// Skinning a vertex takes tens of nanoseconds, a chunk of work for another
+// thread still needs a thousand of them to be worth waking it up.
+const std::size_t skin_grain = 1024;
+
+struct SkinTask {
+    const float *palette;
+    const unsigned int *bones;
+    const float *weights;
+    std::size_t k;
+    const float *in_pos;
+    float *out_pos;
+    const float *in_nrm;
+    float *out_nrm;
+};
+
+// Skins the vertices from begin up to end, for the thread pool.
+void skin_linear_range(void *data, std::size_t begin, std::size_t end)
+{
+    const SkinTask& t = *static_cast<const SkinTask*>(data);
+    skin_linear(t.palette, t.bones, t.weights, t.k, t.in_pos, t.out_pos, t.in_nrm, t.out_nrm, begin, end);
+}
+
+// Skins the vertices from begin up to end, for the thread pool.
+void skin_dual_quaternion_range(void *data, std::size_t begin, std::size_t end)
+{
+    const SkinTask& t = *static_cast<const SkinTask*>(data);
+    skin_dual_quaternion(t.palette, t.bones, t.weights, t.k, t.in_pos, t.out_pos, t.in_nrm, t.out_nrm, begin, end);
+}
+
+}
+
+namespace PyGlMath {
+
+void skinLinear(const AffineMatrix *in_palette, std::size_t in_nBones,
+                const unsigned int *in_bones, const float *in_weights, std::size_t in_nInfluences,
+                const float *in_pos, float *out_pos, const float *in_nrm, float *out_nrm, std::size_t in_n)
+{
+    if(in_n == 0) {
+        return;
+    }
+
+    std::vector<float> palette(bone_floats*in_nBones);
+    pack_palette(in_palette, in_nBones, palette.empty() ? 0 : &palette[0]);
+    SkinTask task = {palette.empty() ? 0 : &palette[0], in_bones, in_weights, in_nInfluences,
+                     in_pos, out_pos, in_nrm, out_nrm};
+    ThreadPool::instance().parallelFor(in_n, skin_grain, &skin_linear_range, &task);
+}
+
+void skinDualQuaternion(const DualQuaternion *in_palette, std::size_t in_nBones,
+                        const unsigned int *in_bones, const float *in_weights, std::size_t in_nInfluences,
+                        const float *in_pos, float *out_pos, const float *in_nrm, float *out_nrm, std::size_t in_n)
+{
+    if(in_n == 0) {
+        return;
+    }
+
+    std::vector<float> palette(dq_floats*in_nBones);
+    pack_dq_palette(in_palette, in_nBones, palette.empty() ? 0 : &palette[0]);
+    SkinTask task = {palette.empty() ? 0 : &palette[0], in_bones, in_weights, in_nInfluences,
+                     in_pos, out_pos, in_nrm, out_nrm};
+    ThreadPool::instance().parallelFor(in_n, skin_grain, &skin_dual_quaternion_range, &task);
+}
+
+} // namespace PyGlMath
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_SKINNING_H
+#define PYGLM_SKINNING_H
+
+#include <cstddef>
+
+namespace PyGlMath {
+    class AffineMatrix;
+    class DualQuaternion;
+
+/// Linear blend skinning: moves every vertex of a mesh by the weighted sum of
+/// the matrices of the bones influencing it. Each vertex has the same amount
+/// of influences, a bone index and a weight each, which is how meshes are
+/// usually laid out for the GPU. Unused influences simply get a weight of 0.
+/// \param in_palette The matrices of all bones, usually the world matrix of
+///                   each bone times the inverse of its bind pose.
+/// \param in_bones The \a in_nInfluences bone indices of every vertex, all of
+///                 them indices into \a in_palette.
+/// \param in_weights The \a in_nInfluences weights of every vertex, which
+///                   should add up to 1.
+/// \param in_nInfluences The amount of influences per vertex.
+/// \param in_pos The positions of the vertices, packed as x y z.
+/// \param out_pos Where to write the skinned positions. This may be \a in_pos
+///                for skinning in-place, but no other overlap is allowed.
+/// \param in_nrm The normals of the vertices, packed as x y z, or NULL if
+///               there are none.
+/// \param out_nrm Where to write the skinned normals, which may be \a in_nrm.
+///                They are transformed by the inverse transpose of the blended
+///                matrices (array9fInverse read row-wise) and normalized.
+/// \param in_n The amount of vertices.
+/// \note The palette is repacked once per call, which is why a call should
+///       skin as many vertices as possible. Meshes of more than a thousand
+///       vertices or so are then skinned by all threads of the ThreadPool.
+void skinLinear(const AffineMatrix *in_palette, std::size_t in_nBones,
+                const unsigned int *in_bones, const float *in_weights, std::size_t in_nInfluences,
+                const float *in_pos, float *out_pos, const float *in_nrm, float *out_nrm, std::size_t in_n);
+
+/// Dual quaternion skinning: moves every vertex of a mesh by the blend (DLB)
+/// of the dual quaternions of the bones influencing it. Unlike skinLinear,
+/// this preserves the volume of the mesh around twisted and bent joints,
+/// at the cost of supporting rigid bones only: rotations and translations.
+/// All parameters are the same as those of skinLinear.
+/// \param in_palette The transformations of all bones, which need to be unit
+///                   dual quaternions.
+/// \note The normals are only rotated, as rigid transformations don't change
+///       their length.
+/// \note Each bone only takes 8 floats, instead of the 28 of skinLinear, which
+///       is less to go through for large palettes.
+void skinDualQuaternion(const DualQuaternion *in_palette, std::size_t in_nBones,
+                        const unsigned int *in_bones, const float *in_weights, std::size_t in_nInfluences,
+                        const float *in_pos, float *out_pos, const float *in_nrm, float *out_nrm, std::size_t in_n);
+
+} // namespace PyGlMath
+
+#endif // PYGLM_SKINNING_H
@@ -0,0 +1,140 @@
+#include "Skinning_wrap.hpp"
+#include "Matrix_wrap.hpp"
+#include "DualQuaternion_wrap.hpp"
+
+#include "Util_wrap.hpp"
+
+#include <vector>
+
+namespace {
+
+// Either borrows the 'out' buffer, checking it has \a n floats, or, if there
+// is none, hands out floats of its own.
+class OutArg {
+public:
+    OutArg(const Py::Object& obj, std::size_t n, const char* what)
+        : m_obj(obj)
+        , m_buf(0)
+    {
+        if(obj.isNone()) {
+            resize_or_raise(m_own, n);
+            return;
+        }
+
+        m_buf = new FloatBufferArg(obj, true, what);
+        bool fits = false;
+        try {
+            fits = m_buf->size() == n && m_buf->group(3) == 3;
+        } catch(...) {
+            delete m_buf;
+            throw;
+        }
+        if(!fits) {
+            delete m_buf;
+            throw Py::ValueError(std::string("The '") + what + "' of skin needs to be of the same size and shape as the input it's for.");
+        }
+    }
+
+    ~OutArg()
+    {
+        delete m_buf;
+    }
+
+    float* data() {return m_buf ? m_buf->data() : (m_own.empty() ? 0 : &m_own[0]);}
+    Py::Object result() {return m_buf ? m_obj : float_array(data(), m_own.size());}
+
+private:
+    OutArg(const OutArg&);
+    OutArg& operator=(const OutArg&);
+
+    Py::Object m_obj;
+    FloatBufferArg* m_buf;
+    std::vector<float> m_own;
+};
+
+// Skins by whichever of the palettes isn't empty, large meshes without the GIL.
+void skin_with(const std::vector<PyGlMath::AffineMatrix>& palette, const std::vector<PyGlMath::DualQuaternion>& dq_palette,
+               const IndexBufferArg& bones, const FloatBufferArg& weights, std::size_t k,
+               const float* pos, float* out_pos, const float* nrm, float* out_nrm, std::size_t n)
+{
+    AllowThreads nogil(weights.size() + 3*n);
+    if(!dq_palette.empty()) {
+        PyGlMath::skinDualQuaternion(&dq_palette[0], dq_palette.size(), bones.data(), weights.data(), k,
+                                     pos, out_pos, nrm, out_nrm, n);
+    } else {
+        PyGlMath::skinLinear(palette.empty() ? 0 : &palette[0], palette.size(), bones.data(), weights.data(), k,
+                             pos, out_pos, nrm, out_nrm, n);
+    }
+}
+
+}
+
+Py::Object skin(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() < 4 || args.length() > 7) {
+        throw Py::TypeError("skin takes a sequence of AffineMatrix or DualQuaternion bones, buffers of bone indices, weights and positions (x y z ...) and optionally buffers of normals, 'out' and 'outNormals'.");
+    }
+
+    static const char* const keys[] = {"palette", "bones", "weights", "positions", "normals", "out", "outNormals", NULL};
+    check_keywords(args, kwargs, keys, "skin");
+
+    // The palette is either all AffineMatrix, for linear blending, or all
+    // DualQuaternion, for dual quaternion blending.
+    Py::Object palette_arg = argument(args, kwargs, 0, "palette");
+    if(!palette_arg.isSequence()) {
+        throw Py::TypeError("skin takes a sequence of AffineMatrix or of DualQuaternion objects as palette.");
+    }
+    Py::Sequence palette_seq(palette_arg);
+    const bool dual = palette_seq.length() > 0 && DualQuaternion::check(palette_seq[0]);
+    std::vector<PyGlMath::AffineMatrix> palette;
+    std::vector<PyGlMath::DualQuaternion> dq_palette;
+    if(dual) {
+        reserve_or_raise(dq_palette, palette_seq.length());
+    } else {
+        reserve_or_raise(palette, palette_seq.length());
+    }
+    for(Py::Sequence::size_type i = 0 ; i < palette_seq.length() ; ++i) {
+        Py::Object m = palette_seq[i];
+        if(dual && DualQuaternion::check(m)) {
+            dq_palette.push_back(cxx_object<DualQuaternion>(m.ptr())->m_dq);
+        } else if(!dual && AffineMatrix::check(m)) {
+            palette.push_back(cxx_object<AffineMatrix>(m.ptr())->m_mat);
+        } else {
+            throw Py::TypeError("skin takes a sequence of AffineMatrix or of DualQuaternion objects as palette, not a mix of them.");
+        }
+    }
+    const std::size_t nbones = palette_seq.length();
+
+    IndexBufferArg bones(argument(args, kwargs, 1, "bones"), nbones, "bones");
+    FloatBufferArg weights(argument(args, kwargs, 2, "weights"), false, "weights");
+    FloatBufferArg pos(argument(args, kwargs, 3, "positions"), false, "positions");
+    if(pos.group(3) != 3 || pos.size() % 3 != 0) {
+        throw Py::ValueError("skin needs groups of three floats (x y z ...) for the positions.");
+    }
+    if(weights.size() != bones.size()) {
+        throw Py::ValueError("skin needs as many weights as bone indices.");
+    }
+
+    const std::size_t n = pos.size() / 3;
+    const std::size_t k = n ? bones.size() / n : 0;
+    if(k * n != bones.size() || (n && k == 0) || bones.group(k) != k) {
+        throw Py::ValueError("skin needs the same amount of bone indices and weights for every vertex.");
+    }
+
+    Py::Object normals_arg = argument(args, kwargs, 4, "normals");
+    if(normals_arg.isNone()) {
+        OutArg out(argument(args, kwargs, 5, "out"), pos.size(), "out");
+        skin_with(palette, dq_palette, bones, weights, k, pos.data(), out.data(), 0, 0, n);
+        return out.result();
+    }
+
+    FloatBufferArg nrm(normals_arg, false, "normals");
+    if(nrm.size() != pos.size() || nrm.group(3) != 3) {
+        throw Py::ValueError("skin needs as many normals as positions.");
+    }
+
+    OutArg out(argument(args, kwargs, 5, "out"), pos.size(), "out");
+    OutArg out_nrm(argument(args, kwargs, 6, "outNormals"), nrm.size(), "outNormals");
+    skin_with(palette, dq_palette, bones, weights, k, pos.data(), out.data(), nrm.data(), out_nrm.data(), n);
+    return Py::TupleN(out.result(), out_nrm.result());
+}
@@ -0,0 +1,11 @@
+#include "Skinning.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+/// Skins the positions, and optionally the normals, of a mesh by a palette of
+/// AffineMatrix objects (linear blending) or of DualQuaternion objects (dual
+/// quaternion blending), given the bone indices and weights of each vertex.
+/// Takes buffers and writes to the 'out' and 'outNormals' buffers, or returns
+/// array.array objects if not given. \see PyGlMath::skinLinear, PyGlMath::skinDualQuaternion
+Py::Object skin(const Py::Tuple& args, const Py::Dict& kwargs);
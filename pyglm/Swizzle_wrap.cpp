@@ -0,0 +1,155 @@
+#include "Swizzle_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Quaternion_wrap.hpp"
+
+#include <vector>
+
+namespace {
+
+// Encodes the swizzle of the n components at indices idx into a closure: the
+// amount of components in the lowest three bits, followed by two bits for
+// the index of each component.
+void* swizzle_code(const std::size_t* idx, std::size_t n)
+{
+    std::size_t code = n;
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        code |= idx[i] << (3 + 2*i);
+    }
+    return reinterpret_cast<void*>(code);
+}
+
+// Complains about being assigned m values instead of n.
+int wrong_count(std::size_t n, std::size_t m)
+{
+    PyErr_Format(PyExc_ValueError, "A swizzle of %d components needs to be assigned exactly as many numbers, not %d.", static_cast<int>(n), static_cast<int>(m));
+    return -1;
+}
+
+// Reads exactly n floats from a buffer of floats. Results in 1 on success, 0
+// if value isn't a buffer of floats and -1 if it holds another amount.
+int floats_from_buffer(PyObject* value, float* out, std::size_t n)
+{
+    if(!PyObject_CheckBuffer(value)) {
+        return 0;
+    }
+
+    Py_buffer view;
+    if(PyObject_GetBuffer(value, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        PyErr_Clear();
+        return 0;
+    }
+
+    const char* fmt = view.format ? view.format : "B";
+    std::size_t m = view.len / sizeof(float);
+    int result = 0;
+    if(std::strcmp(fmt, "f") == 0 || std::strcmp(fmt, "=f") == 0 || std::strcmp(fmt, "@f") == 0) {
+        result = m == n ? 1 : wrong_count(n, m);
+        if(result == 1) {
+            std::memcpy(out, view.buf, n*sizeof(float));
+        }
+    }
+
+    PyBuffer_Release(&view);
+    return result;
+}
+
+}
+
+PyGetSetDef* swizzle_getset(const PyGetSetDef* attributes, std::size_t components, getter get, setter set)
+{
+    static const char names[] = "xyzw";
+
+    std::vector<PyGetSetDef>* table = new std::vector<PyGetSetDef>();
+    for(const PyGetSetDef* a = attributes ; a->name != NULL ; ++a) {
+        table->push_back(*a);
+    }
+
+    for(std::size_t n = 2 ; n <= 4 ; ++n) {
+        // Counts through all combinations of n components, in base 'components'.
+        std::size_t idx[4] = {0, 0, 0, 0};
+        while(idx[n-1] < components) {
+            char* name = new char[n + 1];
+            bool distinct = true;
+            for(std::size_t i = 0 ; i < n ; ++i) {
+                name[i] = names[idx[i]];
+                for(std::size_t j = 0 ; j < i ; ++j) {
+                    distinct = distinct && idx[i] != idx[j];
+                }
+            }
+            name[n] = '\0';
+
+            PyGetSetDef swizzle = {name, get, distinct ? set : NULL, NULL, swizzle_code(idx, n)};
+            table->push_back(swizzle);
+
+            for(std::size_t i = 0 ; i < n && ++idx[i] == components && i < n-1 ; ++i) {
+                idx[i] = 0;
+            }
+        }
+    }
+
+    PyGetSetDef end = {NULL, NULL, NULL, NULL, NULL};
+    table->push_back(end);
+    return &(*table)[0];
+}
+
+PyObject* swizzle_result(const float* v, std::size_t n)
+{
+    if(n == 2) {
+        // Py::TupleN would go through a Py::Float for each.
+        PyObject* x = PyFloat_FromDouble(v[0]);
+        PyObject* y = PyFloat_FromDouble(v[1]);
+        PyObject* result = x && y ? PyTuple_Pack(2, x, y) : NULL;
+        Py_XDECREF(x);
+        Py_XDECREF(y);
+        return result;
+    }
+
+    try {
+        if(n == 3) {
+            return Py::new_reference_to(Vector::make_inst(PyGlMath::Vector(v[0], v[1], v[2])));
+        }
+        return Py::new_reference_to(Quaternion::make_inst(PyGlMath::Quaternion(v[0], v[1], v[2], v[3])));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+int swizzle_assign(float* components, PyObject* value, void* closure)
+{
+    std::size_t code = reinterpret_cast<std::size_t>(closure);
+    std::size_t n = code & 7;
+
+    // All values are read before writing any, for v.xy = v.yx to swap.
+    float v[4];
+    int from_buffer = floats_from_buffer(value, v, n);
+    if(from_buffer < 0) {
+        return -1;
+    } else if(from_buffer == 0) {
+        PyObject* seq = PySequence_Fast(value, "");
+        if(seq == NULL) {
+            PyErr_Format(PyExc_TypeError, "A swizzle of %d components needs to be assigned as many numbers, as a Vector, a Quaternion or any iterable.", static_cast<int>(n));
+            return -1;
+        }
+
+        std::size_t m = PySequence_Fast_GET_SIZE(seq);
+        if(m != n) {
+            Py_DECREF(seq);
+            return wrong_count(n, m);
+        }
+
+        for(std::size_t i = 0 ; i < n ; ++i) {
+            double d = 0.0;
+            if(!float_from(PySequence_Fast_GET_ITEM(seq, i), d)) {
+                Py_DECREF(seq);
+                return -1;
+            }
+            v[i] = static_cast<float>(d);
+        }
+        Py_DECREF(seq);
+    }
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        components[(code >> (3 + 2*i)) & 3] = v[i];
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef PYGLM_SWIZZLE_WRAP_H
+#define PYGLM_SWIZZLE_WRAP_H
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+/// Makes a table of attributes holding all of \a attributes, which ends with
+/// an entry whose name is NULL, followed by one attribute per GLSL-style
+/// swizzle of two to four of the first \a components components of "xyzw",
+/// such as xy, zyx or wzyx. The attributes are created once and for all, the
+/// swizzle each one stands for is stored in its closure: using one costs a
+/// lookup in the type's dictionary, no parsing of its name.
+/// \param attributes The other attributes of the type.
+/// \param components The amount of components the type has, 3 or 4.
+/// \param get The getter of all swizzles, get_swizzle<T>.
+/// \param set The setter of all swizzles without a repeated component,
+///            set_swizzle<T>. Others, as in GLSL, can't be assigned to.
+/// \return The table, to be passed to support_getset. It is never freed.
+PyGetSetDef* swizzle_getset(const PyGetSetDef* attributes, std::size_t components, getter get, setter set);
+
+/// \return What reading a swizzle of \a n components gives, made of the
+///         floats \a v: a tuple of two floats, a Vector or a Quaternion.
+PyObject* swizzle_result(const float* v, std::size_t n);
+
+/// Writes the components of the swizzle encoded in \a closure from \a value,
+/// which can be a buffer of as many floats, such as a Vector, or any iterable
+/// of as many numbers.
+/// \return 0 on success, -1 with the Python exception set otherwise.
+int swizzle_assign(float* components, PyObject* value, void* closure);
+
+/// The getter of all swizzle attributes of the wrapper class \a T, which
+/// exposes its components through T::float_buffer(). \see swizzle_getset
+template<class T>
+PyObject* get_swizzle(PyObject* self, void* closure)
+{
+    const float* components = cxx_object<T>(self)->float_buffer().data;
+    std::size_t code = reinterpret_cast<std::size_t>(closure);
+    std::size_t n = code & 7;
+
+    float v[4];
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        v[i] = components[(code >> (3 + 2*i)) & 3];
+    }
+    return swizzle_result(v, n);
+}
+
+/// The setter going with get_swizzle.
+template<class T>
+int set_swizzle(PyObject* self, PyObject* value, void* closure)
+{
+    if(value == NULL) {
+        PyErr_Format(PyExc_AttributeError, "The attributes of %s can't be deleted.", Py_TYPE(self)->tp_name);
+        return -1;
+    }
+
+    return swizzle_assign(cxx_object<T>(self)->float_buffer().data, value, closure);
+}
+
+#endif // PYGLM_SWIZZLE_WRAP_H
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// How many chunks each thread gets at most: enough for the faster threads to
+// have something left to steal, few enough not to spend the time dealing.
+const std::size_t chunks_per_thread = 4;
+
+struct Range {
+    std::size_t begin;
+    std::size_t end;
+};
+
+struct Queue {
+    std::mutex lock;
+    std::deque<Range> ranges;
+};
+
+}
+
+namespace PyGlMath {
+
+struct ThreadPool::Impl {
+    /// How many threads work on a loop, counting the one starting it. Only
+    /// changed while holding running, but may be read at any time.
+    std::atomic<std::size_t> nThreads;
+    /// The threads other than the one starting a loop, started with the first loop.
+    std::vector<std::thread> workers;
+    /// The chunks left of the running loop, one queue per thread. The first
+    /// one is that of the thread which started it.
+    std::vector<Queue> queues;
+
+    /// Held by the thread running a loop for all its duration.
+    std::mutex running;
+    /// What the running loop does. Both are set before dealing out the chunks,
+    /// which are only taken under the lock of their queue.
+    RangeTask task;
+    void *data;
+
+    /// Counts the loops, which is how the workers know there's a new one.
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    unsigned long loops;
+    bool stopping;
+
+    /// The chunks of the running loop which aren't done yet.
+    std::atomic<std::size_t> remaining;
+    std::mutex doneLock;
+    std::condition_variable done;
+
+    /// The pool the current thread works for, if any. That's how a loop started
+    /// from within a task knows it can't wait for the other threads.
+    static thread_local const Impl *current;
+
+    Impl(std::size_t in_threads)
+        : nThreads(in_threads)
+        , queues(in_threads)
+        , task(0)
+        , data(0)
+        , loops(0)
+        , stopping(false)
+        , remaining(0)
+    { }
+
+    /// Takes the next chunk of the own queue, or else one off the back of another one.
+    bool take(std::size_t in_self, Range& out_r)
+    {
+        const std::size_t n = nThreads;
+        for(std::size_t i = 0 ; i < n ; ++i) {
+            Queue& q = queues[(in_self + i) % n];
+            std::lock_guard<std::mutex> lock(q.lock);
+            if(!q.ranges.empty()) {
+                if(i == 0) {
+                    out_r = q.ranges.front();
+                    q.ranges.pop_front();
+                } else {
+                    out_r = q.ranges.back();
+                    q.ranges.pop_back();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Works on the running loop until no chunk is left anywhere.
+    void work(std::size_t in_self)
+    {
+        Range r;
+        while(take(in_self, r)) {
+            task(data, r.begin, r.end);
+            if(remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(doneLock);
+                done.notify_all();
+            }
+        }
+    }
+
+    /// What the workers do: sleep until a loop starts, work on it, repeat.
+    void serve(std::size_t in_self, unsigned long in_loops)
+    {
+        for(;;) {
+            {
+                std::unique_lock<std::mutex> lock(wakeLock);
+                while(!stopping && loops == in_loops) {
+                    wake.wait(lock);
+                }
+                if(stopping) {
+                    return;
+                }
+                in_loops = loops;
+            }
+            this->work(in_self);
+        }
+    }
+
+    static void serveThread(Impl *in_pool, std::size_t in_self, unsigned long in_loops)
+    {
+        current = in_pool;
+        in_pool->serve(in_self, in_loops);
+    }
+
+    void start()
+    {
+        for(std::size_t i = 1 ; i < nThreads ; ++i) {
+            workers.push_back(std::thread(&Impl::serveThread, this, i, loops));
+        }
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(std::size_t i = 0 ; i < workers.size() ; ++i) {
+            workers[i].join();
+        }
+        workers.clear();
+        stopping = false;
+    }
+};
+
+thread_local const ThreadPool::Impl *ThreadPool::Impl::current = 0;
+
+ThreadPool::ThreadPool(std::size_t in_threads)
+    : m(0)
+{
+    if(in_threads == 0) {
+        in_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m = new Impl(std::min(in_threads, maxThreads()));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> running(m->running);
+        m->stop();
+    }
+    delete m;
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    // Never destroyed, as joining threads while the process exits can hang,
+    // on Windows in particular. The workers are asleep by then anyways.
+    static ThreadPool *pool = new ThreadPool();
+    return *pool;
+}
+
+std::size_t ThreadPool::maxThreads()
+{
+    return std::max<std::size_t>(64, 8*std::thread::hardware_concurrency());
+}
+
+std::size_t ThreadPool::threads() const
+{
+    return m->nThreads;
+}
+
+void ThreadPool::threads(std::size_t in_threads)
+{
+    if(in_threads == 0) {
+        in_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    in_threads = std::min(in_threads, maxThreads());
+
+    std::lock_guard<std::mutex> running(m->running);
+    if(in_threads == m->nThreads) {
+        return;
+    }
+
+    m->stop();
+    std::vector<Queue>(in_threads).swap(m->queues);
+    m->nThreads = in_threads;
+}
+
+void ThreadPool::parallelFor(std::size_t in_n, std::size_t in_grain, RangeTask in_task, void *in_data)
+{
+    in_grain = std::max<std::size_t>(in_grain, 1);
+    if(in_n <= in_grain || Impl::current == m) {
+        in_task(in_data, 0, in_n);
+        return;
+    }
+
+    std::unique_lock<std::mutex> running(m->running, std::try_to_lock);
+    if(!running.owns_lock() || m->nThreads == 1) {
+        in_task(in_data, 0, in_n);
+        return;
+    }
+
+    if(m->workers.empty()) {
+        m->start();
+    }
+
+    // As many chunks of the same size as the grain allows, at most a few per thread.
+    const std::size_t nchunks = std::min((in_n + in_grain - 1) / in_grain, chunks_per_thread * m->nThreads);
+    const std::size_t size = (in_n + nchunks - 1) / nchunks;
+
+    m->task = in_task;
+    m->data = in_data;
+    m->remaining = (in_n + size - 1) / size;
+    for(std::size_t begin = 0, i = 0 ; begin < in_n ; begin += size, ++i) {
+        const Range r = {begin, std::min(begin + size, in_n)};
+        Queue& q = m->queues[i % m->nThreads];
+        std::lock_guard<std::mutex> lock(q.lock);
+        q.ranges.push_back(r);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m->wakeLock);
+        ++m->loops;
+    }
+    m->wake.notify_all();
+
+    Impl::current = m;
+    m->work(0);
+    Impl::current = 0;
+
+    std::unique_lock<std::mutex> lock(m->doneLock);
+    while(m->remaining != 0) {
+        m->done.wait(lock);
+    }
+}
+
+} // namespace PyGlMath
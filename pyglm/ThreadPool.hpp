@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_THREADPOOL_H
+#define PYGLM_THREADPOOL_H
+
+#include <cstddef>
+
+namespace PyGlMath {
+
+/// The work of a parallel loop: does whatever needs to be done for the items
+/// from \a in_begin up to, but not including, \a in_end.
+/// \param in_data Whatever the loop was given along with the task.
+typedef void (*RangeTask)(void *in_data, std::size_t in_begin, std::size_t in_end);
+
+/// The worker threads the batch operations split their work over. A loop is
+/// cut into chunks which are dealt out to one queue per thread. Each thread
+/// goes through its own queue front to back and, once that's empty, steals
+/// from the back of the others, which evens out chunks taking longer than
+/// others without having all threads fight over a single queue.\n
+/// The thread starting a loop works on it too, and returns once it's done.
+/// The workers are only started by the first loop worth splitting.
+/// \note A loop started while another one is running, be it from within a
+///       task or from another thread, simply runs on the thread starting it.
+class ThreadPool {
+public:
+    /// Creates a pool, without starting any thread yet.
+    /// \param in_threads How many threads work on a loop, counting the one
+    ///                   starting it. 0 means one per core, and more than
+    ///                   maxThreads means maxThreads.
+    explicit ThreadPool(std::size_t in_threads = 0);
+    /// Waits for the workers to finish their last chunk and stops them.
+    ~ThreadPool();
+
+    /// \return The pool used by all batch operations of the library.
+    static ThreadPool& instance();
+
+    /// \return The most threads a pool runs: eight per core, but at least 64.
+    ///         More would only cost memory and switches between them.
+    static std::size_t maxThreads();
+
+    /// \return How many threads work on a loop, counting the one starting it.
+    std::size_t threads() const;
+    /// Sets how many threads work on a loop, counting the one starting it.
+    /// Waits for the running loop, if any, to finish first.
+    /// \param in_threads The amount of threads, 1 running everything on the
+    ///                   calling thread and 0 meaning one per core. More
+    ///                   than maxThreads means maxThreads.
+    void threads(std::size_t in_threads);
+
+    /// Runs \a in_task over all items from 0 up to \a in_n, split into chunks
+    /// spread over the threads, and waits for all of them to be done.
+    /// \param in_n The amount of items.
+    /// \param in_grain The least amount of items worth a chunk of its own. Loops
+    ///                 of no more than that run on the calling thread only.
+    /// \param in_task What to do for a range of items. Ranges never overlap,
+    ///                but any two of them may run at the same time.
+    /// \param in_data Passed along to \a in_task.
+    void parallelFor(std::size_t in_n, std::size_t in_grain, RangeTask in_task, void *in_data);
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    /// The threads, queues and locks, which only the implementation needs to know.
+    struct Impl;
+    Impl *m;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_THREADPOOL_H
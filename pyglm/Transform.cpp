@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "Transform.hpp"
+#include "Matrix.hpp"
+#include "Util.hpp"
+
+#include <sstream>
+
+#if defined(D_PYGLM_SSE)
+#  include <xmmintrin.h>
+#endif
+
+namespace {
+
+#if defined(D_PYGLM_SSE)
+// The sum of the four components of x, in all four of them.
+inline __m128 hsum(__m128 x)
+{
+    x = _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#endif
+
+// Concatenates the transform (ta, qa, sa) with (tb, qb, sb) into (t, q, s),
+// all of them four floats with a w of 1 for the vectors, which may be unaligned
+// as the Transforms may come from new or std::vector, \see mul4x4 in Matrix.cpp.
+// This is all of operator * written out on plain floats: going through the
+// Vector and Quaternion operators instead means a call and a temporary for
+// each of them, which made it slower than the 4x4 matrix product it replaces.
+// Everything is read before anything is written, so the output may be either
+// operand.
+inline void compose(const float *ta, const float *qa, const float *sa,
+                    const float *tb, const float *qb, const float *sb,
+                    float *t, float *q, float *s)
+{
+    // this(in_t(p)) = t + R(s * (t' + R'(s' * p))), and as long as s is
+    // uniform it commutes with R', giving t + R(s * t') + RR'(ss' * p).
+    // R(v) is (w^2 - u.u) v + 2 (u.v) u + 2 w (u x v), u being the axis part of q.
+#if defined(D_PYGLM_SSE)
+    // The w of u and v is zeroed, so that it stays 1 in t.
+    const __m128 xyz = _mm_set_ps(0.0f, 1.0f, 1.0f, 1.0f);
+    const __m128 a = _mm_loadu_ps(qa), b = _mm_loadu_ps(qb);
+    const __m128 u = _mm_mul_ps(a, xyz);
+    const __m128 v = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(sa), _mm_loadu_ps(tb)), xyz);
+    const __m128 w = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(w, w), hsum(_mm_mul_ps(u, u)));
+    const __m128 d = hsum(_mm_mul_ps(u, v));
+    const __m128 cross = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2))),
+        _mm_mul_ps(_mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))));
+    __m128 r = _mm_add_ps(_mm_loadu_ps(ta), _mm_mul_ps(c, v));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_add_ps(d, d), u));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_add_ps(w, w), cross));
+
+    // The Hamilton product, as a linear combination of b with its components
+    // swapped around and negated.
+    __m128 p = _mm_mul_ps(w, b);
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)),
+                                 _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_set_ps(-1.0f, 1.0f, -1.0f, 1.0f))));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)),
+                                 _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_set_ps(-1.0f, -1.0f, 1.0f, 1.0f))));
+    p = _mm_add_ps(p, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)),
+                                 _mm_mul_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_set_ps(-1.0f, 1.0f, 1.0f, -1.0f))));
+
+    const __m128 scale = _mm_mul_ps(_mm_loadu_ps(sa), _mm_loadu_ps(sb));
+    _mm_storeu_ps(t, r);
+    _mm_storeu_ps(q, p);
+    _mm_storeu_ps(s, scale);
+#else
+    const float qx = qa[0], qy = qa[1], qz = qa[2], qw = qa[3];
+    const float bx = qb[0], by = qb[1], bz = qb[2], bw = qb[3];
+    const float sx = sa[0], sy = sa[1], sz = sa[2];
+    const float tx = ta[0], ty = ta[1], tz = ta[2];
+    const float x = sx*tb[0], y = sy*tb[1], z = sz*tb[2];
+    const float s0 = sx*sb[0], s1 = sy*sb[1], s2 = sz*sb[2];
+
+    const float c = qw*qw - (qx*qx + qy*qy + qz*qz);
+    const float d = 2.0f*(qx*x + qy*y + qz*z);
+    const float w2 = 2.0f*qw;
+    t[0] = tx + c*x + d*qx + w2*(qy*z - qz*y);
+    t[1] = ty + c*y + d*qy + w2*(qz*x - qx*z);
+    t[2] = tz + c*z + d*qz + w2*(qx*y - qy*x);
+
+    q[0] = qw*bx + qx*bw + qy*bz - qz*by;
+    q[1] = qw*by + qy*bw + qz*bx - qx*bz;
+    q[2] = qw*bz + qz*bw + qx*by - qy*bx;
+    q[3] = qw*bw - qx*bx - qy*by - qz*bz;
+
+    s[0] = s0;
+    s[1] = s1;
+    s[2] = s2;
+#endif
+}
+
+}
+
+namespace PyGlMath {
+
+////////////////////////////////////////////
+// Constructors and assignment operators. //
+////////////////////////////////////////////
+
+Transform::Transform()
+    : m_trans()
+    , m_rot()
+    , m_scale(1.0f, 1.0f, 1.0f)
+{ }
+
+Transform::Transform(const Vector& in_trans, const Quaternion& in_rot)
+    : m_trans(in_trans)
+    , m_rot(in_rot)
+    , m_scale(1.0f, 1.0f, 1.0f)
+{ }
+
+Transform::Transform(const Vector& in_trans, const Quaternion& in_rot, const Vector& in_scale)
+    : m_trans(in_trans)
+    , m_rot(in_rot)
+    , m_scale(in_scale)
+{ }
+
+/////////////////////////////////////
+// Accessors, getters and setters. //
+/////////////////////////////////////
+
+std::string Transform::to_s(unsigned int in_iDecimalPlaces) const
+{
+    std::stringstream ss;
+    ss << "translation " << m_trans.to_s(in_iDecimalPlaces)
+       << ", rotation " << m_rot.to_s(in_iDecimalPlaces)
+       << ", scale " << m_scale.to_s(in_iDecimalPlaces);
+    return ss.str();
+}
+
+Transform::operator std::string() const
+{
+    return this->to_s();
+}
+
+///////////////////////////////
+// Transform concatenations. //
+///////////////////////////////
+
+Transform Transform::operator *(const Transform& in_t) const
+{
+    // Copying is cheaper than the constructors, which live in other files.
+    Transform result(*this);
+    compose(m_trans.array4f(), m_rot.array4f(), m_scale.array4f(),
+            in_t.m_trans.array4f(), in_t.m_rot.array4f(), in_t.m_scale.array4f(),
+            result.m_trans.array4f(), result.m_rot.array4f(), result.m_scale.array4f());
+    return result;
+}
+
+void Transform::operator *=(const Transform& in_t)
+{
+    compose(m_trans.array4f(), m_rot.array4f(), m_scale.array4f(),
+            in_t.m_trans.array4f(), in_t.m_rot.array4f(), in_t.m_scale.array4f(),
+            m_trans.array4f(), m_rot.array4f(), m_scale.array4f());
+}
+
+Vector Transform::operator *(const Vector& in_v) const
+{
+    return m_trans + m_rot.rotate(m_scale * in_v);
+}
+
+Vector Transform::direction(const Vector& in_v) const
+{
+    return m_rot.rotate(m_scale * in_v);
+}
+
+Transform Transform::inverse() const
+{
+    // p = t + R(s * x) gives x = 1/s * R^-1(p - t), where again the scale
+    // needs to be uniform to commute with the rotation.
+    const Vector one_over_s(1.0f/m_scale.x(), 1.0f/m_scale.y(), 1.0f/m_scale.z());
+    const Quaternion inv = m_rot.cnj();
+    return Transform(-(one_over_s * inv.rotate(m_trans)), inv, one_over_s);
+}
+
+////////////////////////////////////
+// Conversions and interpolation. //
+////////////////////////////////////
+
+AffineMatrix Transform::matrix() const
+{
+    return AffineMatrix::transformation(m_trans, m_rot, m_scale);
+}
+
+void Transform::array16f(float *out_m) const
+{
+    // The rotation part is the same as AffineMatrix::setRotation's.
+    const float l = m_rot.dot(m_rot);
+    const float s = nearZero(l) ? 1.0f : 2.0f / l;
+
+    const float xs = m_rot.x() * s, ys = m_rot.y() * s, zs = m_rot.z() * s;
+    const float wx = m_rot.w() * xs, wy = m_rot.w() * ys, wz = m_rot.w() * zs;
+    const float xx = m_rot.x() * xs, xy = m_rot.x() * ys, xz = m_rot.x() * zs;
+    const float yy = m_rot.y() * ys, yz = m_rot.y() * zs, zz = m_rot.z() * zs;
+    const float sx = m_scale.x(), sy = m_scale.y(), sz = m_scale.z();
+
+    out_m[0]  = (1.0f - (yy + zz))*sx; out_m[1]  = (xy + wz)*sx;          out_m[2]  = (xz - wy)*sx;          out_m[3]  = 0.0f;
+    out_m[4]  = (xy - wz)*sy;          out_m[5]  = (1.0f - (xx + zz))*sy; out_m[6]  = (yz + wx)*sy;          out_m[7]  = 0.0f;
+    out_m[8]  = (xz + wy)*sz;          out_m[9]  = (yz - wx)*sz;          out_m[10] = (1.0f - (xx + yy))*sz; out_m[11] = 0.0f;
+    out_m[12] = m_trans.x();           out_m[13] = m_trans.y();           out_m[14] = m_trans.z();           out_m[15] = 1.0f;
+}
+
+Transform Transform::lerp(const Transform& in_t, float between) const
+{
+    // q and -q are the same rotation, but nlerp between them would go all
+    // around through the identity.
+    const Quaternion other = m_rot.dot(in_t.m_rot) < 0.0f ? -in_t.m_rot : in_t.m_rot;
+    return Transform(m_trans.lerp(in_t.m_trans, between),
+                     m_rot.nlerp(other, between),
+                     m_scale.lerp(in_t.m_scale, between));
+}
+
+//////////////////////////////////////
+// Transform comparison operations. //
+//////////////////////////////////////
+
+bool Transform::operator ==(const Transform& in_t) const
+{
+    return m_trans == in_t.m_trans && m_rot == in_t.m_rot && m_scale == in_t.m_scale;
+}
+
+} // namespace PyGlMath
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_TRANSFORM_H
+#define PYGLM_TRANSFORM_H
+
+#include "Vector.hpp"
+#include "Quaternion.hpp"
+
+#include <string>
+
+namespace PyGlMath {
+    class AffineMatrix;
+
+/// A transformation kept apart as a translation, a rotation and a scale (TQS)
+/// instead of as a matrix. It applies the scale first, then the rotation and
+/// then the translation, just like AffineMatrix::transformation builds it.\n
+/// Concatenating two of these costs a quaternion product and a rotation
+/// instead of two 4x4 matrix products (the inverse being updated too), which
+/// is what hierarchies of bones and scene nodes want. Convert to an
+/// AffineMatrix only at the end, for instance when uploading to the GPU.
+/// \note The rotation is supposed to be a unit quaternion.
+/// \note A scale which is not the same along all three axes doesn't survive
+///       a rotation, which is why concatenations and inverses are only exact
+///       as long as the scale of the left transform is uniform. Game engines
+///       make the same trade-off, while matrices don't.
+class Transform {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates the identity transform: no translation, rotation nor scaling.
+    Transform();
+    /// Creates a transform which rotates and then translates.
+    /// \param in_trans The translation.
+    /// \param in_rot The rotation.
+    Transform(const Vector& in_trans, const Quaternion& in_rot);
+    /// Creates a transform which scales, rotates and then translates.
+    /// \param in_trans The translation.
+    /// \param in_rot The rotation.
+    /// \param in_scale The scaling factor along each of the three axes.
+    Transform(const Vector& in_trans, const Quaternion& in_rot, const Vector& in_scale);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The translation of this transform.
+    inline const Vector& translation() const { return m_trans; };
+    /// \return The rotation of this transform.
+    inline const Quaternion& rotation() const { return m_rot; };
+    /// \return The scaling factors of this transform along each of the axes.
+    inline const Vector& scale() const { return m_scale; };
+    /// Sets the translation of this transform. \return a reference to *this
+    inline Transform& translation(const Vector& in_trans) { m_trans = in_trans; return *this; };
+    /// Sets the rotation of this transform. \return a reference to *this
+    inline Transform& rotation(const Quaternion& in_rot) { m_rot = in_rot; return *this; };
+    /// Sets the scaling factors of this transform. \return a reference to *this
+    inline Transform& scale(const Vector& in_scale) { m_scale = in_scale; return *this; };
+
+    /// \param in_iDecimalPlaces The amount of decimal places to use.
+    /// \return A string representing the three parts of this transform.
+    std::string to_s(unsigned int in_iDecimalPlaces = 2) const;
+    /// \return A string representing the three parts of this transform.
+    operator std::string() const;
+
+    ///////////////////////////////
+    // Transform concatenations. //
+    ///////////////////////////////
+
+    /// Concatenates two transforms, like the product of their matrices does.
+    /// \param in_t The transform to apply before this one, for example a child's
+    ///             transform relative to this, its parent.
+    /// \return The transform doing \a in_t first and then this.
+    Transform operator *(const Transform& in_t) const;
+    /// Concatenates \a in_t to this, in the same order as operator *.
+    void operator *=(const Transform& in_t);
+    /// Transforms a point: scales, rotates and then translates it.
+    /// \param in_v The point to transform.
+    /// \return The transformed point.
+    Vector operator *(const Vector& in_v) const;
+    /// Transforms a direction: scales and rotates it, but doesn't translate it.
+    /// \param in_v The direction to transform.
+    /// \return The transformed direction.
+    Vector direction(const Vector& in_v) const;
+
+    /// \return The transform undoing this one, with the rotation inverted and
+    ///         the reciprocal of the scale.
+    Transform inverse() const;
+
+    ////////////////////////////////////
+    // Conversions and interpolation. //
+    ////////////////////////////////////
+
+    /// \return The matrix doing the same as this transform, along with its inverse.
+    AffineMatrix matrix() const;
+    /// Writes the matrix doing the same as this transform, without its inverse.
+    /// \param out_m Where to write the 16 floats of the matrix, in column-major
+    ///              order like AffineMatrix::array16f.
+    void array16f(float *out_m) const;
+
+    /// Interpolates between this and \a in_t: linearly for the translation and
+    /// the scale, by nlerp for the rotation.
+    /// \param in_t The other transform with which to interpolate.
+    /// \param between The time of interpolation. 0.0f results in this, 1.0f results in \a in_t.
+    /// \return The interpolated transform.
+    /// \note Unlike Quaternion::nlerp, this always takes the shortest way
+    ///       between the rotations.
+    Transform lerp(const Transform& in_t, float between) const;
+
+    //////////////////////////////////////
+    // Transform comparison operations. //
+    //////////////////////////////////////
+
+    /// \return true if all three parts of this are \e nearly the same as those of \a in_t.
+    bool operator ==(const Transform& in_t) const;
+    /// \return true if any part of this is \e not \e nearly the same as that of \a in_t.
+    inline bool operator !=(const Transform& in_t) const {return !this->operator==(in_t);};
+
+private:
+    /// The translation, applied last.
+    Vector m_trans;
+    /// The rotation, applied after the scale.
+    Quaternion m_rot;
+    /// The scaling factors along each axis, applied first.
+    Vector m_scale;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_TRANSFORM_H
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#include "TransformHierarchy.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace PyGlMath {
+
+////////////////////////////////////////////
+// Constructors and assignment operators. //
+////////////////////////////////////////////
+
+TransformHierarchy::TransformHierarchy(const int *in_parents, std::size_t in_n)
+    : m_parents(in_parents, in_parents + in_n)
+    , m_local(in_n)
+    , m_world(in_n)
+    , m_matrices(16*in_n)
+    , m_dirty(in_n, 0)
+    , m_firstDirty(in_n)
+{
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        m_world[i].setLazyInverse(true);
+        std::memcpy(&m_matrices[16*i], m_world[i].array16f(), 16*sizeof(float));
+    }
+}
+
+std::size_t TransformHierarchy::sorted(const int *in_parents, std::size_t in_n)
+{
+    for(std::size_t i = 0 ; i < in_n ; ++i) {
+        if(in_parents[i] < -1 || (in_parents[i] >= 0 && static_cast<std::size_t>(in_parents[i]) >= i)) {
+            return i;
+        }
+    }
+
+    return in_n;
+}
+
+/////////////////////////////////////
+// Accessors, getters and setters. //
+/////////////////////////////////////
+
+void TransformHierarchy::local(std::size_t idx, const Transform& in_t)
+{
+    m_local[idx] = in_t;
+    m_dirty[idx] = 1;
+    m_firstDirty = std::min(m_firstDirty, idx);
+}
+
+/////////////////
+// Evaluation. //
+/////////////////
+
+std::size_t TransformHierarchy::update()
+{
+    const std::size_t n = m_parents.size();
+    std::size_t recomputed = 0;
+
+    for(std::size_t i = m_firstDirty ; i < n ; ++i) {
+        // The parent has been seen already, its flag tells whether it moved.
+        const int p = m_parents[i];
+        if(p >= 0 && m_dirty[p]) {
+            m_dirty[i] = 1;
+        }
+        if(!m_dirty[i]) {
+            continue;
+        }
+
+        // Concatenating the Transforms instead would be wrong as soon as
+        // a parent scales unevenly, their product drops the shear.
+        if(p < 0) {
+            m_world[i] = m_local[i].matrix();
+        } else {
+            m_world[i] = m_world[p] * m_local[i].matrix();
+        }
+        std::memcpy(&m_matrices[16*i], m_world[i].array16f(), 16*sizeof(float));
+        ++recomputed;
+    }
+
+    if(m_firstDirty < n) {
+        std::fill(m_dirty.begin() + m_firstDirty, m_dirty.end(), 0);
+    }
+    m_firstDirty = n;
+    return recomputed;
+}
+
+void TransformHierarchy::invalidate()
+{
+    std::fill(m_dirty.begin(), m_dirty.end(), 1);
+    m_firstDirty = 0;
+}
+
+} // namespace PyGlMath
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_TRANSFORMHIERARCHY_H
+#define PYGLM_TRANSFORMHIERARCHY_H
+
+#include "Transform.hpp"
+#include "Matrix.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PyGlMath {
+
+/// The nodes of a skeleton or of a scene graph, stored as flat arrays instead
+/// of as a tree: each node has an index, a local transform relative to its
+/// parent and the index of that parent. The nodes are sorted such that
+/// parents always come before their children, which lets update compute all
+/// local-to-world matrices in a single pass from the first node to the last.\n
+/// The world matrices are also written one after the other in a single block
+/// of floats, ready to be uploaded as a whole.\n
+/// Setting a local transform marks the node as dirty, and update only
+/// recomputes the dirty nodes and everything below them. Scenes where few
+/// nodes move per frame thus only pay for those.
+/// \note The amount of nodes and their parents are fixed at creation.
+class TransformHierarchy {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates a hierarchy of \a in_n nodes, all with an identity local transform.
+    /// \param in_parents The index of the parent of every node, or -1 for the
+    ///                   roots. Every parent needs to come before its children,
+    ///                   \see sorted.
+    /// \param in_n The amount of nodes.
+    TransformHierarchy(const int *in_parents, std::size_t in_n);
+
+    /// Checks whether parents come before their children, as the constructor needs.
+    /// \param in_parents The index of the parent of every node, or -1 for the roots.
+    /// \param in_n The amount of nodes.
+    /// \return The index of the first node whose parent doesn't come before it,
+    ///         or \a in_n if there is none.
+    static std::size_t sorted(const int *in_parents, std::size_t in_n);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The amount of nodes.
+    inline std::size_t size() const {return m_parents.size();};
+    /// \param idx The index of a node, it must be less than size().
+    /// \return The index of the parent of node \a idx, -1 for a root.
+    inline int parent(std::size_t idx) const {return m_parents[idx];};
+
+    /// \param idx The index of a node, it must be less than size().
+    /// \return The transform of node \a idx relative to its parent.
+    inline const Transform& local(std::size_t idx) const {return m_local[idx];};
+    /// \param idx The index of a node, it must be less than size().
+    /// \param in_t The new transform of node \a idx relative to its parent.
+    ///             It only shows in the world matrices after update.
+    void local(std::size_t idx, const Transform& in_t);
+    /// \param idx The index of a node, it must be less than size().
+    /// \return Whether the local transform of node \a idx changed since the last update.
+    inline bool dirty(std::size_t idx) const {return m_dirty[idx] != 0;};
+    /// \return The index of the first dirty node, size() if there is none. The
+    ///         next update recomputes at most the nodes from there on.
+    inline std::size_t firstDirty() const {return m_firstDirty;};
+
+    /// \param idx The index of a node, it must be less than size().
+    /// \return The local-to-world matrix of node \a idx, as of the last update.
+    /// \note This is a matrix and not a Transform, as a parent scaling unevenly
+    ///       shears a rotated child, which a Transform can't hold.
+    /// \note Its inverse is lazy, \see AffineMatrix::setLazyInverse.
+    inline const AffineMatrix& world(std::size_t idx) const {return m_world[idx];};
+    /// \return The local-to-world matrices of all nodes as of the last update,
+    ///         16 floats each, column-major like AffineMatrix::array16f.
+    inline const float *matrices() const {return m_matrices.empty() ? 0 : &m_matrices[0];};
+
+    /////////////////
+    // Evaluation. //
+    /////////////////
+
+    /// Computes the local-to-world matrices of the dirty nodes and of all
+    /// nodes below them, in one pass over the arrays: each world matrix is
+    /// that of the parent times the matrix of the local transform. The
+    /// pass starts at the first dirty node, as all nodes before it are
+    /// neither dirty nor below a dirty one.
+    /// \return The amount of nodes which have been recomputed.
+    std::size_t update();
+    /// Marks all nodes as dirty, such that the next update recomputes all of them.
+    void invalidate();
+
+private:
+    /// The index of the parent of each node, -1 for roots.
+    std::vector<int> m_parents;
+    /// The transform of each node relative to its parent.
+    std::vector<Transform> m_local;
+    /// The local-to-world matrix of each node, with a lazy inverse as most
+    /// of them never get inverted.
+    std::vector<AffineMatrix> m_world;
+    /// The floats of m_world one after the other, 16 floats each.
+    std::vector<float> m_matrices;
+    /// Whether each node's local transform changed since the last update.
+    /// During an update, also whether the node is below such a node.
+    std::vector<unsigned char> m_dirty;
+    /// No node before this index is dirty.
+    std::size_t m_firstDirty;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_TRANSFORMHIERARCHY_H
@@ -0,0 +1,228 @@
+#include "TransformHierarchy_wrap.hpp"
+#include "Transform_wrap.hpp"
+#include "Matrix_wrap.hpp"
+#include "Util_wrap.hpp"
+
+#include <vector>
+
+namespace {
+
+// The hierarchy described by the single argument, a sequence of parent indices.
+PyGlMath::TransformHierarchy hierarchy_from(const Py::Tuple& args, const Py::Dict& kwds)
+{
+    if(args.length() != 1 || kwds.length() != 0 || !args[0].isSequence()) {
+        throw Py::TypeError("TransformHierarchy takes a sequence holding the index of the parent of every node, or -1 for the roots.");
+    }
+
+    Py::Sequence s(args[0]);
+    std::vector<int> parents;
+    resize_or_raise(parents, s.length());
+    for(Py::Sequence::size_type i = 0 ; i < s.length() ; ++i) {
+        parents[i] = static_cast<int>(Py::Long(s[i]).as_long());
+    }
+
+    const int *p = parents.empty() ? 0 : &parents[0];
+    const std::size_t bad = PyGlMath::TransformHierarchy::sorted(p, parents.size());
+    if(bad != parents.size()) {
+        std::OSTRSTREAM ss;
+        ss << "The parent of node " << bad << " (" << parents[bad] << ") needs to be -1 or a node coming before it.";
+        throw Py::ValueError(ss.str());
+    }
+
+    return PyGlMath::TransformHierarchy(p, parents.size());
+}
+
+// The node index given as argument \a i, checked against the amount of nodes.
+std::size_t node_index(const PyGlMath::TransformHierarchy& h, const Py::Tuple& args, int i, const char* name)
+{
+    long idx = Py::Long(args[i]).as_long();
+    if(idx < 0 || static_cast<std::size_t>(idx) >= h.size()) {
+        throw Py::IndexError(std::string("TransformHierarchy.") + name + " node index out of range");
+    }
+    return static_cast<std::size_t>(idx);
+}
+
+}
+
+TransformHierarchy::TransformHierarchy(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<TransformHierarchy>::PythonClass(self, args, kwds)
+    , m_hier(hierarchy_from(args, kwds))
+{ }
+
+TransformHierarchy::~TransformHierarchy()
+{ }
+
+void TransformHierarchy::init_type()
+{
+    behaviors().name("TransformHierarchy");
+    behaviors().doc("The nodes of a skeleton or scene graph as flat arrays: TransformHierarchy(parents), with the index of every node's parent (-1 for roots), parents first. update() computes the world matrices of the nodes which changed and of those below them in one pass. h[i] is the world matrix of node i like world(i), and the buffer protocol gives all of them as an (n, 4, 4) block of floats.");
+    behaviors().supportRepr();
+    behaviors().supportSequenceType();
+    support_float_buffer<TransformHierarchy>(behaviors());
+
+    PYCXX_ADD_NOARGS_METHOD(parents, parents, "Returns the list of the parent of every node, -1 for the roots.");
+    PYCXX_ADD_VARARGS_METHOD(local, local, "Returns the Transform of the node given by index, relative to its parent.");
+    PYCXX_ADD_VARARGS_METHOD(setLocal, setLocal, "Sets the Transform of a node relative to its parent: setLocal(index, transform). Takes effect at the next update().");
+    PYCXX_ADD_VARARGS_METHOD(setLocals, setLocals, "Sets the local transforms of all nodes from a buffer of ten floats per node: translation x y z, rotation x y z w and scale x y z. Takes effect at the next update().");
+    PYCXX_ADD_VARARGS_METHOD(world, world, "Returns the local-to-world AffineMatrix of the node given by index, as of the last update(). Its inverse is lazy.");
+    PYCXX_ADD_VARARGS_METHOD(dirty, dirty, "Whether the local Transform of the node given by index changed since the last update().");
+    PYCXX_ADD_NOARGS_METHOD(update, update, "Computes the local-to-world matrices of the nodes whose local Transform changed and of all nodes below them. Returns how many nodes it recomputed.");
+    PYCXX_ADD_NOARGS_METHOD(invalidate, invalidate, "Marks all nodes as changed, such that the next update() recomputes all of them.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+FloatBuffer TransformHierarchy::float_buffer()
+{
+    // Indexed as [node, row, column], each matrix being column-major.
+    m_shape[0] = m_hier.size();
+    m_shape[1] = 4;
+    m_shape[2] = 4;
+    m_strides[0] = 16*sizeof(float);
+    m_strides[1] = sizeof(float);
+    m_strides[2] = 4*sizeof(float);
+    m_size = 16*m_hier.size();
+    FloatBuffer b = {const_cast<float*>(m_hier.matrices()), 3, m_shape, m_strides, &m_size, true};
+    return b;
+}
+
+Py::Object TransformHierarchy::repr()
+{
+    std::OSTRSTREAM ss;
+    ss << "TransformHierarchy(" << m_hier.size() << " nodes)";
+    return Py::String(ss.str());
+}
+
+int TransformHierarchy::sequence_length()
+{
+    return static_cast<int>(m_hier.size());
+}
+
+Py::Object TransformHierarchy::sequence_item(Py_ssize_t i)
+{
+    if(i < 0 || static_cast<std::size_t>(i) >= m_hier.size()) {
+        throw Py::IndexError("TransformHierarchy index out of range");
+    }
+
+    PyGlMath::AffineMatrix m;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m = m_hier.world(i);
+    }
+    return AffineMatrix::make_inst(m);
+}
+
+Py::Object TransformHierarchy::parents()
+{
+    Py::List l(m_hier.size());
+    for(std::size_t i = 0 ; i < m_hier.size() ; ++i) {
+        l[i] = Py::Long(m_hier.parent(i));
+    }
+    return l;
+}
+
+Py::Object TransformHierarchy::local(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("TransformHierarchy.local takes the index of a node.");
+    }
+
+    const std::size_t idx = node_index(m_hier, args, 0, "local");
+    PyGlMath::Transform t;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        t = m_hier.local(idx);
+    }
+    return Transform::make_inst(t);
+}
+
+Py::Object TransformHierarchy::setLocal(const Py::Tuple& args)
+{
+    if(args.length() != 2 || !Transform::check(args[1])) {
+        throw Py::TypeError("TransformHierarchy.setLocal takes the index of a node and a Transform.");
+    }
+
+    const std::size_t idx = node_index(m_hier, args, 0, "setLocal");
+    const PyGlMath::Transform t = Transform::TransformObject(args[1]).getCxxObject()->m_trans;
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_hier.local(idx, t);
+    return Py::None();
+}
+
+Py::Object TransformHierarchy::setLocals(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("TransformHierarchy.setLocals takes a buffer of ten floats per node.");
+    }
+
+    FloatBufferArg b(args[0], false, "TransformHierarchy.setLocals");
+    if(b.size() != 10*m_hier.size()) {
+        throw Py::ValueError("TransformHierarchy.setLocals needs ten floats per node: translation x y z, rotation x y z w and scale x y z.");
+    }
+
+    {
+        AllowThreads nogil(b.size());
+        std::lock_guard<std::mutex> lock(m_lock);
+        const float *f = b.data();
+        for(std::size_t i = 0 ; i < m_hier.size() ; ++i, f += 10) {
+            m_hier.local(i, PyGlMath::Transform(PyGlMath::Vector(f[0], f[1], f[2]),
+                                                PyGlMath::Quaternion(f[3], f[4], f[5], f[6]),
+                                                PyGlMath::Vector(f[7], f[8], f[9])));
+        }
+    }
+    return Py::None();
+}
+
+Py::Object TransformHierarchy::world(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("TransformHierarchy.world takes the index of a node.");
+    }
+
+    const std::size_t idx = node_index(m_hier, args, 0, "world");
+    PyGlMath::AffineMatrix m;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m = m_hier.world(idx);
+    }
+    return AffineMatrix::make_inst(m);
+}
+
+Py::Object TransformHierarchy::dirty(const Py::Tuple& args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("TransformHierarchy.dirty takes the index of a node.");
+    }
+
+    const std::size_t idx = node_index(m_hier, args, 0, "dirty");
+    std::lock_guard<std::mutex> lock(m_lock);
+    return Py::Boolean(m_hier.dirty(idx));
+}
+
+Py::Object TransformHierarchy::update()
+{
+    // Counting all nodes from the first dirty one, though some of them may
+    // turn out not to be below a dirty node.
+    std::unique_lock<std::mutex> lock(m_lock);
+    const std::size_t floats = 16*(m_hier.size() - m_hier.firstDirty());
+    lock.unlock();
+
+    std::size_t n = 0;
+    {
+        // Locking only once the GIL is gone, and unlocking before getting
+        // it back, \see AllowThreads.
+        AllowThreads nogil(floats);
+        lock.lock();
+        n = m_hier.update();
+        lock.unlock();
+    }
+    return Py::Long(static_cast<long>(n));
+}
+
+Py::Object TransformHierarchy::invalidate()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_hier.invalidate();
+    return Py::None();
+}
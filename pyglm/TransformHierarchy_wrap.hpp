@@ -0,0 +1,53 @@
+#include "TransformHierarchy.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+#include <mutex>
+
+class TransformHierarchy : public Py::PythonClass<TransformHierarchy>
+{
+public:
+    TransformHierarchy(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    virtual ~TransformHierarchy();
+
+    static void init_type();
+
+    PyGlMath::TransformHierarchy m_hier;
+
+    /// Used by the buffer protocol, \see get_float_buffer.
+    FloatBuffer float_buffer();
+
+private:
+    Py::Object repr();
+
+    int sequence_length();
+    Py::Object sequence_item(Py_ssize_t i);
+
+    Py::Object parents();
+    PYCXX_NOARGS_METHOD_DECL(TransformHierarchy, parents);
+    Py::Object local(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(TransformHierarchy, local);
+    Py::Object setLocal(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(TransformHierarchy, setLocal);
+    Py::Object setLocals(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(TransformHierarchy, setLocals);
+    Py::Object world(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(TransformHierarchy, world);
+    Py::Object dirty(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(TransformHierarchy, dirty);
+    Py::Object update();
+    PYCXX_NOARGS_METHOD_DECL(TransformHierarchy, update);
+    Py::Object invalidate();
+    PYCXX_NOARGS_METHOD_DECL(TransformHierarchy, invalidate);
+
+    /// Guards m_hier, which update and setLocals work on without the GIL.
+    std::mutex m_lock;
+
+    /// The layout exported through the buffer protocol, \see float_buffer.
+    Py_ssize_t m_shape[3];
+    Py_ssize_t m_strides[3];
+    Py_ssize_t m_size;
+};
@@ -0,0 +1,238 @@
+#include "Transform_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Quaternion_wrap.hpp"
+#include "Matrix_wrap.hpp"
+#include "Util_wrap.hpp"
+
+Transform::Transform(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<Transform>::PythonClass(self, args, kwds)
+    , m_trans()
+{
+    if(args.length() == 1 && kwds.length() == 0 && Transform::check(args[0])) {
+        TransformObject other(args[0]);
+        m_trans = other.getCxxObject()->m_trans;
+        return;
+    } else if(args.length() + kwds.length() > 3) {
+        throw Py::TypeError("Transform takes a translation, a rotation and a scale, all of them optional: Transform(translation, rotation, scale).");
+    }
+
+    static const char* const keys[] = {"translation", "rotation", "scale", NULL};
+    check_keywords(args, kwds, keys, "Transform");
+
+    Py::Object trans = argument(args, kwds, 0, "translation");
+    if(!trans.isNone()) {
+        m_trans.translation(vector_from(trans, "The translation of a Transform needs to be a Vector or an iterable."));
+    }
+    Py::Object rot = argument(args, kwds, 1, "rotation");
+    if(!rot.isNone()) {
+        m_trans.rotation(quaternion_from(rot, "The rotation of a Transform needs to be a Quaternion or an iterable of its four components."));
+    }
+    Py::Object scale = argument(args, kwds, 2, "scale");
+    if(!scale.isNone()) {
+        m_trans.scale(vector_from(scale, "The scale of a Transform needs to be a number, a Vector or an iterable.", true));
+    }
+}
+
+Transform::Transform(Py::PythonClassInstance *self, const PyGlMath::Transform& t)
+    : Py::PythonClass<Transform>::PythonClass(self, no_args(), no_kwds())
+    , m_trans(t)
+{ }
+
+Transform::TransformObject Transform::make_inst(const PyGlMath::Transform& t)
+{
+    return make_wrapped_inst<Transform>(t);
+}
+
+Transform::~Transform()
+{ }
+
+namespace {
+
+// The three parts of the transform, as attributes. They hand out copies, so
+// t.translation.x = 1 doesn't change t, t.translation = ... does.
+
+PyObject* get_translation(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Vector::make_inst(cxx_object<Transform>(self)->m_trans.translation()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+PyObject* get_rotation(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Quaternion::make_inst(cxx_object<Transform>(self)->m_trans.rotation()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+PyObject* get_scale(PyObject* self, void*)
+{
+    try {
+        return Py::new_reference_to(Vector::make_inst(cxx_object<Transform>(self)->m_trans.scale()));
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+}
+
+// Shared by the setters, refusing to delete the attribute.
+bool check_set(PyObject* self, PyObject* value)
+{
+    if(value == NULL) {
+        PyErr_Format(PyExc_AttributeError, "The attributes of %s can't be deleted.", Py_TYPE(self)->tp_name);
+        return false;
+    }
+    return true;
+}
+
+int set_translation(PyObject* self, PyObject* value, void*)
+{
+    if(!check_set(self, value)) {
+        return -1;
+    }
+
+    try {
+        cxx_object<Transform>(self)->m_trans.translation(vector_from(Py::Object(value), "The translation of a Transform needs to be a Vector or an iterable."));
+        return 0;
+    } catch(const Py::Exception&) {
+        return -1;
+    }
+}
+
+int set_rotation(PyObject* self, PyObject* value, void*)
+{
+    if(!check_set(self, value)) {
+        return -1;
+    }
+
+    try {
+        cxx_object<Transform>(self)->m_trans.rotation(quaternion_from(Py::Object(value), "The rotation of a Transform needs to be a Quaternion or an iterable of its four components."));
+        return 0;
+    } catch(const Py::Exception&) {
+        return -1;
+    }
+}
+
+int set_scale(PyObject* self, PyObject* value, void*)
+{
+    if(!check_set(self, value)) {
+        return -1;
+    }
+
+    try {
+        cxx_object<Transform>(self)->m_trans.scale(vector_from(Py::Object(value), "The scale of a Transform needs to be a number, a Vector or an iterable.", true));
+        return 0;
+    } catch(const Py::Exception&) {
+        return -1;
+    }
+}
+
+PyGetSetDef transform_getset[] = {
+    {"translation", &get_translation, &set_translation, "The translation, applied last, as a Vector.", NULL},
+    {"rotation", &get_rotation, &set_rotation, "The rotation, applied after the scale, as a Quaternion.", NULL},
+    {"scale", &get_scale, &set_scale, "The scaling factors along each axis, applied first, as a Vector. Setting it to a number scales uniformly.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+}
+
+void Transform::init_type()
+{
+    behaviors().name("Transform");
+    behaviors().doc("A transformation kept as a translation, a rotation and a scale instead of a matrix: Transform(translation, rotation, scale). Cheaper to concatenate than an AffineMatrix, convert it with matrix() at the end. Concatenations and inverses are only exact as long as the scale of the left transform is uniform.");
+    behaviors().supportRepr();
+    behaviors().supportStr();
+    behaviors().supportNumberType();
+    behaviors().type_object()->tp_as_number->nb_inplace_multiply = &number_inplace_handler<Transform, &Transform::number_inplace_multiply>;
+    support_getset(behaviors(), transform_getset);
+
+    PYCXX_ADD_NOARGS_METHOD(inverse, inverse, "Returns the transform undoing this one.");
+    PYCXX_ADD_NOARGS_METHOD(matrix, matrix, "Returns the AffineMatrix doing the same as this transform.");
+    PYCXX_ADD_VARARGS_METHOD(direction, direction, "Returns the Vector given as argument scaled and rotated, but not translated. Multiplying by a Vector transforms it as a point.");
+    PYCXX_ADD_KEYWORDS_METHOD(lerp, lerp, "Returns the interpolation between self and the first argument 'other' at the second argument 'between': linear for translation and scale, nlerp along the shortest way for the rotation.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+Py::Object Transform::repr()
+{
+    const PyGlMath::Vector& t = m_trans.translation();
+    const PyGlMath::Quaternion& q = m_trans.rotation();
+    const PyGlMath::Vector& s = m_trans.scale();
+    std::OSTRSTREAM ss;
+    ss << "Transform(Vector(" << t.x() << "," << t.y() << "," << t.z() << "),"
+       << "Quaternion(" << q.x() << "," << q.y() << "," << q.z() << "," << q.w() << "),"
+       << "Vector(" << s.x() << "," << s.y() << "," << s.z() << "))";
+    return Py::String(ss.str());
+}
+
+Py::Object Transform::str()
+{
+    return Py::String(m_trans.to_s());
+}
+
+Py::Object Transform::number_multiply(const Py::Object& other_)
+{
+    if(Transform::check(other_)) {
+        return make_inst(m_trans * cxx_object<Transform>(other_.ptr())->m_trans);
+    } else if(Vector::check(other_)) {
+        return Vector::make_inst(m_trans * cxx_object<Vector>(other_.ptr())->m_vec);
+    }
+
+    throw Py::TypeError("A Transform may only be multiplied by another Transform or by a Vector.");
+}
+
+bool Transform::number_inplace_multiply(const Py::Object& other_)
+{
+    // The product with a Vector is of another type.
+    if(!Transform::check(other_)) {
+        return false;
+    }
+
+    m_trans *= cxx_object<Transform>(other_.ptr())->m_trans;
+    return true;
+}
+
+Py::Object Transform::inverse()
+{
+    return make_inst(m_trans.inverse());
+}
+
+Py::Object Transform::matrix()
+{
+    return AffineMatrix::make_inst(m_trans.matrix());
+}
+
+Py::Object Transform::direction(const Py::Tuple& args)
+{
+    if(args.length() != 1 || !Vector::check(args[0])) {
+        throw Py::TypeError("Transform.direction takes a Vector.");
+    }
+
+    return Vector::make_inst(m_trans.direction(cxx_object<Vector>(args[0].ptr())->m_vec));
+}
+
+Py::Object Transform::lerp(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() != 2) {
+        throw Py::ValueError("Transform.lerp takes two arguments: first ('other') another transform and second ('between') a number.");
+    }
+
+    Py::Object other = argument(args, kwargs, 0, "other");
+    if(!Transform::check(other)) {
+        throw Py::TypeError("Transform.lerp takes a Transform as first argument ('other').");
+    }
+
+    float between;
+    try {
+        between = Py::Float(argument(args, kwargs, 1, "between"));
+    } catch(const Py::Exception& ) {
+        throw Py::TypeError("The second argument to Transform.lerp ('between') needs to be a numeric value.");
+    }
+
+    return make_inst(m_trans.lerp(cxx_object<Transform>(other.ptr())->m_trans, between));
+}
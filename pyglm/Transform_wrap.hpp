@@ -0,0 +1,38 @@
+#include "Transform.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+class Transform : public Py::PythonClass<Transform>
+{
+public:
+    Transform(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing transform without parsing arguments.
+    Transform(Py::PythonClassInstance *self, const PyGlMath::Transform& t);
+    virtual ~Transform();
+
+    static void init_type();
+
+    typedef Py::PythonClassObject<Transform> TransformObject;
+    static TransformObject make_inst(const PyGlMath::Transform& t);
+
+    PyGlMath::Transform m_trans;
+
+private:
+    Py::Object repr();
+    Py::Object str();
+
+    Py::Object number_multiply(const Py::Object& other_);
+    bool number_inplace_multiply(const Py::Object& other_);
+
+    Py::Object inverse();
+    PYCXX_NOARGS_METHOD_DECL(Transform, inverse);
+    Py::Object matrix();
+    PYCXX_NOARGS_METHOD_DECL(Transform, matrix);
+    Py::Object direction(const Py::Tuple& args);
+    PYCXX_VARARGS_METHOD_DECL(Transform, direction);
+    Py::Object lerp(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(Transform, lerp);
+};
@@ -24,11 +24,39 @@
 #ifndef PYGLM_UTIL_H
 #define PYGLM_UTIL_H
 
+#include <algorithm>
+
 /// Threshold used for floating point comparisons. You may want to redefine it.
 #ifndef D_PYGLM_EPSILON
 #  define D_PYGLM_EPSILON 0.00001f
 #endif
 
+/// Aligns a variable or member on an \a n bytes boundary, so that the data
+/// can be loaded into SIMD registers in one go.
+#if defined(_MSC_VER)
+#  define D_PYGLM_ALIGN(n) __declspec(align(n))
+#else
+#  define D_PYGLM_ALIGN(n) __attribute__((aligned(n)))
+#endif
+
+/// Promises the compiler that a pointer is the only way to reach its data,
+/// which is what allows it to vectorize loops over several arrays.
+#if defined(_MSC_VER)
+#  define D_PYGLM_RESTRICT __restrict
+#else
+#  define D_PYGLM_RESTRICT __restrict__
+#endif
+
+/// The instruction set used by the hand-written SIMD code, chosen at compile
+/// time: D_PYGLM_SSE on x86 and x86-64, D_PYGLM_NEON on ARM. Both are part of
+/// the baseline of these platforms, so there's no need to check at runtime.
+/// Define D_PYGLM_NO_SIMD to use the plain C++ fallback everywhere.
+#if !defined(D_PYGLM_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#  define D_PYGLM_SSE
+#elif !defined(D_PYGLM_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#  define D_PYGLM_NEON
+#endif
+
 namespace PyGlMath {
     // angles
     static const float pi = 3.141592f;
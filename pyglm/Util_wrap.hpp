@@ -0,0 +1,616 @@
+#ifndef PYGLM_UTIL_WRAP_H
+#define PYGLM_UTIL_WRAP_H
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include <new>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace PyGlMath {
+    class Vector;
+    class Quaternion;
+}
+
+/// Maximum amount of deallocated instances kept around for reuse, per wrapper
+/// type. You may want to redefine it.
+#ifndef D_PYGLM_FREELIST_SIZE
+#  define D_PYGLM_FREELIST_SIZE 256
+#endif
+
+/// The least amount of floats an operation needs to go through for it to let
+/// other Python threads run meanwhile, \see AllowThreads. You may want to
+/// redefine it.
+#ifndef D_PYGLM_GIL_THRESHOLD
+#  define D_PYGLM_GIL_THRESHOLD 16384
+#endif
+
+/// The PythonClass base constructor wants an argument tuple and a keyword
+/// dictionary it never looks at. Instances we create ourselves get these.
+inline Py::Tuple& no_args()
+{
+    static Py::Tuple* args = new Py::Tuple();
+    return *args;
+}
+
+/// \see no_args
+inline Py::Dict& no_kwds()
+{
+    static Py::Dict* kwds = new Py::Dict();
+    return *kwds;
+}
+
+/// Creates a new Python instance of the wrapper class \a T holding \a value.
+/// This skips calling the type, which would box the value into Python
+/// objects only to have the constructor parse them back again.
+/// \note \a T needs a constructor taking the instance and the value to wrap.
+template<class T, class V>
+Py::PythonClassObject<T> make_wrapped_inst(const V& value)
+{
+    PyTypeObject* type = T::type_object();
+    Py::PythonClassInstance* self = reinterpret_cast<Py::PythonClassInstance*>(type->tp_alloc(type, 0));
+    if(self == NULL) {
+        throw Py::Exception();
+    }
+
+    // Owns the reference, so that the instance is freed should T's constructor throw.
+    Py::Object obj(reinterpret_cast<PyObject*>(self), true);
+    self->m_pycxx_object = new T(self, value);
+    return Py::PythonClassObject<T>(obj);
+}
+
+/// A bounded list of deallocated instances of the wrapper class \a T, kept
+/// together with their C++ object so that both allocations can be skipped the
+/// next time make_inst needs an instance. Arithmetic creates and drops lots of
+/// short-lived temporaries, this is the same trick as CPython's float free list.
+/// \note Install FreeList<T>::dealloc as the type's tp_dealloc and create the
+///       instances through make_recycled_inst for this to have any effect.
+template<class T>
+class FreeList {
+public:
+    /// \return A deallocated instance whose C++ object is still allocated (but
+    ///         holds garbage) or NULL if the list is empty.
+    static Py::PythonClassInstance* pop()
+    {
+        if(s_size == 0) {
+            ++s_misses;
+            return NULL;
+        }
+
+        ++s_hits;
+        return s_items[--s_size];
+    }
+
+    /// Replacement for the PythonClass deallocator, keeping the instance if there's room.
+    static void dealloc(PyObject* _self)
+    {
+        Py::PythonClassInstance* self = reinterpret_cast<Py::PythonClassInstance*>(_self);
+
+        // Instances of Python subclasses have another layout, don't keep those,
+        // nor those whose __init__ failed.
+        if(Py_TYPE(_self) == T::type_object() && self->m_pycxx_object != NULL && s_size < D_PYGLM_FREELIST_SIZE) {
+            s_items[s_size++] = self;
+            return;
+        }
+
+        delete self->m_pycxx_object;
+        Py_TYPE(_self)->tp_free(_self);
+    }
+
+    /// \return A dictionary holding the amount of 'hits' and 'misses' of make_inst
+    ///         as well as the current 'size' and the 'capacity' of the list.
+    static Py::Dict stats()
+    {
+        Py::Dict d;
+        d["hits"] = Py::Long(s_hits);
+        d["misses"] = Py::Long(s_misses);
+        d["size"] = Py::Long(s_size);
+        d["capacity"] = Py::Long(D_PYGLM_FREELIST_SIZE);
+        return d;
+    }
+
+private:
+    static Py::PythonClassInstance* s_items[D_PYGLM_FREELIST_SIZE];
+    static long s_size;
+    static unsigned long s_hits;
+    static unsigned long s_misses;
+};
+
+template<class T> Py::PythonClassInstance* FreeList<T>::s_items[D_PYGLM_FREELIST_SIZE];
+template<class T> long FreeList<T>::s_size = 0;
+template<class T> unsigned long FreeList<T>::s_hits = 0;
+template<class T> unsigned long FreeList<T>::s_misses = 0;
+
+/// Same as make_wrapped_inst, but takes the instance from FreeList<T> if it
+/// has one, reusing the memory of both the Python and the C++ object.
+template<class T, class V>
+Py::PythonClassObject<T> make_recycled_inst(const V& value)
+{
+    Py::PythonClassInstance* self = FreeList<T>::pop();
+    if(self == NULL) {
+        return make_wrapped_inst<T>(value);
+    }
+
+    (void)PyObject_INIT(reinterpret_cast<PyObject*>(self), T::type_object());
+    Py::Object obj(reinterpret_cast<PyObject*>(self), true);
+
+    T* cxx = static_cast<T*>(self->m_pycxx_object);
+    cxx->~T();
+    new(cxx) T(self, value);
+    return Py::PythonClassObject<T>(obj);
+}
+
+/// \return The C++ object behind \a self, an instance of the wrapper class \a T.
+template<class T>
+T* cxx_object(PyObject* self)
+{
+    return static_cast<T*>(reinterpret_cast<Py::PythonClassInstance*>(self)->m_pycxx_object);
+}
+
+/// Describes the floats a wrapper class exposes through the buffer protocol.
+/// All pointers need to stay valid for as long as the instance lives.
+struct FloatBuffer {
+    /// The first float.
+    float* data;
+    /// The amount of dimensions, the length of \a shape and \a strides.
+    int ndim;
+    /// The amount of floats along each dimension.
+    Py_ssize_t* shape;
+    /// The distance in bytes between two consecutive floats along each dimension.
+    Py_ssize_t* strides;
+    /// The total amount of floats, which must all be packed without any gap.
+    Py_ssize_t* size;
+    /// Whether the floats may not be written to through the buffer.
+    bool readonly;
+};
+
+/// The bf_getbuffer slot: exports the floats described by T::float_buffer()
+/// without copying them, which lets numpy, struct, memoryview or OpenGL
+/// bindings work on them directly.\n
+/// Consumers not able to deal with the given strides (for instance asking for
+/// C-contiguous data while the matrices are column-major) get all the floats
+/// as a single dimension, in memory order.
+template<class T>
+int get_float_buffer(PyObject* self, Py_buffer* view, int flags)
+{
+    FloatBuffer b = cxx_object<T>(self)->float_buffer();
+
+    if(b.readonly && (flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_Format(PyExc_BufferError, "The %s buffer is read-only.", Py_TYPE(self)->tp_name);
+        view->obj = NULL;
+        return -1;
+    }
+
+    bool c_contiguous = true;
+    for(int i = b.ndim - 1, stride = sizeof(float) ; i >= 0 ; stride *= b.shape[i], --i) {
+        c_contiguous = c_contiguous && b.strides[i] == stride;
+    }
+    bool f_contiguous = true;
+    for(int i = 0, stride = sizeof(float) ; i < b.ndim ; stride *= b.shape[i], ++i) {
+        f_contiguous = f_contiguous && b.strides[i] == stride;
+    }
+
+    bool flatten = ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && !c_contiguous)
+                || ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS && !c_contiguous)
+                || ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS && !f_contiguous);
+
+    // An empty buffer still needs to point somewhere.
+    static float nothing = 0.0f;
+    static Py_ssize_t float_stride = sizeof(float);
+
+    view->buf = b.data ? b.data : &nothing;
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = *b.size * sizeof(float);
+    view->readonly = b.readonly ? 1 : 0;
+    view->itemsize = sizeof(float);
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>("f") : NULL;
+    view->ndim = flatten ? 1 : b.ndim;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? (flatten ? b.size : b.shape) : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? (flatten ? &float_stride : b.strides) : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+/// Makes the wrapper class \a T support the buffer protocol. Call it from its
+/// init_type, T needs a FloatBuffer float_buffer() method.
+template<class T>
+void support_float_buffer(Py::PythonType& behaviors)
+{
+    behaviors.supportBufferType();
+    behaviors.type_object()->tp_as_buffer->bf_getbuffer = &get_float_buffer<T>;
+}
+
+/// Converts \a value the way float() does, as Py::Float would, but without
+/// going through a new float object if it already is one.
+/// \return false, with the Python exception set, if it can't be converted.
+inline bool float_from(PyObject* value, double& out)
+{
+    if(PyFloat_CheckExact(value)) {
+        out = PyFloat_AS_DOUBLE(value);
+        return true;
+    }
+
+    PyObject* f = PyNumber_Float(value);
+    if(f == NULL) {
+        return false;
+    }
+
+    out = PyFloat_AS_DOUBLE(f);
+    Py_DECREF(f);
+    return true;
+}
+
+/// The getter of an attribute giving the float at index \a closure (a
+/// std::size_t) of the buffer described by T::float_buffer(). Unlike going
+/// through a getattro, which compares the name to every known attribute, the
+/// type finds the attribute as a descriptor in its dictionary, as quick as
+/// the attributes of any builtin type.
+template<class T>
+PyObject* get_float_attr(PyObject* self, void* closure)
+{
+    return PyFloat_FromDouble(cxx_object<T>(self)->float_buffer().data[reinterpret_cast<std::size_t>(closure)]);
+}
+
+/// The setter going with get_float_attr.
+template<class T>
+int set_float_attr(PyObject* self, PyObject* value, void* closure)
+{
+    if(value == NULL) {
+        PyErr_Format(PyExc_AttributeError, "The attributes of %s can't be deleted.", Py_TYPE(self)->tp_name);
+        return -1;
+    }
+
+    double d = 0.0;
+    if(!float_from(value, d)) {
+        return -1;
+    }
+
+    cxx_object<T>(self)->float_buffer().data[reinterpret_cast<std::size_t>(closure)] = static_cast<float>(d);
+    return 0;
+}
+
+/// Gives the type the attributes described by \a getset, which needs to end
+/// with an entry whose name is NULL and to outlive the type. Call it from
+/// init_type, before readyType.
+/// \note This also replaces the getattro and setattro handlers PythonClass
+///       always installs by CPython's own, so the class can't override
+///       getattro and setattro anymore. PythonClass' handlers cost a virtual
+///       call and a few Py::Object wrappers on every attribute access, even
+///       when they aren't overridden.
+inline void support_getset(Py::PythonType& behaviors, PyGetSetDef* getset)
+{
+    behaviors.type_object()->tp_getset = getset;
+    behaviors.type_object()->tp_getattro = PyObject_GenericGetAttr;
+    behaviors.type_object()->tp_setattro = PyObject_GenericSetAttr;
+}
+
+/// The in-place number slots (nb_inplace_add and co.), which PythonClass
+/// doesn't support: install them in the type's tp_as_number from init_type,
+/// after supportNumberType. \a Op modifies the instance itself, so that
+/// accumulating into it doesn't allocate anything. It results in false when
+/// it doesn't handle \a other, in which case Python falls back to the regular
+/// operator, which creates a new object or raises the usual error.
+template<class T, bool (T::*Op)(const Py::Object&)>
+PyObject* number_inplace_handler(PyObject* self, PyObject* other)
+{
+    try {
+        if(!(cxx_object<T>(self)->*Op)(Py::Object(other))) {
+            Py_RETURN_NOTIMPLEMENTED;
+        }
+    } catch(const Py::Exception&) {
+        return NULL;
+    }
+
+    Py_INCREF(self);
+    return self;
+}
+
+/// \return Whether \a o is an int or a float, which is then stored in \a out.
+///         Unlike Py::Float, this doesn't try converting anything else.
+inline bool plain_number(const Py::Object& o, float& out)
+{
+    if(!PyFloat_Check(o.ptr()) && !PyLong_Check(o.ptr())) {
+        return false;
+    }
+
+    double d = PyFloat_AsDouble(o.ptr());
+    if(d == -1.0 && PyErr_Occurred()) {
+        throw Py::Exception();
+    }
+
+    out = static_cast<float>(d);
+    return true;
+}
+
+/// Packs the given floats into an array.array('f') without going through a float object each.
+inline Py::Object float_array(const float* values, std::size_t n)
+{
+    Py::Module array_module(PyImport_ImportModule("array"), true);
+    Py::Callable array(array_module.getAttr("array"));
+
+    Py::Bytes data(PyBytes_FromStringAndSize(n ? reinterpret_cast<const char*>(values) : "", n*sizeof(float)), true);
+    return array.apply(Py::TupleN(Py::String("f"), data));
+}
+
+/// PyCXX only hands Py::Exception over to Python, any other exception ends
+/// the interpreter. Called from a catch(...) block, this raises a MemoryError
+/// for what the standard containers throw when asked for more than fits, and
+/// rethrows anything else unchanged.
+inline void rethrow_as_memory_error()
+{
+    try {
+        throw;
+    } catch(const std::bad_alloc&) {
+        throw Py::MemoryError("Not enough memory for that many elements.");
+    } catch(const std::length_error&) {
+        throw Py::MemoryError("Not enough memory for that many elements.");
+    }
+}
+
+/// Resizes \a v to \a n elements, which come from Python and may thus be
+/// anything, raising a MemoryError if they don't fit.
+template<class T>
+void resize_or_raise(std::vector<T>& v, std::size_t n)
+{
+    try {
+        v.resize(n);
+    } catch(...) {
+        rethrow_as_memory_error();
+    }
+}
+
+/// \see resize_or_raise
+template<class T>
+void reserve_or_raise(std::vector<T>& v, std::size_t n)
+{
+    try {
+        v.reserve(n);
+    } catch(...) {
+        rethrow_as_memory_error();
+    }
+}
+
+/// \return The argument at position \a i or, if there aren't that many, the
+///         one named \a key. None if there's neither.
+inline Py::Object argument(const Py::Tuple& args, const Py::Dict& kwargs, Py::Sequence::size_type i, const char* key)
+{
+    if(args.length() > i) {
+        return args[i];
+    }
+    return kwargs.hasKey(key) ? kwargs.getItem(key) : Py::None();
+}
+
+/// Checks that every keyword argument is one the function takes, and that
+/// none of them got passed by position too.
+/// \param keys The names of all arguments, in the order of their positions,
+///             ending with NULL.
+/// \param name The name of the function, for the error.
+/// \throws Py::TypeError for an unknown keyword or one given twice.
+inline void check_keywords(const Py::Tuple& args, const Py::Dict& kwargs, const char* const* keys, const char* name)
+{
+    Py::List given = kwargs.keys();
+    for(Py::List::size_type i = 0 ; i < given.length() ; ++i) {
+        const std::string key = Py::String(given[i]).as_std_string("utf-8");
+        Py::Sequence::size_type pos = 0;
+        while(keys[pos] && key != keys[pos]) {
+            ++pos;
+        }
+
+        if(!keys[pos]) {
+            throw Py::TypeError(std::string(name) + " got an unexpected keyword argument '" + key + "'.");
+        } else if(pos < args.length()) {
+            throw Py::TypeError(std::string(name) + " got multiple values for argument '" + key + "'.");
+        }
+    }
+}
+
+/// Takes either a Vector or any sequence holding up to three numbers, the
+/// missing ones being 0. Defined along with Vector.
+/// \param uniform Whether to also take a single number, for all three components.
+/// \throws Py::TypeError holding \a errmsg for anything else.
+PyGlMath::Vector vector_from(const Py::Object& o, const char* errmsg, bool uniform = false);
+
+/// Takes either a Quaternion or any sequence of its four components.
+/// Defined along with Quaternion.
+/// \throws Py::TypeError holding \a errmsg for anything else.
+PyGlMath::Quaternion quaternion_from(const Py::Object& o, const char* errmsg);
+
+/// \return Whether \a o is a VectorArray, whose buffer has one row per
+///         component instead of one per vector. Defined along with VectorArray.
+bool is_vector_array(PyObject* o);
+
+/// Borrows the floats of any object supporting the buffer protocol, for as
+/// long as it lives. They need to be packed, and can be grouped: the last
+/// dimension of the buffer, if it has two, is taken as group size.
+class FloatBufferArg {
+public:
+    /// \param obj The object to borrow the floats of.
+    /// \param writable Whether the floats are going to be written to.
+    /// \param what The name of the argument, used in error messages.
+    FloatBufferArg(const Py::Object& obj, bool writable, const char* what)
+        : m_what(what)
+    {
+        int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+        if(PyObject_GetBuffer(obj.ptr(), &m_view, flags) != 0) {
+            PyErr_Clear();
+            throw Py::TypeError(std::string(what) + " needs to be a contiguous" + (writable ? ", writable" : "") + " buffer of floats.");
+        }
+
+        const char* fmt = m_view.format ? m_view.format : "B";
+        if(std::strcmp(fmt, "f") != 0 && std::strcmp(fmt, "=f") != 0 && std::strcmp(fmt, "@f") != 0) {
+            PyBuffer_Release(&m_view);
+            throw Py::TypeError(std::string(what) + " needs to hold 32 bit floats ('f'), not '" + fmt + "'.");
+        }
+    }
+
+    ~FloatBufferArg()
+    {
+        PyBuffer_Release(&m_view);
+    }
+
+    /// \return The borrowed floats.
+    float* data() const {return static_cast<float*>(m_view.buf);}
+    /// \return The total amount of floats.
+    std::size_t size() const {return m_view.len / sizeof(float);}
+    /// \return The size of the last dimension, or \a def if there's only one.
+    /// \note Only flat buffers and buffers of one row per group ([n, k]) can
+    ///       be read as groups. A VectorArray has its x, y and z components as
+    ///       rows, which the shape alone doesn't tell apart from three vectors,
+    ///       so it gets a TypeError just like more dimensions get a ValueError.
+    std::size_t group(std::size_t def) const
+    {
+        if(m_view.obj && is_vector_array(m_view.obj)) {
+            throw Py::TypeError(std::string(m_what) + " can't be a VectorArray, which holds all x, then all y and then all z components. Pass the vectors as x y z ... instead.");
+        }
+        if(m_view.ndim > 2) {
+            throw Py::ValueError(std::string(m_what) + " needs to be flat or have two dimensions, one row per item.");
+        }
+        return m_view.ndim > 1 ? m_view.shape[m_view.ndim-1] : def;
+    }
+
+private:
+    FloatBufferArg(const FloatBufferArg&);
+    FloatBufferArg& operator=(const FloatBufferArg&);
+
+    const char* m_what;
+    Py_buffer m_view;
+};
+
+/// Reads the integers of any object supporting the buffer protocol, such as
+/// an array.array or a numpy array of any integer type, into unsigned ints.
+/// They need to be packed, and can be grouped like FloatBufferArg.
+class IndexBufferArg {
+public:
+    /// \param obj The object to read the integers of.
+    /// \param limit All integers need to be less than this, and not negative.
+    /// \param what The name of the argument, used in error messages.
+    IndexBufferArg(const Py::Object& obj, std::size_t limit, const char* what)
+        : m_group(0)
+    {
+        Py_buffer view;
+        if(PyObject_GetBuffer(obj.ptr(), &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+            PyErr_Clear();
+            throw Py::TypeError(std::string(what) + " needs to be a contiguous buffer of integers.");
+        }
+
+        const char* fmt = view.format ? view.format : "B";
+        if(*fmt == '@' || *fmt == '=') {
+            ++fmt;
+        }
+
+        const std::size_t n = view.itemsize > 0 ? view.len / view.itemsize : 0;
+        m_group = view.ndim > 1 ? view.shape[view.ndim-1] : 0;
+        try {
+            resize_or_raise(m_values, n);
+        } catch(...) {
+            PyBuffer_Release(&view);
+            throw;
+        }
+
+        bool ok = std::strlen(fmt) == 1;
+        for(std::size_t i = 0 ; ok && i < n ; ++i) {
+            // Signed values are read into v, unsigned ones into u.
+            long long v = 0;
+            unsigned long long u = 0;
+            const char* p = static_cast<const char*>(view.buf) + i*view.itemsize;
+            switch(*fmt) {
+            case 'b': v = *reinterpret_cast<const signed char*>(p); break;
+            case 'B': u = *reinterpret_cast<const unsigned char*>(p); break;
+            case 'h': v = *reinterpret_cast<const short*>(p); break;
+            case 'H': u = *reinterpret_cast<const unsigned short*>(p); break;
+            case 'i': v = *reinterpret_cast<const int*>(p); break;
+            case 'I': u = *reinterpret_cast<const unsigned int*>(p); break;
+            case 'l': v = *reinterpret_cast<const long*>(p); break;
+            case 'L': u = *reinterpret_cast<const unsigned long*>(p); break;
+            case 'q': v = *reinterpret_cast<const long long*>(p); break;
+            case 'Q': u = *reinterpret_cast<const unsigned long long*>(p); break;
+            default: ok = false; continue;
+            }
+
+            if(v < 0 || u + v >= limit) {
+                std::ostringstream msg;
+                if(v < 0) {
+                    msg << what << " holds " << v << ", which isn't in [0, " << limit << ").";
+                } else {
+                    msg << what << " holds " << u + v << ", which isn't in [0, " << limit << ").";
+                }
+                PyBuffer_Release(&view);
+                throw Py::ValueError(msg.str());
+            }
+            m_values[i] = static_cast<unsigned int>(u + v);
+        }
+
+        if(!ok) {
+            std::string f = view.format ? view.format : "B";
+            PyBuffer_Release(&view);
+            throw Py::TypeError(std::string(what) + " needs to hold integers, not '" + f + "'.");
+        }
+        PyBuffer_Release(&view);
+    }
+
+    /// \return The integers, converted to unsigned ints.
+    const unsigned int* data() const {return m_values.empty() ? 0 : &m_values[0];}
+    /// \return The total amount of integers.
+    std::size_t size() const {return m_values.size();}
+    /// \return The size of the last dimension, or \a def if there's only one.
+    std::size_t group(std::size_t def) const {return m_group ? m_group : def;}
+
+private:
+    std::vector<unsigned int> m_values;
+    std::size_t m_group;
+};
+
+/// Lets other Python threads run for as long as it lives, if the work done in
+/// its scope is large enough to be worth it. This is how the bindings decide:
+/// - Operations on single objects keep the GIL. They take less time than
+///   handing it over does, not to mention getting it back once other threads
+///   are busy, which can take up to sys.getswitchinterval().
+/// - Operations whose work grows with their input release it around the C++
+///   work, once that input reaches D_PYGLM_GIL_THRESHOLD floats. That's the
+///   batches over buffers, VectorArray, toBinary and fromBinary.
+/// - So do sampling a clip and TransformHierarchy's update and setLocals,
+///   counting the floats of a sample or of the matrices to recompute. The
+///   cursors of the former and the dirty flags of the latter are state which
+///   two threads updating at once would corrupt, so each instance guards its
+///   own with a mutex, which every method touching that state takes. Those
+///   working without the GIL take it once the GIL is gone and release it
+///   before getting the GIL back, so that whoever holds the mutex never waits
+///   for the GIL and the two can't deadlock.
+/// - Tracks keep it: a sample only goes through a pair of keyframes.
+///
+/// Modifying a buffer or VectorArray from one thread while another one works
+/// on it is a race, just like it is with numpy arrays, but never touches
+/// freed memory.
+/// \note Nothing may touch a Python object in its scope, not even to drop a
+///       reference: read all arguments into C++ values or buffers first, and
+///       copy whatever could be changed by other threads meanwhile, such as
+///       the value held by self. Buffers are fine, as exporting them keeps
+///       their owners from resizing them, and so are the arrays held by
+///       VectorArray, which never change size.
+class AllowThreads {
+public:
+    /// \param floats The amount of floats the work goes through.
+    explicit AllowThreads(std::size_t floats)
+        : m_state(floats >= D_PYGLM_GIL_THRESHOLD ? PyEval_SaveThread() : 0)
+    { }
+
+    ~AllowThreads()
+    {
+        if(m_state) {
+            PyEval_RestoreThread(m_state);
+        }
+    }
+
+private:
+    AllowThreads(const AllowThreads&);
+    AllowThreads& operator=(const AllowThreads&);
+
+    PyThreadState* m_state;
+};
+
+#endif // PYGLM_UTIL_WRAP_H
@@ -36,13 +36,14 @@ namespace PyGlMath {
 ////////////////////////////////////////////
 
 Vector::Vector()
-    : m_v(4, 0.0f)
 {
+    m_v[0] = 0.0f;
+    m_v[1] = 0.0f;
+    m_v[2] = 0.0f;
     m_v[3] = 1.0f;
 }
 
 Vector::Vector(const float in_v[3])
-    : m_v(4)
 {
     m_v[0] = in_v[0];
     m_v[1] = in_v[1];
@@ -50,27 +51,7 @@ Vector::Vector(const float in_v[3])
     m_v[3] = 1.0f;
 }
 
-Vector::Vector(const Vector& in_v)
-    : m_v(4)
-{
-    m_v[0] = in_v.x();
-    m_v[1] = in_v.y();
-    m_v[2] = in_v.z();
-    m_v[3] = 1.0f;
-}
-
-const Vector& Vector::operator=(const Vector& in_v)
-{
-    m_v[0] = in_v.x();
-    m_v[1] = in_v.y();
-    m_v[2] = in_v.z();
-    m_v[3] = 1.0f;
-
-    return *this;
-}
-
 Vector::Vector(float in_fX, float in_fY, float in_fZ)
-    : m_v(4)
 {
     m_v[0] = in_fX;
     m_v[1] = in_fY;
@@ -79,7 +60,6 @@ Vector::Vector(float in_fX, float in_fY, float in_fZ)
 }
 
 Vector::Vector(float in_fX, float in_fY, float in_fZ, float in_fW)
-    : m_v(4)
 {
     m_v[0] = in_fX;
     m_v[1] = in_fY;
@@ -88,7 +68,6 @@ Vector::Vector(float in_fX, float in_fY, float in_fZ, float in_fW)
 }
 
 Vector::Vector(const Vector& in_v, float in_fW)
-    : m_v(4)
 {
     m_v[0] = in_v.x();
     m_v[1] = in_v.y();
@@ -97,28 +76,13 @@ Vector::Vector(const Vector& in_v, float in_fW)
 }
 
 Vector::Vector(const std::vector<float>& in_v)
-    : m_v(4)
 {
+    m_v[0] = m_v[1] = m_v[2] = m_v[3] = 0.0f;
     for(std::vector<float>::size_type i = 0 ; i < 4 && i < in_v.size() ; ++i) {
         m_v[i] = in_v.at(i);
     }
 }
 
-#ifdef BOUGE_COMPILE_CPP0X
-Vector::Vector(Vector&& in_v)
-    : m_v(std::move(in_v.m_v))
-{ }
-
-const Vector& Vector::operator=(Vector&& in_v)
-{
-    m_v = std::move(in_v.m_v);
-    return *this;
-}
-#endif // BOUGE_COMPILE_CPP0X
-
-Vector::~Vector()
-{ }
-
 ///////////////////////////////////////
 // Conversion methods and operators. //
 ///////////////////////////////////////
@@ -24,6 +24,8 @@
 #ifndef PYGLM_VECTOR_H
 #define PYGLM_VECTOR_H
 
+#include "Util.hpp"
+
 #include <string>
 #include <vector>
 
@@ -77,23 +79,9 @@ public:
     /// \param in_end An iterator pointing to one element past the last we can use.
     template<class FloatIterator>
     Vector(FloatIterator in_begin, const FloatIterator& in_end);
-    /// Copies a vector.
-    /// \param in_v The vector to be copied.
-    Vector(const Vector& in_v);
-    /// Copies a vector.
-    /// \param in_v The vector to be copied.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const Vector& operator=(const Vector& in_v);
-#ifdef BOUGE_COMPILE_CPP0X
-    /// Moves a vector.
-    /// \param in_v The vector to be moved.
-    Vector(Vector&& in_v);
-    /// Moves a vector.
-    /// \param in_v The vector to be moved.
-    /// \return a const reference to myself that might be used as a rvalue.
-    const Vector& operator=(Vector&& in_v);
-#endif // BOUGE_COMPILE_CPP0X
-    ~Vector();
+
+    // Copying, assignment and destruction are left to the compiler: the data
+    // lives inline, so a vector is trivially copyable and never allocates.
 
     ///////////////////////////////////////
     // Conversion methods and operators. //
@@ -103,8 +91,11 @@ public:
     ///         three components of this vector.
     inline const float *array3f() const {return &m_v[0];};
     /// \return A read-only array of four floats holding the values of the
-    ///         three components of this vector and the w component set to 1.0f.
+    ///         three components of this vector and the w component.
     inline const float *array4f() const {return &m_v[0];};
+    /// \return A writable array of four floats holding the values of the
+    ///         three components of this vector and the w component.
+    inline float *array4f() {return &m_v[0];};
     /// \return A read-only stl vector holding the values.
 
     /// \return A string-representation of the vector.
@@ -242,8 +233,9 @@ private:
     /// The three components of the vector.
     /// \note this array actually holds four components in case it needs to be
     ///       given to a function that requires that. The fourth component is
-    ///       always one though.
-    std::vector<float> m_v;
+    ///       one unless given to a constructor or written through array4f,
+    ///       and copies keep it as it is.
+    D_PYGLM_ALIGN(16) float m_v[4];
 };
 
 ///////////////////////////
@@ -48,8 +48,9 @@ T& operator>>(T& f, Vector& v) {
 
 template<class FloatIterator>
 Vector::Vector(FloatIterator in_begin, const FloatIterator& in_end)
-    : m_v(4)
 {
+    m_v[0] = m_v[1] = m_v[2] = m_v[3] = 0.0f;
+
     FloatIterator iter = in_begin;
     for(int i = 0 ; i < 4 && iter != in_end ; ++i, ++iter) {
         m_v[i] = *iter;
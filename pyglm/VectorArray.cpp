@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#include "VectorArray.hpp"
+#include "Vector.hpp"
+#include "Util.hpp"
+
+#include <cmath>
+
+namespace {
+
+// The kernels doing the actual work. They are plain loops without branches or
+// calls in them, over restrict-qualified arguments (compilers only reliably
+// honour restrict on function parameters), so that the compiler vectorizes
+// them. Each of them works on n floats or vectors.
+
+void add(std::size_t n, const float * D_PYGLM_RESTRICT a, const float * D_PYGLM_RESTRICT b, float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = a[i] + b[i];
+    }
+}
+
+void sub(std::size_t n, const float * D_PYGLM_RESTRICT a, const float * D_PYGLM_RESTRICT b, float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = a[i] - b[i];
+    }
+}
+
+void mul(std::size_t n, const float * D_PYGLM_RESTRICT a, const float * D_PYGLM_RESTRICT b, float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = a[i] * b[i];
+    }
+}
+
+void scale(std::size_t n, const float * D_PYGLM_RESTRICT a, float f, float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = a[i] * f;
+    }
+}
+
+void lerp(std::size_t n, const float * D_PYGLM_RESTRICT a, const float * D_PYGLM_RESTRICT b, float t, float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = a[i] + (b[i] - a[i])*t;
+    }
+}
+
+void cross(std::size_t n,
+           const float * D_PYGLM_RESTRICT ax, const float * D_PYGLM_RESTRICT ay, const float * D_PYGLM_RESTRICT az,
+           const float * D_PYGLM_RESTRICT bx, const float * D_PYGLM_RESTRICT by, const float * D_PYGLM_RESTRICT bz,
+           float * D_PYGLM_RESTRICT rx, float * D_PYGLM_RESTRICT ry, float * D_PYGLM_RESTRICT rz)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        rx[i] = ay[i]*bz[i] - az[i]*by[i];
+        ry[i] = az[i]*bx[i] - ax[i]*bz[i];
+        rz[i] = ax[i]*by[i] - ay[i]*bx[i];
+    }
+}
+
+void dot(std::size_t n,
+         const float * D_PYGLM_RESTRICT ax, const float * D_PYGLM_RESTRICT ay, const float * D_PYGLM_RESTRICT az,
+         const float * D_PYGLM_RESTRICT bx, const float * D_PYGLM_RESTRICT by, const float * D_PYGLM_RESTRICT bz,
+         float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
+    }
+}
+
+void len(std::size_t n, const float * D_PYGLM_RESTRICT x, const float * D_PYGLM_RESTRICT y, const float * D_PYGLM_RESTRICT z, float * D_PYGLM_RESTRICT r)
+{
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        r[i] = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+    }
+}
+
+// Normalizes all vectors which are neither nearly zero nor of nearly zero
+// length, those are left untouched and need Vector::normalize's special
+// treatment. Returns how many of those there are.
+std::size_t normalize(std::size_t n, float * D_PYGLM_RESTRICT x, float * D_PYGLM_RESTRICT y, float * D_PYGLM_RESTRICT z)
+{
+    const float eps = D_PYGLM_EPSILON;
+    std::size_t nspecial = 0;
+
+    for(std::size_t i = 0 ; i < n ; ++i) {
+        float l = std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+        float largest = std::max(std::max(std::abs(x[i]), std::abs(y[i])), std::abs(z[i]));
+        int special = (largest < eps) | (l < eps);
+        float keep = static_cast<float>(special);
+        float m = keep + (1.0f - keep) / std::max(l, eps);
+        nspecial += special;
+        x[i] *= m;
+        y[i] *= m;
+        z[i] *= m;
+    }
+
+    return nspecial;
+}
+
+}
+
+namespace PyGlMath {
+
+////////////////////////////////////////////
+// Constructors and assignment operators. //
+////////////////////////////////////////////
+
+VectorArray::VectorArray()
+    : m_n(0)
+{ }
+
+VectorArray::VectorArray(std::size_t in_n)
+    : m_n(in_n)
+    , m_data(3*in_n, 0.0f)
+{ }
+
+void VectorArray::swap(VectorArray& in_other)
+{
+    std::swap(m_n, in_other.m_n);
+    m_data.swap(in_other.m_data);
+}
+
+/////////////////////////////////////
+// Accessors, getters and setters. //
+/////////////////////////////////////
+
+Vector VectorArray::get(std::size_t idx) const
+{
+    return Vector(m_data[idx], m_data[m_n + idx], m_data[2*m_n + idx]);
+}
+
+void VectorArray::set(std::size_t idx, const Vector& in_v)
+{
+    m_data[idx] = in_v.x();
+    m_data[m_n + idx] = in_v.y();
+    m_data[2*m_n + idx] = in_v.z();
+}
+
+////////////////////////////////
+// Basic Vector calculations. //
+////////////////////////////////
+
+VectorArray VectorArray::operator +(const VectorArray& in_a) const
+{
+    VectorArray result(m_n);
+    ::add(3*m_n, this->data(), in_a.data(), result.x());
+    return result;
+}
+
+VectorArray VectorArray::operator -(const VectorArray& in_a) const
+{
+    VectorArray result(m_n);
+    ::sub(3*m_n, this->data(), in_a.data(), result.x());
+    return result;
+}
+
+VectorArray VectorArray::operator *(float in_f) const
+{
+    VectorArray result(m_n);
+    ::scale(3*m_n, this->data(), in_f, result.x());
+    return result;
+}
+
+VectorArray VectorArray::operator *(const VectorArray& in_a) const
+{
+    VectorArray result(m_n);
+    ::mul(3*m_n, this->data(), in_a.data(), result.x());
+    return result;
+}
+
+VectorArray VectorArray::cross(const VectorArray& in_a) const
+{
+    VectorArray result(m_n);
+    ::cross(m_n, this->x(), this->y(), this->z(), in_a.x(), in_a.y(), in_a.z(), result.x(), result.y(), result.z());
+    return result;
+}
+
+void VectorArray::dot(const VectorArray& in_a, float *out_dots) const
+{
+    ::dot(m_n, this->x(), this->y(), this->z(), in_a.x(), in_a.y(), in_a.z(), out_dots);
+}
+
+///////////////////////////////////////
+// Vector length related operations. //
+///////////////////////////////////////
+
+void VectorArray::len(float *out_lens) const
+{
+    ::len(m_n, this->x(), this->y(), this->z(), out_lens);
+}
+
+VectorArray& VectorArray::normalize()
+{
+    std::size_t nspecial = ::normalize(m_n, this->x(), this->y(), this->z());
+
+    // The few vectors left over by the vectorized pass get handled one by one.
+    for(std::size_t i = 0 ; nspecial > 0 && i < m_n ; ++i) {
+        Vector v = this->get(i);
+        if((nearZero(v.x()) && nearZero(v.y()) && nearZero(v.z())) || nearZero(v.len())) {
+            this->set(i, v.normalize());
+            --nspecial;
+        }
+    }
+
+    return *this;
+}
+
+//////////////////////////////////////
+// Vector interpolation operations. //
+//////////////////////////////////////
+
+VectorArray VectorArray::lerp(const VectorArray& in_a, float between) const
+{
+    VectorArray result(m_n);
+    ::lerp(3*m_n, this->data(), in_a.data(), between, result.x());
+    return result;
+}
+
+} // namespace PyGlMath
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////
+//
+// Bouge - Modern and flexible skeletal animation library
+// Copyright (C) 2010 Lucas Beyer (pompei2@gmail.com)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef PYGLM_VECTORARRAY_H
+#define PYGLM_VECTORARRAY_H
+
+#include "Util.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PyGlMath {
+    class Vector;
+
+/// This class holds many vectors at once, for doing the same operation on all
+/// of them in one go. The components are stored as a structure of arrays: first
+/// all X components, then all Y components and then all Z components, each
+/// block being contiguous. This is what lets the compiler turn the loops
+/// into SIMD code, four or eight vectors at a time.\n
+/// All operations have the same semantics as their counterpart in Vector.
+/// \note Only the first three components of the vectors are stored. The w
+///       component of the vectors coming out of it is always 1.
+/// \note All operations taking another array assume both have the same size.
+class VectorArray {
+public:
+    ////////////////////////////////////////////
+    // Constructors and assignment operators. //
+    ////////////////////////////////////////////
+
+    /// Creates an empty array.
+    VectorArray();
+    /// Creates an array of \a in_n zero-vectors.
+    /// \param in_n The amount of vectors in the array.
+    explicit VectorArray(std::size_t in_n);
+
+    /// Exchanges the contents of this array with those of \a in_other, without copying.
+    /// \param in_other The array to swap contents with.
+    void swap(VectorArray& in_other);
+
+    /////////////////////////////////////
+    // Accessors, getters and setters. //
+    /////////////////////////////////////
+
+    /// \return The amount of vectors held in this array.
+    inline std::size_t size() const {return m_n;};
+
+    /// \return The contiguous block of all X components.
+    inline float *x() {return m_n ? &m_data[0] : 0;};
+    /// \return The contiguous block of all Y components.
+    inline float *y() {return m_n ? &m_data[m_n] : 0;};
+    /// \return The contiguous block of all Z components.
+    inline float *z() {return m_n ? &m_data[2*m_n] : 0;};
+    /// \return The contiguous block of all X components.
+    inline const float *x() const {return m_n ? &m_data[0] : 0;};
+    /// \return The contiguous block of all Y components.
+    inline const float *y() const {return m_n ? &m_data[m_n] : 0;};
+    /// \return The contiguous block of all Z components.
+    inline const float *z() const {return m_n ? &m_data[2*m_n] : 0;};
+    /// \return All the data: the X block followed by the Y and the Z block.
+    inline const float *data() const {return m_n ? &m_data[0] : 0;};
+    /// \return All the data: the X block followed by the Y and the Z block.
+    inline float *data() {return m_n ? &m_data[0] : 0;};
+
+    /// \param idx The index of the vector to get, it must be less than size().
+    /// \return A copy of the vector at index \a idx.
+    Vector get(std::size_t idx) const;
+    /// \param idx The index of the vector to set, it must be less than size().
+    /// \param in_v The vector to store at index \a idx.
+    void set(std::size_t idx, const Vector& in_v);
+
+    ////////////////////////////////
+    // Basic Vector calculations. //
+    ////////////////////////////////
+
+    /// \return The element-wise sum of this and \a in_a.
+    VectorArray operator +(const VectorArray& in_a) const;
+    /// \return The element-wise difference of this and \a in_a.
+    VectorArray operator -(const VectorArray& in_a) const;
+    /// \return All vectors of this array scaled by \a in_f.
+    VectorArray operator *(float in_f) const;
+    /// \return The element-wise, component-wise product of this and \a in_a.
+    VectorArray operator *(const VectorArray& in_a) const;
+
+    /// \return The element-wise cross products of this and \a in_a.
+    VectorArray cross(const VectorArray& in_a) const;
+    /// \param out_dots Where to write the size() element-wise dot products of this and \a in_a.
+    void dot(const VectorArray& in_a, float *out_dots) const;
+
+    ///////////////////////////////////////
+    // Vector length related operations. //
+    ///////////////////////////////////////
+
+    /// \param out_lens Where to write the size() lengths of the vectors.
+    void len(float *out_lens) const;
+    /// Normalizes all vectors of this array.
+    /// \return a reference to *this
+    VectorArray& normalize();
+
+    //////////////////////////////////////
+    // Vector interpolation operations. //
+    //////////////////////////////////////
+
+    /// \return The element-wise linear interpolation between this and \a in_a at time \a between.
+    VectorArray lerp(const VectorArray& in_a, float between) const;
+
+private:
+    /// The amount of vectors held.
+    std::size_t m_n;
+    /// All X components, followed by all Y components, followed by all Z components.
+    std::vector<float> m_data;
+};
+
+} // namespace PyGlMath
+
+#endif // PYGLM_VECTORARRAY_H
@@ -0,0 +1,280 @@
+#include "VectorArray_wrap.hpp"
+#include "Vector_wrap.hpp"
+#include "Util_wrap.hpp"
+
+namespace {
+
+// What the VectorArray constructor and item assignment complain with.
+const char* const vector_errmsg = "A VectorArray can only hold Vectors or sequences of up to three numbers.";
+
+// The other operand of all binary operations, which needs to be of the same size.
+const PyGlMath::VectorArray& same_sized(const PyGlMath::VectorArray& self, const Py::Object& o, const char* errmsg)
+{
+    if(!VectorArray::check(o)) {
+        throw Py::TypeError(errmsg);
+    }
+
+    VectorArray::VectorArrayObject other(o);
+    const PyGlMath::VectorArray& a = other.getCxxObject()->m_arr;
+    if(a.size() != self.size()) {
+        throw Py::ValueError("Both VectorArrays need to be of the same size.");
+    }
+
+    return a;
+}
+
+}
+
+bool is_vector_array(PyObject* o)
+{
+    return VectorArray::check(o);
+}
+
+VectorArray::VectorArray(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
+    : Py::PythonClass<VectorArray>::PythonClass(self, args, kwds)
+    , m_arr()
+{
+    if(args.length() == 0 && kwds.length() == 0) {
+        // no-op, empty.
+    } else if(args.length() == 1 && kwds.length() == 0 && args[0].isSequence()) {
+        Py::Sequence s(args[0]);
+        PyGlMath::VectorArray arr;
+        try {
+            PyGlMath::VectorArray(s.length()).swap(arr);
+        } catch(...) {
+            rethrow_as_memory_error();
+        }
+        for(Py::Sequence::size_type i = 0 ; i < s.length() ; ++i) {
+            arr.set(i, vector_from(s[i], vector_errmsg));
+        }
+        m_arr.swap(arr);
+    } else if(args.length() == 1 && kwds.length() == 0 && !Vector::check(args[0])) {
+        long n = Py::Long(args[0]);
+        if(n < 0) {
+            throw Py::ValueError("A VectorArray can't hold a negative amount of vectors.");
+        }
+        try {
+            PyGlMath::VectorArray(n).swap(m_arr);
+        } catch(...) {
+            rethrow_as_memory_error();
+        }
+    } else {
+        throw Py::ValueError("VectorArray takes either the amount of zero-vectors to hold or a sequence of Vectors.");
+    }
+}
+
+VectorArray::VectorArray(Py::PythonClassInstance *self, PyGlMath::VectorArray* a)
+    : Py::PythonClass<VectorArray>::PythonClass(self, no_args(), no_kwds())
+    , m_arr()
+{
+    m_arr.swap(*a);
+}
+
+VectorArray::VectorArrayObject VectorArray::make_inst(PyGlMath::VectorArray& a)
+{
+    return make_wrapped_inst<VectorArray>(&a);
+}
+
+VectorArray::~VectorArray()
+{ }
+
+void VectorArray::init_type()
+{
+    behaviors().name("VectorArray");
+    behaviors().doc("Many vectors stored component-wise, for doing the same operation on all of them at once.");
+    behaviors().supportRepr();
+    behaviors().supportSequenceType();
+    behaviors().supportNumberType();
+    support_float_buffer<VectorArray>(behaviors());
+
+    PYCXX_ADD_VARARGS_METHOD(cross, cross, "Element-wise cross product of this array with another one of the same size. Results in a new array.");
+    PYCXX_ADD_VARARGS_METHOD(dot, dot, "Element-wise dot product of this array with another one of the same size. Results in an array.array of floats.");
+    PYCXX_ADD_NOARGS_METHOD(len, len, "Returns the lengths of all vectors as an array.array of floats.");
+    PYCXX_ADD_NOARGS_METHOD(normalize, normalize, "Normalizes (gives unit length to) all the vectors of the array itself, returns nothing.");
+    PYCXX_ADD_KEYWORDS_METHOD(lerp, lerp, "Returns a new array which is the element-wise linear interpolation between self and the first argument 'other' at the second argument 'between'.");
+
+    // Call to make the type ready for use
+    behaviors().readyType();
+}
+
+FloatBuffer VectorArray::float_buffer()
+{
+    // Indexed as [component, vector], which is how the components are stored.
+    m_shape[0] = 3;
+    m_shape[1] = m_arr.size();
+    m_strides[0] = m_arr.size()*sizeof(float);
+    m_strides[1] = sizeof(float);
+    m_size = 3*m_arr.size();
+    FloatBuffer b = {m_arr.data(), 2, m_shape, m_strides, &m_size, false};
+    return b;
+}
+
+Py::Object VectorArray::repr()
+{
+    std::OSTRSTREAM ss;
+    ss << "VectorArray(" << m_arr.size() << " vectors)";
+    return Py::String(ss.str());
+}
+
+int VectorArray::sequence_length()
+{
+    return static_cast<int>(m_arr.size());
+}
+
+Py::Object VectorArray::sequence_item(Py_ssize_t i)
+{
+    if(i < 0 || static_cast<std::size_t>(i) >= m_arr.size()) {
+        throw Py::IndexError("VectorArray index out of range");
+    }
+
+    return Vector::make_inst(m_arr.get(i));
+}
+
+int VectorArray::sequence_ass_item(Py_ssize_t i, const Py::Object& value)
+{
+    if(i < 0 || static_cast<std::size_t>(i) >= m_arr.size()) {
+        throw Py::IndexError("VectorArray assignment index out of range");
+    }
+
+    m_arr.set(i, vector_from(value, vector_errmsg));
+    return 0;
+}
+
+Py::Object VectorArray::number_add(const Py::Object& other_)
+{
+    const PyGlMath::VectorArray& other = same_sized(m_arr, other_, "expecting VectorArray object for addition");
+    PyGlMath::VectorArray result;
+    {
+        AllowThreads nogil(3*m_arr.size());
+        result = m_arr + other;
+    }
+    return make_inst(result);
+}
+
+Py::Object VectorArray::number_subtract(const Py::Object& other_)
+{
+    const PyGlMath::VectorArray& other = same_sized(m_arr, other_, "expecting VectorArray object for subtraction");
+    PyGlMath::VectorArray result;
+    {
+        AllowThreads nogil(3*m_arr.size());
+        result = m_arr - other;
+    }
+    return make_inst(result);
+}
+
+Py::Object VectorArray::number_multiply(const Py::Object& other_)
+{
+    PyGlMath::VectorArray result;
+    if(VectorArray::check(other_)) {
+        const PyGlMath::VectorArray& other = same_sized(m_arr, other_, "");
+        {
+            AllowThreads nogil(3*m_arr.size());
+            result = m_arr * other;
+        }
+        return make_inst(result);
+    }
+
+    float f;
+    try {
+        f = Py::Float(other_);
+    } catch(const Py::Exception& ) {
+        throw Py::TypeError("A VectorArray may only be muliplied by a number or element-wise by a VectorArray instance.");
+    }
+
+    {
+        AllowThreads nogil(3*m_arr.size());
+        result = m_arr * f;
+    }
+    return make_inst(result);
+}
+
+Py::Object VectorArray::cross(const Py::Tuple &args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("VectorArray.cross product takes one argument");
+    }
+
+    const PyGlMath::VectorArray& other = same_sized(m_arr, args[0], "VectorArray.cross product can only take a VectorArray as argument");
+    PyGlMath::VectorArray result;
+    {
+        AllowThreads nogil(3*m_arr.size());
+        result = m_arr.cross(other);
+    }
+    return make_inst(result);
+}
+
+Py::Object VectorArray::dot(const Py::Tuple &args)
+{
+    if(args.length() != 1) {
+        throw Py::TypeError("VectorArray.dot product takes one argument");
+    }
+
+    const PyGlMath::VectorArray& other = same_sized(m_arr, args[0], "VectorArray.dot product takes a VectorArray argument");
+    std::vector<float> dots;
+    resize_or_raise(dots, m_arr.size());
+    {
+        AllowThreads nogil(3*m_arr.size());
+        m_arr.dot(other, dots.empty() ? 0 : &dots[0]);
+    }
+    return float_array(dots.empty() ? 0 : &dots[0], dots.size());
+}
+
+Py::Object VectorArray::len()
+{
+    std::vector<float> lens;
+    resize_or_raise(lens, m_arr.size());
+    {
+        AllowThreads nogil(3*m_arr.size());
+        m_arr.len(lens.empty() ? 0 : &lens[0]);
+    }
+    return float_array(lens.empty() ? 0 : &lens[0], lens.size());
+}
+
+Py::Object VectorArray::normalize()
+{
+    {
+        AllowThreads nogil(3*m_arr.size());
+        m_arr.normalize();
+    }
+    return Py::None();
+}
+
+Py::Object VectorArray::lerp(const Py::Tuple& args, const Py::Dict& kwargs)
+{
+    if(args.length() + kwargs.length() != 2) {
+        throw Py::ValueError("VectorArray.lerp takes two arguments: first ('other') another array of the same size and second ('between') a number.");
+    }
+
+    Py::Object other_arg;
+    if(args.length() > 0) {
+        other_arg = args[0];
+    } else if(kwargs.hasKey("other")) {
+        other_arg = kwargs.getItem("other");
+    } else {
+        throw Py::ValueError("VectorArray.lerp needs the 'other' argument");
+    }
+
+    Py::Object between_arg;
+    if(args.length() == 2) {
+        between_arg = args[1];
+    } else if(kwargs.hasKey("between")) {
+        between_arg = kwargs.getItem("between");
+    } else {
+        throw Py::ValueError("VectorArray.lerp needs the 'between' argument.");
+    }
+
+    const PyGlMath::VectorArray& other = same_sized(m_arr, other_arg, "VectorArray.lerp takes a VectorArray as first argument");
+    float between;
+    try {
+        between = Py::Float(between_arg);
+    } catch(const Py::Exception& ) {
+        throw Py::TypeError("The second argument to VectorArray.lerp ('between') needs to be a numeric value.");
+    }
+
+    PyGlMath::VectorArray result;
+    {
+        AllowThreads nogil(3*m_arr.size());
+        result = m_arr.lerp(other, between);
+    }
+    return make_inst(result);
+}
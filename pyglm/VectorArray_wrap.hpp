@@ -0,0 +1,54 @@
+#include "VectorArray.hpp"
+
+#include "CXX/Objects.hxx"
+#include "CXX/Extensions.hxx"
+
+#include "Util_wrap.hpp"
+
+class VectorArray : public Py::PythonClass<VectorArray>
+{
+public:
+    VectorArray(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing array without parsing arguments.
+    /// The contents of \a a are swapped in, leaving it empty.
+    VectorArray(Py::PythonClassInstance *self, PyGlMath::VectorArray* a);
+    virtual ~VectorArray();
+
+    static void init_type();
+
+    typedef Py::PythonClassObject<VectorArray> VectorArrayObject;
+    /// \note Takes over the contents of \a a, leaving it empty.
+    static VectorArrayObject make_inst(PyGlMath::VectorArray& a);
+
+    PyGlMath::VectorArray m_arr;
+
+    /// Used by the buffer protocol, \see get_float_buffer.
+    FloatBuffer float_buffer();
+
+private:
+    Py::Object repr();
+
+    int sequence_length();
+    Py::Object sequence_item(Py_ssize_t i);
+    int sequence_ass_item(Py_ssize_t i, const Py::Object& value);
+
+    Py::Object number_add(const Py::Object& other_);
+    Py::Object number_subtract(const Py::Object& other_);
+    Py::Object number_multiply(const Py::Object& other_);
+
+    Py::Object cross(const Py::Tuple &args);
+    PYCXX_VARARGS_METHOD_DECL(VectorArray, cross);
+    Py::Object dot(const Py::Tuple &args);
+    PYCXX_VARARGS_METHOD_DECL(VectorArray, dot);
+    Py::Object len();
+    PYCXX_NOARGS_METHOD_DECL(VectorArray, len);
+    Py::Object normalize();
+    PYCXX_NOARGS_METHOD_DECL(VectorArray, normalize);
+    Py::Object lerp(const Py::Tuple& args, const Py::Dict& kwargs);
+    PYCXX_KEYWORDS_METHOD_DECL(VectorArray, lerp);
+
+    /// The layout exported through the buffer protocol, \see float_buffer.
+    Py_ssize_t m_shape[2];
+    Py_ssize_t m_strides[2];
+    Py_ssize_t m_size;
+};
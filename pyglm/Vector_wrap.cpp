@@ -1,4 +1,6 @@
 #include "Vector_wrap.hpp"
+#include "Util_wrap.hpp"
+#include "Swizzle_wrap.hpp"
 
 Vector::Vector(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
     : Py::PythonClass<Vector>::PythonClass(self, args, kwds)
@@ -24,26 +26,63 @@ Vector::Vector(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds)
     }
 }
 
+Vector::Vector(Py::PythonClassInstance *self, const PyGlMath::Vector& v)
+    : Py::PythonClass<Vector>::PythonClass(self, no_args(), no_kwds())
+    , m_vec(v)
+{ }
+
 Vector::VectorObject Vector::make_inst(const PyGlMath::Vector& v)
 {
-    Py::Callable type(Vector::type());
-    return VectorObject(type.apply( Py::TupleN(Py::Float(v.x()), Py::Float(v.y()), Py::Float(v.z())), Py::Dict() ));
+    return make_recycled_inst<Vector>(v);
+}
+
+PyGlMath::Vector vector_from(const Py::Object& o, const char* errmsg, bool uniform)
+{
+    if(Vector::check(o)) {
+        return cxx_object<Vector>(o.ptr())->m_vec;
+    } else if(o.isSequence() && Py::Sequence(o).length() <= 3) {
+        Py::Sequence s(o);
+        float x = s.length() > 0 ? Py::Float(s[0]) : 0.0f;
+        float y = s.length() > 1 ? Py::Float(s[1]) : 0.0f;
+        float z = s.length() > 2 ? Py::Float(s[2]) : 0.0f;
+        return PyGlMath::Vector(x, y, z);
+    } else if(uniform && o.isNumeric()) {
+        float f = Py::Float(o);
+        return PyGlMath::Vector(f, f, f);
+    }
+
+    throw Py::TypeError(errmsg);
 }
 
 Vector::~Vector()
 { }
 
+namespace {
+
+PyGetSetDef vector_getset[] = {
+    {"x", &get_float_attr<Vector>, &set_float_attr<Vector>, "The X component of the vector.", reinterpret_cast<void*>(0)},
+    {"y", &get_float_attr<Vector>, &set_float_attr<Vector>, "The Y component of the vector.", reinterpret_cast<void*>(1)},
+    {"z", &get_float_attr<Vector>, &set_float_attr<Vector>, "The Z component of the vector.", reinterpret_cast<void*>(2)},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+}
+
 void Vector::init_type()
 {
     behaviors().name("Vector");
     behaviors().doc("documentation for Vector class");
-    behaviors().supportGetattro();
-    behaviors().supportSetattro();
     behaviors().supportRichCompare();
     behaviors().supportRepr();
     behaviors().supportStr();
     behaviors().supportHash();
     behaviors().supportNumberType();
+    behaviors().type_object()->tp_as_number->nb_inplace_add = &number_inplace_handler<Vector, &Vector::number_inplace_add>;
+    behaviors().type_object()->tp_as_number->nb_inplace_subtract = &number_inplace_handler<Vector, &Vector::number_inplace_subtract>;
+    behaviors().type_object()->tp_as_number->nb_inplace_multiply = &number_inplace_handler<Vector, &Vector::number_inplace_multiply>;
+    behaviors().set_tp_dealloc(&FreeList<Vector>::dealloc);
+    support_float_buffer<Vector>(behaviors());
+    support_getset(behaviors(), swizzle_getset(vector_getset, 3, &get_swizzle<Vector>, &set_swizzle<Vector>));
 
     PYCXX_ADD_VARARGS_METHOD(cross, cross, "Cross product of this vector with another one. Results in a new vector." );
     PYCXX_ADD_VARARGS_METHOD(dot, dot, "Dot product of this vector with another one. Results in a float." );
@@ -56,39 +95,13 @@ void Vector::init_type()
     behaviors().readyType();
 }
 
-Py::Object Vector::getattro(const Py::String& name_)
-{
-    std::string name(name_.as_std_string("utf-8"));
-
-    if(name == "x") {
-        return Py::Float(m_vec.x());
-    } else if(name == "y") {
-        return Py::Float(m_vec.y());
-    } else if(name == "z") {
-        return Py::Float(m_vec.z());
-    }
-
-    // TODO: support swizzling?
-    return genericGetAttro(name_);
-}
-
-int Vector::setattro(const Py::String& name_, const Py::Object &value)
+FloatBuffer Vector::float_buffer()
 {
-    std::string name(name_.as_std_string("utf-8"));
-
-    if(name == "x") {
-        m_vec.x(Py::Float(value));
-        return 0;
-    } else if(name == "y") {
-        m_vec.y(Py::Float(value));
-        return 0;
-    } else if(name == "z") {
-        m_vec.z(Py::Float(value));
-        return 0;
-    // TODO: support swizzling?
-    } else {
-        return genericSetAttro(name_, value);
-    }
+    // Only x, y and z, just like everywhere else in Python.
+    static Py_ssize_t shape[] = {3};
+    static Py_ssize_t strides[] = {sizeof(float)};
+    FloatBuffer b = {m_vec.array4f(), 1, shape, strides, &shape[0], false};
+    return b;
 }
 
 Py::Object Vector::repr()
@@ -189,6 +202,40 @@ Py::Object Vector::number_multiply(const Py::Object& other_)
     }
 }
 
+bool Vector::number_inplace_add(const Py::Object& other_)
+{
+    if(!Vector::check(other_)) {
+        return false;
+    }
+
+    m_vec += cxx_object<Vector>(other_.ptr())->m_vec;
+    return true;
+}
+
+bool Vector::number_inplace_subtract(const Py::Object& other_)
+{
+    if(!Vector::check(other_)) {
+        return false;
+    }
+
+    m_vec -= cxx_object<Vector>(other_.ptr())->m_vec;
+    return true;
+}
+
+bool Vector::number_inplace_multiply(const Py::Object& other_)
+{
+    float f = 0.0f;
+    if(Vector::check(other_)) {
+        m_vec = m_vec * cxx_object<Vector>(other_.ptr())->m_vec;
+        return true;
+    } else if(plain_number(other_, f)) {
+        m_vec *= f;
+        return true;
+    }
+
+    return false;
+}
+
 Py::Object Vector::cross(const Py::Tuple &args)
 {
     if(args.length() != 1) {
@@ -3,10 +3,14 @@
 #include "CXX/Objects.hxx"
 #include "CXX/Extensions.hxx"
 
+#include "Util_wrap.hpp"
+
 class Vector : public Py::PythonClass<Vector>
 {
 public:
     Vector(Py::PythonClassInstance *self, Py::Tuple &args, Py::Dict &kwds);
+    /// Used by make_inst to wrap an existing vector without parsing arguments.
+    Vector(Py::PythonClassInstance *self, const PyGlMath::Vector& v);
     virtual ~Vector();
 
     static void init_type();
@@ -16,10 +20,10 @@ public:
 
     PyGlMath::Vector m_vec;
 
-private:
-    Py::Object getattro(const Py::String& name_);
-    int setattro(const Py::String& name_, const Py::Object &value);
+    /// Used by the buffer protocol, \see get_float_buffer.
+    FloatBuffer float_buffer();
 
+private:
     Py::Object repr();
     Py::Object str();
     long hash();
@@ -32,6 +36,9 @@ private:
     Py::Object number_add(const Py::Object& other_);
     Py::Object number_subtract(const Py::Object& other_);
     Py::Object number_multiply(const Py::Object& other_);
+    bool number_inplace_add(const Py::Object& other_);
+    bool number_inplace_subtract(const Py::Object& other_);
+    bool number_inplace_multiply(const Py::Object& other_);
 
     Py::Object cross(const Py::Tuple &args);
     PYCXX_VARARGS_METHOD_DECL(Vector, cross);
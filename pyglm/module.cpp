@@ -1,5 +1,16 @@
 #include "Vector_wrap.hpp"
 #include "Quaternion_wrap.hpp"
+#include "Matrix_wrap.hpp"
+#include "VectorArray_wrap.hpp"
+#include "BinaryFormat_wrap.hpp"
+#include "MappedAffineMatrices_wrap.hpp"
+#include "Transform_wrap.hpp"
+#include "TransformHierarchy_wrap.hpp"
+#include "DualQuaternion_wrap.hpp"
+#include "Animation_wrap.hpp"
+#include "Skinning_wrap.hpp"
+#include "Util_wrap.hpp"
+#include "ThreadPool.hpp"
 
 #include "CXX/Objects.hxx"
 #include "CXX/Extensions.hxx"
@@ -12,13 +23,48 @@ public:
     {
         Vector::init_type();
         Quaternion::init_type();
+        AffineMatrix::init_type();
+        General4x4Matrix::init_type();
+        VectorArray::init_type();
+        MappedAffineMatrices::init_type();
+        Transform::init_type();
+        TransformHierarchy::init_type();
+        DualQuaternion::init_type();
+        VectorTrack::init_type();
+        QuaternionTrack::init_type();
+        AnimationClip::init_type();
 
         add_keyword_method("rotQ", &pyglm_module::rotationQ, "Creates a quaternion representing a rotation around an axis 'axis' by an angle of 'angle'.");
+        add_varargs_method("translation", &pyglm_module::translation, "Creates an AffineMatrix representing a translation by three numbers or a Vector.");
+        add_keyword_method("rotation", &pyglm_module::rotation, "Creates an AffineMatrix representing the rotation given as a Quaternion or as the arguments to the Quaternion constructor.");
+        add_varargs_method("scale", &pyglm_module::scale, "Creates an AffineMatrix representing a uniform (one number) or non-uniform (three numbers or a Vector) scaling.");
+        add_varargs_method("transformation", &pyglm_module::transformation, "Creates an AffineMatrix which rotates, scales and then translates: transformation(translation, rotation[, scale]).");
+        add_noargs_method("threads", &pyglm_module::threads, "Returns how many threads the batch operations (transformPoints, rotate, nlerp, slerp, skin, AnimationClip.sample) split large batches over, counting the calling one.");
+        add_varargs_method("setThreads", &pyglm_module::setThreads, "Sets how many threads the batch operations split large batches over: setThreads(n), 1 running everything on the calling thread and 0 meaning one per core, which is the default. At most eight per core, but at least 64.");
+        add_noargs_method("freeListStats", &pyglm_module::freeListStats, "Returns, per type, the 'hits', 'misses', current 'size' and 'capacity' of the list of instances kept for reuse.");
+        add_keyword_method("perspectiveProjection", &pyglm_module::perspectiveProjection, "Creates a General4x4Matrix holding a perspective projection: perspectiveProjection(fov, aspect, near=2.5, far=1000).");
+        add_keyword_method("nlerp", &pyglm_module::nlerp, "Interpolates many pairs of quaternions at once, each at its own time: nlerp(q1, q2, between, out=None). Takes buffers of floats (x y z w ...) and writes to 'out', which may be 'q1' or 'q2', or returns an array.array if not given.");
+        add_keyword_method("rotate", &pyglm_module::rotate, "Rotates many vectors at once, each by its own quaternion: rotate(q, v, out=None). Takes buffers of floats (x y z w ... and x y z ...) and writes to 'out', which may be 'v', or returns an array.array if not given.");
+        add_keyword_method("slerp", &pyglm_module::slerp, "Same as nlerp, but spherical: slerp(q1, q2, between, out=None). Uses polynomial approximations, within 1e-6 of Quaternion.slerp unless the quaternions are nearly opposite.");
+        add_keyword_method("skin", &pyglm_module::skin, "Skins a mesh: skin(palette, bones, weights, positions, normals=None, out=None, outNormals=None). Takes a sequence of AffineMatrix bones for linear blending, or of DualQuaternion bones for volume-preserving dual quaternion blending, buffers of the same amount of bone indices and weights for each vertex, and buffers of floats (x y z ...) for the positions and normals. Normals are transformed by the inverse transpose of matrices and normalized. Writes to 'out' and 'outNormals', which may be the inputs, or returns array.array objects; a tuple of both if there are normals.");
+        add_keyword_method("dlb", &pyglm_module::dlb, "Blends dual quaternions linearly (DLB): dlb(dualQuaternions, weights). Returns the normalized weighted sum as a DualQuaternion, along the shortest way.");
+        add_keyword_method("toBinary", &pyglm_module::toBinary, "Packs a Vector, Quaternion, AffineMatrix, General4x4Matrix or VectorArray, or a sequence of any one of the first four, into little-endian binary bytes: toBinary(objects, inverses=True). AffineMatrix objects are packed without their inverse if 'inverses' is False.");
+        add_varargs_method("fromBinary", &pyglm_module::fromBinary, "Reads what toBinary wrote from any bytes-like object, such as bytes or mmap. Returns a VectorArray if that's what was packed, a list otherwise. Use MappedAffineMatrices to index into a file of matrices without reading it.");
 
         initialize("documentation for pyglm module");
 
         moduleDictionary()["Vector"] = Vector::type();
         moduleDictionary()["Quaternion"] = Quaternion::type();
+        moduleDictionary()["AffineMatrix"] = AffineMatrix::type();
+        moduleDictionary()["General4x4Matrix"] = General4x4Matrix::type();
+        moduleDictionary()["VectorArray"] = VectorArray::type();
+        moduleDictionary()["MappedAffineMatrices"] = MappedAffineMatrices::type();
+        moduleDictionary()["Transform"] = Transform::type();
+        moduleDictionary()["TransformHierarchy"] = TransformHierarchy::type();
+        moduleDictionary()["DualQuaternion"] = DualQuaternion::type();
+        moduleDictionary()["VectorTrack"] = VectorTrack::type();
+        moduleDictionary()["QuaternionTrack"] = QuaternionTrack::type();
+        moduleDictionary()["AnimationClip"] = AnimationClip::type();
     }
 
     virtual ~pyglm_module()
@@ -35,6 +81,99 @@ public:
             return Quaternion::QuaternionObject(type.apply(args, kwargs));
         }
     }
+
+    Py::Object translation(const Py::Tuple& args)
+    {
+        return AffineMatrix::translation(args);
+    }
+
+    Py::Object rotation(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return AffineMatrix::rotation(args, kwargs);
+    }
+
+    Py::Object scale(const Py::Tuple& args)
+    {
+        return AffineMatrix::scale(args);
+    }
+
+    Py::Object transformation(const Py::Tuple& args)
+    {
+        return AffineMatrix::transformation(args);
+    }
+
+    Py::Object perspectiveProjection(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return General4x4Matrix::perspectiveProjection(args, kwargs);
+    }
+
+    Py::Object nlerp(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return Quaternion::nlerpBuffers(args, kwargs);
+    }
+
+    Py::Object slerp(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return Quaternion::slerpBuffers(args, kwargs);
+    }
+
+    Py::Object rotate(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return Quaternion::rotateBuffers(args, kwargs);
+    }
+
+    Py::Object skin(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return ::skin(args, kwargs);
+    }
+
+    Py::Object dlb(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return DualQuaternion::blend(args, kwargs);
+    }
+
+    Py::Object toBinary(const Py::Tuple& args, const Py::Dict& kwargs)
+    {
+        return to_binary(args, kwargs);
+    }
+
+    Py::Object fromBinary(const Py::Tuple& args)
+    {
+        return from_binary(args);
+    }
+
+    Py::Object threads()
+    {
+        return Py::Long(static_cast<long>(PyGlMath::ThreadPool::instance().threads()));
+    }
+
+    Py::Object setThreads(const Py::Tuple& args)
+    {
+        if(args.length() != 1) {
+            throw Py::ValueError("setThreads takes the amount of threads, 0 meaning one per core.");
+        } else if(!PyLong_Check(args[0].ptr())) {
+            throw Py::TypeError("setThreads takes the amount of threads as an integer.");
+        }
+
+        int overflow = 0;
+        const long n = PyLong_AsLongAndOverflow(args[0].ptr(), &overflow);
+        const std::size_t most = PyGlMath::ThreadPool::maxThreads();
+        if(overflow || n < 0 || static_cast<unsigned long>(n) > most) {
+            std::OSTRSTREAM ss;
+            ss << "setThreads takes the amount of threads, from 1 to " << most << ", or 0 meaning one per core.";
+            throw Py::ValueError(ss.str());
+        }
+        PyGlMath::ThreadPool::instance().threads(static_cast<std::size_t>(n));
+        return Py::None();
+    }
+
+    Py::Object freeListStats()
+    {
+        Py::Dict stats;
+        stats["Vector"] = FreeList<Vector>::stats();
+        stats["Quaternion"] = FreeList<Quaternion>::stats();
+        return stats;
+    }
 };
 
 #if defined( _WIN32 )
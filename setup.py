@@ -5,6 +5,10 @@ from distutils.core import setup, Extension
 support_dir = os.path.normpath(os.path.join('.', 'embedded-pycxx-6.2.4', 'Src'))
 
 CXX_libraries = ['stdc++','m'] if os.name == 'posix' else []
+# Lets sqrt be vectorized, we never look at errno anyways. The thread pool
+# needs C++11 threads.
+CXX_compile_args = ['-fno-math-errno', '-std=c++11', '-pthread'] if os.name == 'posix' else []
+CXX_link_args = ['-pthread'] if os.name == 'posix' else []
 
 setup(
     name = "pyglm",
@@ -19,6 +23,8 @@ setup(
         Extension(
             'pyglm',
             include_dirs = ['embedded-pycxx-6.2.4'],
+            extra_compile_args = CXX_compile_args,
+            extra_link_args = CXX_link_args,
             sources = [
                 os.path.join('pyglm', 'module.cpp'),
                 os.path.join('pyglm', 'Vector.cpp'),
@@ -26,6 +32,25 @@ setup(
                 os.path.join('pyglm', 'Quaternion.cpp'),
                 os.path.join('pyglm', 'Quaternion_wrap.cpp'),
                 os.path.join('pyglm', 'Matrix.cpp'),
+                os.path.join('pyglm', 'Matrix_wrap.cpp'),
+                os.path.join('pyglm', 'VectorArray.cpp'),
+                os.path.join('pyglm', 'VectorArray_wrap.cpp'),
+                os.path.join('pyglm', 'Swizzle_wrap.cpp'),
+                os.path.join('pyglm', 'BinaryFormat.cpp'),
+                os.path.join('pyglm', 'BinaryFormat_wrap.cpp'),
+                os.path.join('pyglm', 'MappedAffineMatrices.cpp'),
+                os.path.join('pyglm', 'MappedAffineMatrices_wrap.cpp'),
+                os.path.join('pyglm', 'Transform.cpp'),
+                os.path.join('pyglm', 'Transform_wrap.cpp'),
+                os.path.join('pyglm', 'TransformHierarchy.cpp'),
+                os.path.join('pyglm', 'TransformHierarchy_wrap.cpp'),
+                os.path.join('pyglm', 'DualQuaternion.cpp'),
+                os.path.join('pyglm', 'DualQuaternion_wrap.cpp'),
+                os.path.join('pyglm', 'Animation.cpp'),
+                os.path.join('pyglm', 'Animation_wrap.cpp'),
+                os.path.join('pyglm', 'Skinning.cpp'),
+                os.path.join('pyglm', 'Skinning_wrap.cpp'),
+                os.path.join('pyglm', 'ThreadPool.cpp'),
                 os.path.join(support_dir,'cxxsupport.cxx'),
                 os.path.join(support_dir,'cxx_extensions.cxx'),
                 os.path.join(support_dir,'IndirectPythonInterface.cxx'),
@@ -0,0 +1,124 @@
+import unittest
+import array
+import bisect
+
+from pyglm import *
+from helpers import AlmostEqualMixin
+
+# What sampling should result in: a search for the pair of keyframes around t
+# and an interpolation of them, the way it used to be done in Python.
+def reference(times, keys, t, interpolate):
+    if t <= times[0]:
+        return keys[0]
+    if t >= times[-1]:
+        return keys[-1]
+    i = bisect.bisect_right(times, t) - 1
+    return interpolate(keys[i], keys[i+1], (t - times[i]) / (times[i+1] - times[i]))
+
+def slerp(a, b, t):
+    if a.dot(b) < 0:
+        b = Quaternion(-b.x, -b.y, -b.z, -b.w)
+    return a.slerp(b, t)
+
+class TestAnimation(AlmostEqualMixin, unittest.TestCase):
+
+    def assertQuaternionAlmostEqual(self, q, expected, places=5):
+        # q and -q are the same rotation.
+        s = -1 if q.dot(expected) < 0 else 1
+        for a, b in zip((q.x, q.y, q.z, q.w), (expected.x, expected.y, expected.z, expected.w)):
+            self.assertAlmostEqual(s*a, b, places)
+
+    def setUp(self):
+        self.times = [0.0, 0.5, 1.25, 2.0, 4.0]
+        self.vkeys = [Vector(i, 2*i*i, -i) for i in range(5)]
+        # The third one is flipped to the other side.
+        self.qkeys = [Quaternion(Vector(1, i, 2), deg=40*i) for i in range(5)]
+        q = self.qkeys[2]
+        self.qkeys[2] = Quaternion(-q.x, -q.y, -q.z, -q.w)
+        self.vt = VectorTrack(self.times, self.vkeys)
+        self.qt = QuaternionTrack(self.times, self.qkeys)
+        self.samples = [-1, 0, 0.1, 0.5, 0.7, 1.3, 1.9, 2.0, 3.5, 4.0, 5.0]
+
+    def test_ctor(self):
+        self.assertEqual(len(self.vt), 5)
+        self.assertEqual(self.vt.times(), self.times)
+        self.assertEqual(self.vt.key(1), self.vkeys[1])
+        self.assertEqual(len(self.qt), 5)
+        self.assertEqual(self.qt.times(), self.times)
+        self.assertQuaternionAlmostEqual(self.qt.key(2), self.qkeys[2])
+        self.assertEqual(len(VectorTrack([], [])), 0)
+        self.assertEqual(len(QuaternionTrack(times=[1], keys=[(0, 0, 0, 1)])), 1)
+
+    def test_ctor_bad(self):
+        with self.assertRaises(ValueError):
+            VectorTrack([0, 1], [Vector()])
+        with self.assertRaises(ValueError):
+            VectorTrack([0, 1, 1], [Vector()] * 3)
+        with self.assertRaises(ValueError):
+            QuaternionTrack([0, 2, 1], [Quaternion()] * 3)
+        with self.assertRaises(TypeError):
+            VectorTrack([0], [Quaternion()])
+        with self.assertRaises(TypeError):
+            QuaternionTrack([0], [Vector()])
+        with self.assertRaises(TypeError):
+            VectorTrack([0, 1])
+        with self.assertRaises(IndexError):
+            self.vt.key(5)
+
+    def test_sample(self):
+        # Forward, backward and jumping around, which all go their own way
+        # through the cursor.
+        for ts in (self.samples, list(reversed(self.samples)), [3.5, 0.1, 2.0, 0.7, 5.0, 1.3]):
+            for t in ts:
+                self.assertVectorAlmostEqual(self.vt.sample(t), reference(self.times, self.vkeys, t, lambda a, b, x: a.lerp(b, x)))
+                self.assertQuaternionAlmostEqual(self.qt.sample(t), reference(self.times, self.qkeys, t, slerp))
+
+    def test_sample_empty(self):
+        self.assertEqual(VectorTrack([], []).sample(1), Vector(0, 0, 0))
+        self.assertQuaternionAlmostEqual(QuaternionTrack([], []).sample(1), Quaternion())
+        self.assertQuaternionAlmostEqual(QuaternionTrack([1], [self.qkeys[1]]).sample(0), self.qkeys[1])
+
+    def test_clip(self):
+        other = VectorTrack([1, 3], [Vector(1, 1, 1), Vector(3, 3, 3)])
+        clip = AnimationClip([self.vt, self.qt])
+        self.assertEqual(clip.add(other), 7)
+        self.assertEqual(len(clip), 3)
+        self.assertEqual(clip.floats(), 10)
+        self.assertEqual(clip.duration(), 4)
+
+        out = array.array('f', [0] * 10)
+        for t in self.samples:
+            s = clip.sample(t)
+            self.assertIs(clip.sample(t, out), out)
+            self.assertEqual(s.tolist(), out.tolist())
+            self.assertVectorAlmostEqual(Vector(*s[0:3]), self.vt.sample(t))
+            self.assertQuaternionAlmostEqual(Quaternion(*s[3:7]), self.qt.sample(t))
+            self.assertVectorAlmostEqual(Vector(*s[7:10]), other.sample(t))
+
+        self.assertEqual(len(AnimationClip().sample(1)), 0)
+
+    def test_clip_hierarchy(self):
+        # Translation, rotation and scale per node is what setLocals takes.
+        clip = AnimationClip()
+        for i in range(2):
+            clip.add(self.vt)
+            clip.add(self.qt)
+            clip.add(VectorTrack([0], [Vector(1, 1, 1)]))
+        h = TransformHierarchy([-1, 0])
+        h.setLocals(clip.sample(0.7))
+        h.update()
+        local = Transform(self.vt.sample(0.7), self.qt.sample(0.7))
+        self.assertVectorAlmostEqual(h.world(1) * Vector(0, 0, 0), (local * local).translation, 4)
+
+    def test_clip_bad(self):
+        with self.assertRaises(TypeError):
+            AnimationClip([self.vt, Vector()])
+        with self.assertRaises(TypeError):
+            AnimationClip().add(self.vkeys)
+        with self.assertRaises(ValueError):
+            AnimationClip([self.vt]).sample(0, array.array('f', [0] * 4))
+        with self.assertRaises(TypeError):
+            AnimationClip([self.vt]).sample('now')
+
+if __name__ == '__main__':
+    unittest.main()
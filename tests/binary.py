@@ -0,0 +1,165 @@
+import unittest
+import struct
+import mmap
+import tempfile
+import os
+import sys
+
+from pyglm import *
+
+class TestBinary(unittest.TestCase):
+
+    def assertMatrixEqual(self, m, expected):
+        self.assertEqual(list(m), list(expected))
+        self.assertEqual(list(m.inverse()), list(expected.inverse()))
+
+    def test_header(self):
+        data = toBinary([Vector(1, 2, 3), Vector(4, 5, 6)])
+        self.assertEqual(len(data), 32 + 2*3*4)
+        magic, version, type_, floats, count, reserved = struct.unpack('<4sIIIQQ', data[:32])
+        self.assertEqual(magic, b'PGLM')
+        self.assertEqual(version, 1)
+        self.assertEqual(type_, 1)
+        self.assertEqual(floats, 3)
+        self.assertEqual(count, 2)
+        self.assertEqual(struct.unpack('<6f', data[32:]), (1, 2, 3, 4, 5, 6))
+
+    def test_vectors(self):
+        vs = [Vector(1, 2, 3), Vector(-4, 0.5, 6)]
+        self.assertEqual(fromBinary(toBinary(vs)), vs)
+        self.assertEqual(fromBinary(toBinary(vs[0])), vs[:1])
+
+        # A VectorArray comes back as one.
+        data = toBinary(VectorArray(vs))
+        self.assertEqual(struct.unpack('<II', data[8:16]), (6, 3))
+        read = fromBinary(data)
+        self.assertIsInstance(read, VectorArray)
+        self.assertEqual(list(read), vs)
+
+    def test_empty(self):
+        data = toBinary([])
+        self.assertEqual(len(data), 32)
+        self.assertEqual(fromBinary(data), [])
+        self.assertEqual(fromBinary(toBinary(())), [])
+
+        read = fromBinary(toBinary(VectorArray()))
+        self.assertIsInstance(read, VectorArray)
+        self.assertEqual(len(read), 0)
+
+    def test_quaternions(self):
+        qs = [Quaternion(Vector(1, 0, 0), deg=30), Quaternion(1, 2, 3, 4)]
+        self.assertEqual(fromBinary(toBinary(qs)), qs)
+
+    def test_matrices(self):
+        ms = [translation(1, 2, 3), transformation(Vector(1, 2, 3), Quaternion(Vector(0, 1, 0), deg=30), Vector(2, 2, 2))]
+        read = fromBinary(toBinary(tuple(ms)))
+        self.assertEqual(len(read), 2)
+        for m, expected in zip(read, ms):
+            self.assertIsInstance(m, AffineMatrix)
+            self.assertMatrixEqual(m, expected)
+
+        p = perspectiveProjection(60, 4.0/3.0, 1.0, 100.0)
+        read = fromBinary(toBinary(p))
+        self.assertIsInstance(read[0], General4x4Matrix)
+        self.assertMatrixEqual(read[0], p)
+
+    def test_mmap(self):
+        ms = [translation(i, 0, 0) for i in range(100)]
+        with tempfile.TemporaryFile() as f:
+            f.write(toBinary(ms))
+            f.flush()
+            with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mm:
+                read = fromBinary(mm)
+        self.assertEqual(len(read), 100)
+        self.assertMatrixEqual(read[42], ms[42])
+
+    def test_without_inverses(self):
+        ms = [translation(1, 2, 3), transformation(Vector(1, 2, 3), Quaternion(Vector(0, 1, 0), deg=30), Vector(2, 2, 2))]
+        data = toBinary(ms, inverses=False)
+        self.assertEqual(len(data), 32 + 2*16*4)
+        self.assertEqual(struct.unpack('<II', data[8:16]), (5, 16))
+
+        read = fromBinary(data)
+        for m, expected in zip(read, ms):
+            self.assertEqual(list(m), list(expected))
+            for a, b in zip(m.inverse(), expected.inverse()):
+                self.assertAlmostEqual(a, b, places=5)
+
+    def test_bad(self):
+        with self.assertRaises(TypeError):
+            toBinary([3])
+        with self.assertRaises(TypeError):
+            toBinary([Vector(), Quaternion()])
+        with self.assertRaises(TypeError):
+            toBinary(3)
+        with self.assertRaises(TypeError):
+            fromBinary(3)
+
+        data = toBinary([Vector(1, 2, 3), Vector(4, 5, 6)])
+        with self.assertRaises(ValueError):
+            fromBinary(data[:-1])
+        with self.assertRaises(ValueError):
+            fromBinary(b'PGLN' + data[4:])
+        with self.assertRaises(ValueError):
+            fromBinary(data[:4] + struct.pack('<I', 2) + data[8:])
+        with self.assertRaises(ValueError):
+            fromBinary(data[:12] + struct.pack('<I', 4) + data[16:])
+
+@unittest.skipIf(sys.byteorder != 'little', "mapping needs a little-endian machine")
+class TestMappedAffineMatrices(unittest.TestCase):
+
+    def setUp(self):
+        self.ms = [transformation(Vector(i, 2, 3), Quaternion(Vector(0, 1, 0), deg=i), Vector(2, 2, 2)) for i in range(10)]
+        fd, self.name = tempfile.mkstemp()
+        os.close(fd)
+
+    def tearDown(self):
+        os.remove(self.name)
+
+    def write(self, data):
+        with open(self.name, 'wb') as f:
+            f.write(data)
+
+    def test_indexing(self):
+        self.write(toBinary(self.ms))
+        mapped = MappedAffineMatrices(self.name)
+        self.assertEqual(len(mapped), 10)
+        self.assertTrue(mapped.hasInverses())
+        self.assertEqual(list(mapped[3]), list(self.ms[3]))
+        self.assertEqual(list(mapped[-1].inverse()), list(self.ms[-1].inverse()))
+        with self.assertRaises(IndexError):
+            mapped[10]
+
+    def test_without_inverses(self):
+        self.write(toBinary(self.ms, inverses=False))
+        mapped = MappedAffineMatrices(self.name)
+        self.assertFalse(mapped.hasInverses())
+        self.assertEqual(list(mapped[3]), list(self.ms[3]))
+        for a, b in zip(mapped[3].inverse(), self.ms[3].inverse()):
+            self.assertAlmostEqual(a, b, places=5)
+
+    def test_buffer(self):
+        self.write(toBinary(self.ms))
+        view = memoryview(MappedAffineMatrices(self.name))
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.shape, (10, 32))
+        self.assertEqual(view.format, 'f')
+        self.assertEqual(list(view[4, i] for i in range(16)), list(self.ms[4]))
+        self.assertEqual(list(view[4, 16 + i] for i in range(16)), list(self.ms[4].inverse()))
+
+        # The view keeps the file mapped, although the object is gone.
+        self.assertEqual(view[9, 12], 9.0)
+
+    def test_bad(self):
+        with self.assertRaises(ValueError):
+            MappedAffineMatrices(self.name)
+        self.write(toBinary([Vector(1, 2, 3)]))
+        with self.assertRaises(ValueError):
+            MappedAffineMatrices(self.name)
+        with self.assertRaises(ValueError):
+            MappedAffineMatrices(self.name + '.missing')
+        with self.assertRaises(TypeError):
+            MappedAffineMatrices(3)
+
+if __name__ == '__main__':
+    unittest.main()
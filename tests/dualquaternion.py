@@ -0,0 +1,136 @@
+import unittest
+import math
+
+from pyglm import *
+from helpers import AlmostEqualMixin
+
+identity = [1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1]
+
+class TestDualQuaternion(AlmostEqualMixin, unittest.TestCase):
+
+    def setUp(self):
+        self.a = DualQuaternion(Vector(1, 2, 3), Quaternion(Vector(1, 2, 3), deg=40))
+        self.b = DualQuaternion(Vector(-3, 0.5, 2), Quaternion(Vector(0, 1, 1), deg=-75))
+
+    def test_ctor(self):
+        dq = DualQuaternion()
+        self.assertMatrixAlmostEqual(dq.matrix(), identity)
+        self.assertEqual(dq.translation, Vector(0, 0, 0))
+        self.assertEqual(dq.rotation, Quaternion())
+
+        dq = DualQuaternion(translation=(1, 2, 3))
+        self.assertVectorAlmostEqual(dq.translation, Vector(1, 2, 3))
+        self.assertEqual(dq.rotation, Quaternion())
+
+        dq = DualQuaternion(self.b)
+        self.assertEqual(dq, self.b)
+
+        dq = DualQuaternion(self.a.real, self.a.dual)
+        self.assertEqual(dq, self.a)
+        dq = DualQuaternion(real=self.b.real, dual=self.b.dual)
+        self.assertEqual(dq, self.b)
+
+    def test_ctor_bad(self):
+        with self.assertRaises(TypeError):
+            DualQuaternion(1)
+        with self.assertRaises(TypeError):
+            DualQuaternion(Vector(), Vector())
+        with self.assertRaises(TypeError):
+            DualQuaternion(Vector(), Quaternion(), Vector())
+
+    def test_matrix(self):
+        for dq in (self.a, self.b):
+            self.assertMatrixAlmostEqual(dq.matrix(), transformation(dq.translation, dq.rotation))
+
+            # There and back again.
+            self.assertEqual(DualQuaternion(dq.matrix()), dq)
+
+        # Each of the branches of taking the rotation out of a matrix, and
+        # scaling, which is dropped.
+        for q in (Quaternion(Vector(1, 0, 0), deg=170), Quaternion(Vector(0, 1, 0), deg=170), Quaternion(Vector(0, 0, 1), deg=170)):
+            dq = DualQuaternion(transformation(Vector(1, 2, 3), q, Vector(2, 3, 4)))
+            self.assertEqual(dq, DualQuaternion(Vector(1, 2, 3), q))
+
+    def test_point(self):
+        p = Vector(0.5, -1, 4)
+        for dq in (self.a, self.b):
+            self.assertVectorAlmostEqual(dq * p, dq.matrix() * p)
+            self.assertVectorAlmostEqual(dq.direction(p), dq.rotation.rotate(p))
+
+    def test_product(self):
+        self.assertMatrixAlmostEqual((self.a * self.b).matrix(), self.a.matrix() * self.b.matrix())
+
+        dq = DualQuaternion(self.a)
+        dq *= self.b
+        self.assertEqual(dq, self.a * self.b)
+
+        # A Vector on the right isn't an in-place operation.
+        dq = self.a
+        dq *= Vector(1, 0, 0)
+        self.assertIsInstance(dq, Vector)
+
+        with self.assertRaises(TypeError):
+            self.a * self.a.matrix()
+
+    def test_inverse(self):
+        inv = self.a.inverse()
+        self.assertEqual(self.a * inv, DualQuaternion())
+        self.assertEqual(inv * self.a, DualQuaternion())
+        self.assertMatrixAlmostEqual(inv.matrix(), self.a.matrix().inverse())
+
+    def test_equality(self):
+        # -dq is the same transformation as dq.
+        self.assertEqual(-self.a, self.a)
+        self.assertNotEqual(self.a, self.b)
+
+    def test_normalize(self):
+        dq = self.a * 3 + self.a
+        self.assertAlmostEqual(dq.len(), 4, 5)
+        self.assertEqual(dq.normalized(), self.a)
+        dq.normalize()
+        self.assertAlmostEqual(dq.len(), 1, 5)
+        self.assertEqual(dq, self.a)
+
+    def test_sclerp(self):
+        self.assertEqual(self.a.sclerp(self.b, 0), self.a)
+        self.assertEqual(self.a.sclerp(other=self.b, between=1), self.b)
+
+        # At constant speed: going half the way twice goes all the way.
+        half = self.a.inverse() * self.a.sclerp(self.b, 0.5)
+        self.assertEqual(self.a * half * half, self.b)
+        quarter = self.a.inverse() * self.a.sclerp(self.b, 0.25)
+        self.assertEqual(quarter * quarter, half)
+
+        # The rotation goes like slerp, and a translation alone goes linearly.
+        self.assertEqual(self.a.sclerp(self.b, 0.3).rotation, self.a.rotation.slerp(self.b.rotation, 0.3))
+        t = DualQuaternion(Vector(1, 2, 3)).sclerp(DualQuaternion(Vector(3, 2, 1)), 0.25)
+        self.assertVectorAlmostEqual(t.translation, Vector(1.5, 2, 2.5))
+
+        # Along the shortest way.
+        self.assertEqual(self.a.sclerp(-self.a, 0.5), self.a)
+
+        with self.assertRaises(TypeError):
+            self.a.sclerp(self.a.matrix(), 0.5)
+        with self.assertRaises(ValueError):
+            self.a.sclerp(self.b)
+
+    def test_dlb(self):
+        self.assertEqual(dlb([self.a, self.b], [1, 0]), self.a)
+        self.assertEqual(dlb([self.a, -self.b], [0, 1]), self.b)
+
+        # Blending is close to sclerp, and doesn't care about the sign.
+        blended = dlb([self.a, self.b], [0.5, 0.5])
+        self.assertAlmostEqual(blended.len(), 1, 5)
+        self.assertEqual(dlb([self.a, -self.b], [0.5, 0.5]), blended)
+        self.assertVectorAlmostEqual(blended * Vector(1, 1, 1), self.a.sclerp(self.b, 0.5) * Vector(1, 1, 1), 1)
+
+        with self.assertRaises(ValueError):
+            dlb([self.a, self.b], [1])
+        with self.assertRaises(TypeError):
+            dlb([self.a, self.b.matrix()], [0.5, 0.5])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,16 @@
+# Comparisons shared by the test cases, mixed into them next to
+# unittest.TestCase. A test case may set places to change the default.
+class AlmostEqualMixin(object):
+
+    places = 5
+
+    def assertMatrixAlmostEqual(self, m, expected, places=None):
+        self.assertEqual(len(m), 16)
+        for a, b in zip(m, expected):
+            self.assertAlmostEqual(a, b, self.places if places is None else places)
+
+    def assertVectorAlmostEqual(self, v, expected, places=None):
+        places = self.places if places is None else places
+        self.assertAlmostEqual(v.x, expected.x, places)
+        self.assertAlmostEqual(v.y, expected.y, places)
+        self.assertAlmostEqual(v.z, expected.z, places)
@@ -0,0 +1,283 @@
+import unittest
+import math
+import struct
+import array
+
+from pyglm import *
+from helpers import AlmostEqualMixin
+
+identity = [1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1]
+
+class TestAffineMatrix(AlmostEqualMixin, unittest.TestCase):
+
+    places = 6
+
+    def test_ctor(self):
+        self.assertMatrixAlmostEqual(AffineMatrix(), identity)
+
+    def test_ctor_copy(self):
+        m = translation(1, 2, 3)
+        self.assertMatrixAlmostEqual(AffineMatrix(m), m)
+
+    def test_ctor_bad(self):
+        with self.assertRaises(ValueError):
+            AffineMatrix(1.0)
+        with self.assertRaises(ValueError):
+            AffineMatrix(range(16))
+
+    def test_index_bad(self):
+        with self.assertRaises(IndexError):
+            AffineMatrix()[16]
+
+    def test_translation(self):
+        m = translation(1, 2, 3)
+        self.assertMatrixAlmostEqual(m, [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 2, 3, 1])
+        self.assertMatrixAlmostEqual(translation(Vector(1, 2, 3)), m)
+        self.assertMatrixAlmostEqual(translation((1, 2, 3)), m)
+        self.assertEqual(m * Vector(1, 1, 1), Vector(2, 3, 4))
+
+    def test_translation_bad(self):
+        with self.assertRaises(TypeError):
+            translation()
+        with self.assertRaises(TypeError):
+            translation(1)
+
+    def test_rotation(self):
+        r = rotation(Quaternion(Vector(0, 0, 1), deg=90))
+        self.assertEqual(r * Vector(1, 0, 0), Vector(0, 1, 0))
+        self.assertMatrixAlmostEqual(rotation(Vector(0, 0, 1), deg=90), r)
+        self.assertMatrixAlmostEqual(rotation(), identity)
+
+    def test_scale(self):
+        self.assertEqual(scale(2) * Vector(1, 2, 3), Vector(2, 4, 6))
+        self.assertEqual(scale(1, 2, 3) * Vector(1, 1, 1), Vector(1, 2, 3))
+        self.assertEqual(scale(Vector(1, 2, 3)) * Vector(1, 1, 1), Vector(1, 2, 3))
+
+    def test_transformation(self):
+        t = Vector(1, 2, 3)
+        r = Quaternion(Vector(0, 1, 0), rad=0.5)
+        s = Vector(2, 3, 4)
+        self.assertMatrixAlmostEqual(transformation(t, r), translation(t) * rotation(r))
+        self.assertMatrixAlmostEqual(transformation(t, r, s), translation(t) * rotation(r) * scale(s))
+
+    def test_transformation_bad(self):
+        with self.assertRaises(TypeError):
+            transformation(Vector())
+        with self.assertRaises(TypeError):
+            transformation(1, Quaternion())
+
+    def test_inverse(self):
+        m = transformation(Vector(1, 2, 3), Quaternion(Vector(1, 1, 0), rad=1.0), Vector(2, 2, 2))
+        self.assertMatrixAlmostEqual(m * m.inverse(), identity)
+        self.assertMatrixAlmostEqual(m.inverse() * m, identity)
+        self.assertMatrixAlmostEqual(m.inverse().inverse(), m)
+
+    def test_product(self):
+        m = translation(1, 0, 0) * rotation(Vector(0, 0, 1), deg=90)
+        self.assertEqual(m * Vector(1, 0, 0), Vector(1, 1, 0))
+        self.assertMatrixAlmostEqual((m * m.inverse()), identity)
+
+    def test_lazy_inverse(self):
+        a = transformation(Vector(1, 2, 3), Quaternion(Vector(1, 1, 0), rad=1.0), Vector(2, 0.5, 3))
+        b = translation(-4, 1, 0.5) * rotation(Vector(0, 1, 1), rad=-1.2)
+        self.assertFalse(a.lazyInverse())
+        eager = a * b * a
+
+        a.setLazyInverse(True)
+        self.assertTrue(a.lazyInverse())
+        lazy = a * b * a
+        self.assertTrue(lazy.lazyInverse())
+        self.assertMatrixAlmostEqual(lazy, eager)
+        self.assertMatrixAlmostEqual(lazy.inverse(), eager.inverse(), 5)
+        self.assertMatrixAlmostEqual(lazy * lazy.inverse(), identity, 5)
+
+        # Products of a singular matrix get the identity as inverse.
+        s = scale(1, 0, 1)
+        s.setLazyInverse(True)
+        self.assertMatrixAlmostEqual((s * s).inverse(), identity)
+
+    def test_product_inplace(self):
+        a = transformation(Vector(1, 2, 3), Quaternion(Vector(1, 1, 0), rad=1.0), Vector(2, 0.5, 3))
+        b = translation(-4, 1, 0.5) * rotation(Vector(0, 1, 1), rad=-1.2)
+        ab = a * b
+        aa = ab * ab
+
+        m = AffineMatrix(a)
+        alias = m
+        m *= b
+        self.assertIs(m, alias)
+        self.assertMatrixAlmostEqual(m, ab)
+        self.assertMatrixAlmostEqual(m.inverse(), ab.inverse())
+        m *= m
+        self.assertMatrixAlmostEqual(m, aa, 4)
+
+        # Products giving another type still work, creating a new object.
+        m *= Vector(1, 0, 0)
+        self.assertIsInstance(m, Vector)
+        p = AffineMatrix()
+        p *= perspectiveProjection(60, 1.0)
+        self.assertIsInstance(p, General4x4Matrix)
+
+    def test_product_bad(self):
+        with self.assertRaises(TypeError):
+            AffineMatrix() * 3
+        with self.assertRaises(TypeError):
+            AffineMatrix() * "Hi"
+
+    def test_axes(self):
+        m = AffineMatrix()
+        self.assertEqual(m.right(), Vector(1, 0, 0))
+        self.assertEqual(m.up(), Vector(0, 1, 0))
+        self.assertEqual(m.front(), Vector(0, 0, -1))
+
+    def test_buffer(self):
+        m = translation(1, 2, 3)
+        v = memoryview(m)
+        self.assertEqual(v.shape, (4, 4))
+        self.assertTrue(v.readonly)
+        self.assertEqual(v.tolist()[0], [1, 0, 0, 1])
+        self.assertEqual(v.tolist()[2], [0, 0, 1, 3])
+        # Consumers without stride support get the raw column-major floats.
+        self.assertEqual(list(struct.unpack('16f', m)), list(m))
+        with self.assertRaises(TypeError):
+            v[0, 0] = 2
+
+    def test_transform_points(self):
+        m = transformation(Vector(1, 2, 3), Quaternion(Vector(0, 0, 1), deg=90), Vector(2, 2, 2))
+        pts = array.array('f', [float(i) for i in range(3000)])
+        out = m.transformPoints(pts)
+        self.assertEqual(len(out), 3000)
+        for i in range(0, 3000, 3):
+            self.assertEqual(Vector(out[i], out[i+1], out[i+2]), m * Vector(pts[i], pts[i+1], pts[i+2]))
+
+        # In-place, spanning several blocks.
+        self.assertIs(m.transformPoints(pts, out=pts), pts)
+        self.assertEqual(pts, out)
+
+    def test_transform_points_stride(self):
+        m = translation(1, 2, 3)
+        pts = array.array('f', [1, 1, 1, 1,  1, 1, 1, 0])
+        self.assertEqual(list(m.transformPoints(memoryview(pts).cast('B').cast('f', (2, 4)))), [2, 3, 4, 1, 1, 1, 1, 0])
+        verts = array.array('f', [0, 0, 0, 7, 7])
+        self.assertEqual(list(m.transformPoints(memoryview(verts).cast('B').cast('f', (1, 5)))), [1, 2, 3, 7, 7])
+
+    def test_transform_directions(self):
+        m = transformation(Vector(1, 2, 3), Quaternion(Vector(0, 0, 1), deg=90))
+        dirs = array.array('f', [1, 0, 0,  0, 1, 0])
+        out = array.array('f', [0] * 6)
+        m.transformDirections(dirs, out)
+        self.assertEqual(Vector(*out[0:3]), Vector(0, 1, 0))
+        self.assertEqual(Vector(*out[3:6]), Vector(-1, 0, 0))
+
+    def test_transform_bad(self):
+        m = AffineMatrix()
+        with self.assertRaises(TypeError):
+            m.transformPoints(array.array('d', [1, 2, 3]))
+        with self.assertRaises(TypeError):
+            m.transformPoints(array.array('f', [1, 2, 3]), out=translation(1, 2, 3))
+        with self.assertRaises(ValueError):
+            m.transformPoints(array.array('f', [1, 2]))
+        with self.assertRaises(ValueError):
+            m.transformPoints(array.array('f', [1, 2, 3]), out=array.array('f', [1]))
+
+        # Missing input or misnamed keywords.
+        buf = array.array('f', [1, 2, 3])
+        with self.assertRaises(TypeError):
+            m.transformPoints(out=buf)
+        with self.assertRaises(TypeError):
+            m.transformDirections(points=buf)
+        with self.assertRaises(TypeError):
+            m.transformPoints(pts=1)
+        with self.assertRaises(TypeError):
+            m.transformPoints(buf, points=buf)
+        self.assertEqual(m.transformDirections(directions=buf).tolist(), [1, 2, 3])
+
+    def test_transform_vector_array(self):
+        # A VectorArray of three has the [3, 3] shape of three points, but
+        # holds the x, then y, then z components, which mustn't be misread.
+        m = translation(10, 20, 30)
+        va = VectorArray([Vector(1, 2, 3), Vector(4, 5, 6), Vector(7, 8, 9)])
+        with self.assertRaises(TypeError):
+            m.transformPoints(va)
+        with self.assertRaises(TypeError):
+            m.transformDirections(VectorArray(4))
+        with self.assertRaises(TypeError):
+            m.transformPoints(array.array('f', [1, 2, 3] * 3), out=va)
+        with self.assertRaises(ValueError):
+            m.transformPoints(memoryview(array.array('f', [1, 2, 3] * 4)).cast('B').cast('f', (2, 2, 3)))
+
+class TestGeneral4x4Matrix(AlmostEqualMixin, unittest.TestCase):
+
+    places = 6
+
+    def test_ctor(self):
+        self.assertMatrixAlmostEqual(General4x4Matrix(), identity)
+
+    def test_ctor_affine(self):
+        m = translation(1, 2, 3)
+        self.assertMatrixAlmostEqual(General4x4Matrix(m), m)
+        self.assertMatrixAlmostEqual(General4x4Matrix(m).inverse(), m.inverse())
+
+    def test_ctor_bad(self):
+        with self.assertRaises(ValueError):
+            General4x4Matrix(1.0)
+
+    def test_perspective(self):
+        p = perspectiveProjection(60, 4.0/3.0, 1.0, 100.0)
+        t = 1.0/math.tan(math.radians(30))
+        self.assertAlmostEqual(p[0], t*3.0/4.0, 5)
+        self.assertAlmostEqual(p[5], t, 5)
+        self.assertAlmostEqual(p[11], -1.0)
+        self.assertMatrixAlmostEqual(perspectiveProjection(60, 4.0/3.0, near=1.0, far=100.0), p)
+        self.assertMatrixAlmostEqual(p * p.inverse(), identity, 5)
+        self.assertMatrixAlmostEqual(p.inverse() * p, identity, 5)
+
+    def test_perspective_bad(self):
+        with self.assertRaises(TypeError):
+            perspectiveProjection(60)
+        with self.assertRaises(TypeError):
+            perspectiveProjection(60, 1.3, nears=1)
+        with self.assertRaises(TypeError):
+            perspectiveProjection(60, 1.3, 1, near=1)
+
+    def test_product_inplace(self):
+        p = perspectiveProjection(60, 1.0)
+        m = translation(1, 2, 3)
+        pm = p * m
+        pmp = pm * p
+
+        q = General4x4Matrix(p)
+        alias = q
+        q *= m
+        self.assertIs(q, alias)
+        self.assertMatrixAlmostEqual(q, pm)
+        q *= p
+        self.assertMatrixAlmostEqual(q, pmp)
+
+    def test_product_mixed(self):
+        p = perspectiveProjection(60, 1.0)
+        m = translation(1, 2, 3)
+        pm = p * m
+        mp = m * p
+        self.assertIsInstance(pm, General4x4Matrix)
+        self.assertIsInstance(mp, General4x4Matrix)
+        self.assertMatrixAlmostEqual(pm * pm.inverse(), identity, 4)
+        self.assertMatrixAlmostEqual(mp * mp.inverse(), identity, 4)
+
+    def test_lazy_inverse(self):
+        p = perspectiveProjection(60, 4.0/3.0, 1.0, 100.0)
+        m = translation(1, 2, 3) * rotation(Vector(1, 0, 0), deg=30)
+        eager = p * m
+
+        p.setLazyInverse(True)
+        lazy = p * m
+        self.assertTrue(lazy.lazyInverse())
+        self.assertMatrixAlmostEqual(lazy, eager)
+        self.assertMatrixAlmostEqual(lazy.inverse(), eager.inverse(), 4)
+        self.assertMatrixAlmostEqual(lazy * lazy.inverse(), identity, 4)
+
+if __name__ == '__main__':
+    unittest.main()
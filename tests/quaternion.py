@@ -1,5 +1,6 @@
 import unittest
 import math
+import array
 
 from pyglm import *
 
@@ -207,12 +208,35 @@ class TestQuaternion(unittest.TestCase):
         self.assertAlmostEqual(q.degrees, 90, 4)
         self.assertAlmostEqual(q.deg, 90, 4)
 
+    def test_swizzle(self):
+        q = Quaternion(1, 2, 3, 4)
+        self.assertEqual(q.xyz, Vector(1, 2, 3))
+        self.assertEqual(q.wzyx, Quaternion(4, 3, 2, 1))
+        self.assertEqual(q.ww, (4.0, 4.0))
+
+        q.xyz = Vector(5, 6, 7)
+        self.assertEqual(q, Quaternion(5, 6, 7, 4))
+        q.wx = (1, 2)
+        self.assertEqual(q, Quaternion(2, 6, 7, 1))
+        q.xyzw = Quaternion(1, 2, 3, 4).wzyx
+        self.assertEqual(q, Quaternion(4, 3, 2, 1))
+        with self.assertRaises(AttributeError):
+            q.xyzx = (1, 2, 3, 4)
+
     def test_setter_bad(self):
         q = Quaternion()
         with self.assertRaises(AttributeError):
             q.q = 3.0
         with self.assertRaises(ValueError):
             q.x = "abc"
+        with self.assertRaises(AttributeError):
+            del q.w
+        with self.assertRaises(AttributeError):
+            del q.axis
+        with self.assertRaises(TypeError):
+            q.deg = None
+        with self.assertRaises(ValueError):
+            q.axis = 3
 
     def test_comparison(self):
         q1 = Quaternion(1, 2, 3, 4)
@@ -283,6 +307,26 @@ class TestQuaternion(unittest.TestCase):
         with self.assertRaises(TypeError):
             "1,2,3,4" + Quaternion()
 
+    def test_inplace(self):
+        p = Quaternion(Vector(0, 1, 0), deg=30)
+        q = Quaternion(Vector(1, 0, 0), deg=45)
+        pq = p * q
+
+        alias = p
+        p *= q
+        self.assertIs(p, alias)
+        self.assertEqual(p, pq)
+
+        q1 = Quaternion(1, 2, 3, 4)
+        q1 += Quaternion(0.5, 0.5, 0.5, 0.5)
+        self.assertEqual(q1, Quaternion(1.5, 2.5, 3.5, 4.5))
+        q1 -= Quaternion(0.5, 1.5, 2.5, 3.5)
+        self.assertEqual(q1, Quaternion(1, 1, 1, 1))
+        q1 *= 2.0
+        self.assertEqual(q1, Quaternion(2, 2, 2, 2))
+        with self.assertRaises(TypeError):
+            q1 += 1
+
     def test_subtraction(self):
         q1 = Quaternion(1, 2, 3, 4)
         q2 = Quaternion(0.1, 0.2, 0.3, 0.4)
@@ -389,6 +433,183 @@ class TestQuaternion(unittest.TestCase):
         with self.assertRaises(TypeError):
             Quaternion().normalized(32)
 
+    def test_free_list(self):
+        q = Quaternion(1, 2, 3, 4)
+        before = freeListStats()['Quaternion']
+        results = [-q for i in range(10)]
+        del results
+        results = [-q for i in range(10)]
+        after = freeListStats()['Quaternion']
+        self.assertGreaterEqual(after['hits'] - before['hits'], 10)
+        self.assertLessEqual(after['size'], after['capacity'])
+        for r in results:
+            self.assertEqual(r, -q)
+
+    def test_buffer(self):
+        q = Quaternion(1, 2, 3, 4)
+        m = memoryview(q)
+        self.assertEqual(m.format, 'f')
+        self.assertEqual(m.tolist(), [1, 2, 3, 4])
+        m[3] = 5
+        self.assertEqual(q.w, 5)
+
+    def test_nlerp(self):
+        a = Quaternion(Vector(0, 0, 1), deg=0)
+        b = Quaternion(Vector(0, 0, 1), deg=90)
+        self.assertEqual(a.nlerp(b, 0), a)
+        self.assertEqual(a.nlerp(other=b, between=1), b)
+        self.assertEqual(a.nlerp(b, 0.5), Quaternion(Vector(0, 0, 1), deg=45))
+
+    def test_slerp(self):
+        a = Quaternion(Vector(0, 0, 1), deg=0)
+        b = Quaternion(Vector(0, 0, 1), deg=90)
+        self.assertEqual(a.slerp(b, 0), a)
+        self.assertEqual(a.slerp(other=b, between=1), b)
+        self.assertEqual(a.slerp(b, 0.25), Quaternion(Vector(0, 0, 1), deg=22.5))
+
+    def test_lerp_bad(self):
+        with self.assertRaises(TypeError):
+            Quaternion().slerp(Vector(), 0.5)
+        with self.assertRaises(TypeError):
+            Quaternion().nlerp(Quaternion(), "Hi")
+        with self.assertRaises(ValueError):
+            Quaternion().slerp(Quaternion())
+
+    def test_lerp_buffers(self):
+        axes = [Vector(1, 0, 0), Vector(0, 1, 0), Vector(1, 2, 3), Vector(-1, 1, 0)]
+        q1 = [Quaternion(axis, deg=10*i) for i, axis in enumerate(axes)]
+        q2 = [Quaternion(axis.cross(Vector(0, 0, 1)) + Vector(0, 0, 0.1), deg=170 - 30*i) for i, axis in enumerate(axes)]
+        between = array.array('f', [0.0, 0.3, 0.5, 1.0])
+        flat1 = array.array('f', [c for q in q1 for c in (q.x, q.y, q.z, q.w)])
+        flat2 = array.array('f', [c for q in q2 for c in (q.x, q.y, q.z, q.w)])
+
+        for batched, single in ((nlerp, Quaternion.nlerp), (slerp, Quaternion.slerp)):
+            result = batched(flat1, flat2, between)
+            self.assertEqual(len(result), 16)
+            for i in range(4):
+                expected = single(q1[i], q2[i], between[i])
+                for a, b in zip(result[4*i:4*i+4], (expected.x, expected.y, expected.z, expected.w)):
+                    self.assertAlmostEqual(a, b, 5)
+
+            # In-place, into the first or second buffer.
+            inplace = array.array('f', flat1)
+            self.assertIs(batched(inplace, flat2, between, out=inplace), inplace)
+            self.assertEqual(inplace.tolist(), result.tolist())
+            inplace = array.array('f', flat2)
+            batched(q1=flat1, q2=inplace, between=between, out=inplace)
+            self.assertEqual(inplace.tolist(), result.tolist())
+
+    def test_lerp_buffers_bad(self):
+        q = array.array('f', [0, 0, 0, 1])
+        with self.assertRaises(TypeError):
+            slerp(q, q)
+        with self.assertRaises(TypeError):
+            slerp([0, 0, 0, 1], q, array.array('f', [0.5]))
+        with self.assertRaises(TypeError):
+            slerp(q, q, array.array('f', [0.5]), bogus=1)
+        with self.assertRaises(TypeError):
+            nlerp(q, q, array.array('f', [0.5]), q1=q)
+        with self.assertRaises(ValueError):
+            nlerp(q, q, array.array('f', [0.5, 0.5]))
+        with self.assertRaises(ValueError):
+            nlerp(array.array('f', [0, 0, 1]), array.array('f', [0, 0, 1]), array.array('f', [0.5]))
+        with self.assertRaises(ValueError):
+            slerp(q, q, array.array('f', [0.5]), out=array.array('f', [0, 0]))
+
+        # Four vectors hold as many floats as three quaternions, in another order.
+        va = VectorArray([Vector(i, 1, 0) for i in range(4)])
+        q3 = array.array('f', [0, 0, 0, 1] * 3)
+        t3 = array.array('f', [0.5] * 3)
+        with self.assertRaises(TypeError):
+            nlerp(q3, va, t3)
+        with self.assertRaises(TypeError):
+            slerp(q3, q3, t3, out=va)
+
+    def test_rotate(self):
+        v = Vector(1, 2, 3)
+        for q in (Quaternion(Vector(0, 1, 0), deg=90), Quaternion(Vector(1, 2, 3), deg=-37),
+                  Quaternion(1, 2, 3, 4)):
+            # The sandwich product q * v * q.cnj, which is what rotate computes.
+            qv = q * Quaternion(v.x, v.y, v.z, 0) * Quaternion(-q.x, -q.y, -q.z, q.w)
+            r = q.rotate(v)
+            self.assertIsInstance(r, Vector)
+            self.assertAlmostEqual(r.x, qv.x, 4)
+            self.assertAlmostEqual(r.y, qv.y, 4)
+            self.assertAlmostEqual(r.z, qv.z, 4)
+
+        r = Quaternion(Vector(0, 0, 1), deg=90).rotate(Vector(1, 0, 0))
+        self.assertAlmostEqual(r.x, 0.0, 6)
+        self.assertAlmostEqual(r.y, 1.0, 6)
+        self.assertAlmostEqual(r.z, 0.0, 6)
+
+    def test_rotate_vectors(self):
+        q = Quaternion(Vector(1, 2, 3), deg=73)
+        vs = [Vector(i, 2*i - 5, 0.5*i) for i in range(300)]
+        flat = array.array('f', [c for v in vs for c in (v.x, v.y, v.z)])
+
+        result = q.rotateVectors(flat)
+        self.assertIsInstance(result, array.array)
+        self.assertEqual(len(result), len(flat))
+        for i, v in enumerate(vs):
+            expected = q.rotate(v)
+            for a, b in zip(result[3*i:3*i+3], (expected.x, expected.y, expected.z)):
+                self.assertAlmostEqual(a, b, 3)
+
+        self.assertEqual(q.rotateVectors(array.array('f')).tolist(), [])
+        self.assertIs(q.rotateVectors(flat, out=flat), flat)
+        self.assertEqual(flat.tolist(), result.tolist())
+
+        with self.assertRaises(TypeError):
+            q.rotateVectors()
+        with self.assertRaises(TypeError):
+            q.rotateVectors(flat, bogus=flat)
+        with self.assertRaises(TypeError):
+            q.rotateVectors(v=flat)
+        with self.assertRaises(ValueError):
+            q.rotateVectors(array.array('f', [1, 2]))
+        with self.assertRaises(ValueError):
+            q.rotateVectors(array.array('f', [1, 2, 3]), out=array.array('f', [0]))
+        with self.assertRaises(TypeError):
+            q.rotate(array.array('f', [1, 2, 3]))
+
+        # A VectorArray of three is 3x3 too, but holds x x x y y y z z z.
+        va = VectorArray([Vector(1, 2, 3), Vector(4, 5, 6), Vector(7, 8, 9)])
+        with self.assertRaises(TypeError):
+            q.rotateVectors(va)
+        with self.assertRaises(TypeError):
+            q.rotateVectors(array.array('f', range(9)), out=va)
+
+    def test_rotate_buffers(self):
+        qs = [Quaternion(Vector(1, i, 3), deg=10*i) for i in range(5)] + [Quaternion(1, 2, 3, 4)]
+        vs = [Vector(i, 1, -i) for i in range(6)]
+        flatq = array.array('f', [c for q in qs for c in (q.x, q.y, q.z, q.w)])
+        flatv = array.array('f', [c for v in vs for c in (v.x, v.y, v.z)])
+
+        result = rotate(flatq, flatv)
+        self.assertEqual(len(result), 18)
+        for i in range(6):
+            expected = qs[i].rotate(vs[i])
+            for a, b in zip(result[3*i:3*i+3], (expected.x, expected.y, expected.z)):
+                self.assertAlmostEqual(a, b, 4)
+
+        self.assertIs(rotate(q=flatq, v=flatv, out=flatv), flatv)
+        self.assertEqual(flatv.tolist(), result.tolist())
+
+        with self.assertRaises(TypeError):
+            rotate(flatq)
+        with self.assertRaises(TypeError):
+            rotate(flatq, flatv, outs=flatv)
+        with self.assertRaises(ValueError):
+            rotate(flatq, array.array('f', [1, 2, 3]))
+        with self.assertRaises(ValueError):
+            rotate(array.array('f', [0, 0, 1]), array.array('f', [1, 2, 3]))
+
+        va = VectorArray([Vector(1, 2, 3), Vector(4, 5, 6), Vector(7, 8, 9)])
+        with self.assertRaises(TypeError):
+            rotate(flatq[:12], va)
+        with self.assertRaises(TypeError):
+            rotate(flatq[:12], flatv[:9], out=va)
+
 if __name__ == '__main__':
     unittest.main()
 
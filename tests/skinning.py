@@ -0,0 +1,128 @@
+import unittest
+import array
+import math
+
+from pyglm import *
+
+class TestSkinning(unittest.TestCase):
+
+    def assertVectorsAlmostEqual(self, flat, expected, places=4):
+        self.assertEqual(len(flat), 3*len(expected))
+        for i, v in enumerate(expected):
+            for a, b in zip(flat[3*i:3*i+3], (v.x, v.y, v.z)):
+                self.assertAlmostEqual(a, b, places)
+
+    def setUp(self):
+        self.palette = [transformation(Vector(i, -1, 2*i), Quaternion(Vector(1, i, 2), deg=25*i), Vector(1 + 0.5*i, 1, 2)) for i in range(4)]
+        self.verts = [Vector(0.5*i, 1 - i, 0.25*i) for i in range(5)]
+        self.nrms = [Vector(1, i, -1).normalized() for i in range(5)]
+        # Two influences per vertex, the last vertex only using bone 3.
+        self.bones = array.array('i', [0, 1,  1, 2,  2, 3,  3, 0,  3, 0])
+        self.weights = array.array('f', [0.25, 0.75,  0.5, 0.5,  0.9, 0.1,  0.6, 0.4,  1, 0])
+        self.pos = array.array('f', [c for v in self.verts for c in (v.x, v.y, v.z)])
+        self.nrm = array.array('f', [c for v in self.nrms for c in (v.x, v.y, v.z)])
+
+    # What skinning vertex i should result in, one bone at a time.
+    def expected(self, i):
+        p = Vector(0, 0, 0)
+        n = Vector(0, 0, 0)
+        for j in (2*i, 2*i + 1):
+            m = self.palette[self.bones[j]]
+            w = self.weights[j]
+            p = p + (m * self.verts[i]) * w
+
+            # Normals go by the inverse transpose.
+            inv = list(m.inverse())
+            v = self.nrms[i]
+            n = n + Vector(*[inv[4*r]*v.x + inv[4*r+1]*v.y + inv[4*r+2]*v.z for r in range(3)]) * w
+        return p, n.normalized()
+
+    def test_skin(self):
+        result = skin(self.palette, self.bones, self.weights, self.pos)
+        self.assertIsInstance(result, array.array)
+        self.assertVectorsAlmostEqual(result, [self.expected(i)[0] for i in range(5)])
+
+        # The last vertex is moved by bone 3 alone.
+        last = self.palette[3] * self.verts[4]
+        self.assertAlmostEqual(result[12], last.x, 4)
+
+    def test_skin_normals(self):
+        pos, nrm = skin(self.palette, self.bones, self.weights, self.pos, self.nrm)
+        self.assertVectorsAlmostEqual(pos, [self.expected(i)[0] for i in range(5)])
+        self.assertVectorsAlmostEqual(nrm, [self.expected(i)[1] for i in range(5)])
+        for i in range(5):
+            self.assertAlmostEqual(math.sqrt(sum(c*c for c in nrm[3*i:3*i+3])), 1, 5)
+
+    def test_skin_inplace(self):
+        pos, nrm = skin(self.palette, self.bones, self.weights, self.pos, self.nrm)
+        p, n = skin(self.palette, self.bones, self.weights, self.pos, normals=self.nrm, out=self.pos, outNormals=self.nrm)
+        self.assertIs(p, self.pos)
+        self.assertIs(n, self.nrm)
+        self.assertEqual(self.pos.tolist(), pos.tolist())
+        self.assertEqual(self.nrm.tolist(), nrm.tolist())
+
+    def test_skin_index_types(self):
+        result = skin(self.palette, self.bones, self.weights, self.pos)
+        for fmt in 'bBhHiIlLqQ':
+            bones = array.array(fmt, self.bones)
+            self.assertEqual(skin(self.palette, bones, self.weights, self.pos).tolist(), result.tolist())
+
+    def test_skin_dual_quaternion(self):
+        dqs = [DualQuaternion(Vector(i, -1, 2*i), Quaternion(Vector(1, i, 2), deg=25*i)) for i in range(4)]
+        pos, nrm = skin(dqs, self.bones, self.weights, self.pos, self.nrm)
+        for i in range(5):
+            dq = dlb([dqs[self.bones[2*i]], dqs[self.bones[2*i+1]]], self.weights[2*i:2*i+2])
+            self.assertVectorsAlmostEqual(pos[3*i:3*i+3], [dq * self.verts[i]])
+            self.assertVectorsAlmostEqual(nrm[3*i:3*i+3], [dq.direction(self.nrms[i])])
+
+        # With a single bone per vertex, it's the same as skinning by matrices.
+        bones = array.array('i', [i % 4 for i in range(5)])
+        weights = array.array('f', [1] * 5)
+        self.assertVectorsAlmostEqual(skin(dqs, bones, weights, self.pos),
+                                      [dqs[i % 4].matrix() * v for i, v in enumerate(self.verts)])
+
+        # Flipped bones go the same way.
+        self.assertVectorsAlmostEqual(skin([-dq for dq in dqs], self.bones, self.weights, self.pos),
+                                      [Vector(*pos[3*i:3*i+3]) for i in range(5)])
+
+    def test_skin_bad(self):
+        with self.assertRaises(TypeError):
+            skin(self.palette, self.bones, self.weights)
+        with self.assertRaises(TypeError):
+            skin([AffineMatrix(), Vector()], self.bones, self.weights, self.pos)
+        with self.assertRaises(TypeError):
+            skin([DualQuaternion(), AffineMatrix()] * 2, self.bones, self.weights, self.pos)
+        with self.assertRaises(TypeError):
+            skin(self.palette, array.array('f', self.weights), self.weights, self.pos)
+        with self.assertRaises(ValueError):
+            skin(self.palette[:3], self.bones, self.weights, self.pos)
+        with self.assertRaises(ValueError):
+            skin(self.palette, array.array('i', [0, 1, 2, 3, 4, 5, 6, 7, 8, -1]), self.weights, self.pos)
+        with self.assertRaises(ValueError):
+            skin(self.palette, self.bones, self.weights[:9], self.pos)
+        with self.assertRaises(ValueError):
+            skin(self.palette, self.bones[:9], self.weights[:9], self.pos)
+        with self.assertRaises(ValueError):
+            skin(self.palette, self.bones, self.weights, self.pos, self.nrm[:6])
+        with self.assertRaises(ValueError):
+            skin(self.palette, self.bones, self.weights, self.pos, out=array.array('f', [0]*3))
+        with self.assertRaises(TypeError):
+            skin(self.palette, self.bones, self.weights, self.pos, normal=self.nrm)
+        with self.assertRaises(TypeError):
+            skin(self.palette, self.bones, self.weights, self.pos, bones=self.bones)
+
+    def test_skin_vector_array(self):
+        # A VectorArray of three is 3x3 too, but holds x x x y y y z z z.
+        va = VectorArray([Vector(1, 2, 3), Vector(4, 5, 6), Vector(7, 8, 9)])
+        bones, weights = self.bones[:6], self.weights[:6]
+        with self.assertRaises(TypeError):
+            skin(self.palette, bones, weights, va)
+        with self.assertRaises(TypeError):
+            skin(self.palette, bones, weights, self.pos[:9], va)
+        with self.assertRaises(TypeError):
+            skin(self.palette, bones, weights, self.pos[:9], out=va)
+        with self.assertRaises(TypeError):
+            skin(self.palette, bones, weights, self.pos[:9], self.nrm[:9], outNormals=va)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,212 @@
+import unittest
+import array
+import math
+import os
+import sys
+import threading
+import time
+
+from pyglm import *
+
+class TestThreads(unittest.TestCase):
+
+    def setUp(self):
+        self.threads = threads()
+        # Large enough for every batch operation to be split.
+        self.n = 40000
+        self.pts = array.array('f', [math.sin(0.1*i) * (i % 7) for i in range(3*self.n)])
+        q1 = [Quaternion(Vector(1, i % 5, 2), deg=i % 360) for i in range(self.n)]
+        q2 = [Quaternion(Vector(i % 3, 1, -1), deg=(7*i) % 360) for i in range(self.n)]
+        self.q1 = array.array('f', [c for q in q1 for c in (q.x, q.y, q.z, q.w)])
+        self.q2 = array.array('f', [c for q in q2 for c in (q.x, q.y, q.z, q.w)])
+        self.t = array.array('f', [(i % 11) / 10.0 for i in range(self.n)])
+
+    def tearDown(self):
+        setThreads(self.threads)
+
+    def assertBuffersAlmostEqual(self, a, b):
+        self.assertEqual(len(a), len(b))
+        self.assertLess(max(abs(x - y) for x, y in zip(a, b)), 1e-5)
+
+    # Runs all batch operations, for comparing the results of different thread counts.
+    def batches(self):
+        m = transformation(Vector(1, 2, 3), Quaternion(Vector(0, 1, 1), deg=30), Vector(2, 1, 1))
+        palette = [m, m.inverse(), AffineMatrix()]
+        bones = array.array('i', [i % 3 for i in range(2*self.n)])
+        weights = array.array('f', [0.25, 0.75] * self.n)
+        clip = AnimationClip()
+        for i in range(1000):
+            clip.add(QuaternionTrack([0, 1 + i % 3], [Quaternion(), Quaternion(Vector(1, i, 0), deg=90)]))
+        return [m.transformPoints(self.pts), m.transformDirections(self.pts),
+                rotate(self.q1, self.pts), slerp(self.q1, self.q2, self.t), nlerp(self.q1, self.q2, self.t),
+                skin(palette, bones, weights, self.pts), clip.sample(0.7)]
+
+    def test_threads(self):
+        self.assertGreaterEqual(threads(), 1)
+        setThreads(3)
+        self.assertEqual(threads(), 3)
+        setThreads(1)
+        self.assertEqual(threads(), 1)
+        setThreads(0)
+        self.assertGreaterEqual(threads(), 1)
+        self.assertRaises(ValueError, setThreads, -1)
+        self.assertRaises(ValueError, setThreads)
+        self.assertRaises(ValueError, setThreads, 2**40)
+        self.assertRaises(ValueError, setThreads, 2**70)
+        self.assertRaises(TypeError, setThreads, 3.5)
+        setThreads(64)
+        self.assertEqual(threads(), 64)
+
+    def test_same_results(self):
+        setThreads(1)
+        expected = self.batches()
+        for n in (2, 4, 7):
+            setThreads(n)
+            for a, b in zip(self.batches(), expected):
+                self.assertBuffersAlmostEqual(a, b)
+
+    def test_in_place(self):
+        setThreads(4)
+        m = translation(1, 2, 3)
+        pts = array.array('f', self.pts)
+        m.transformPoints(pts, pts)
+        self.assertBuffersAlmostEqual(pts, m.transformPoints(self.pts))
+
+        q = array.array('f', self.q1)
+        slerp(q, self.q2, self.t, q)
+        self.assertBuffersAlmostEqual(q, slerp(self.q1, self.q2, self.t))
+
+    def test_concurrent_calls(self):
+        # Batches started from several Python threads at once, each of them
+        # with the GIL released, need to give the same results as one by one.
+        setThreads(4)
+        m = translation(1, 2, 3) * rotation(Vector(1, 0, 0), deg=45)
+        expected = m.transformPoints(self.pts)
+        results = [None] * 4
+        def work(i):
+            results[i] = m.transformPoints(self.pts)
+        workers = [threading.Thread(target=work, args=(i,)) for i in range(len(results))]
+        for w in workers:
+            w.start()
+        for w in workers:
+            w.join()
+        for r in results:
+            self.assertBuffersAlmostEqual(r, expected)
+
+    # Counts in a thread of its own while this one runs stmt up to 20 times,
+    # results in how far it got. With a switch interval longer than all runs
+    # take, the counter only moves if stmt lets go of the GIL, and it may
+    # take a few runs for the counter to get scheduled on a single core.
+    def count_during(self, stmt):
+        interval = sys.getswitchinterval()
+        sys.setswitchinterval(0.2)
+        count = [0]
+        stop = []
+        def counter():
+            while not stop:
+                count[0] += 1
+        t = threading.Thread(target=counter)
+        t.start()
+        try:
+            # Handing the GIL over and taking it back leaves this thread with
+            # a whole switch interval before the counter may ask for it.
+            time.sleep(0.01)
+            before = count[0]
+            for i in range(20):
+                stmt()
+                if count[0] != before:
+                    break
+            return count[0] - before
+        finally:
+            stop.append(True)
+            t.join()
+            sys.setswitchinterval(interval)
+
+    def test_gil_policy(self):
+        setThreads(1)
+        pts = array.array('f', [1.0] * 3000000)
+        small = array.array('f', [1.0] * 300)
+        m = translation(1, 2, 3)
+        self.assertGreater(self.count_during(lambda: m.transformPoints(pts, pts)), 0)
+        self.assertEqual(self.count_during(lambda: m.transformPoints(small, small)), 0)
+
+        va = VectorArray(1000000)
+        self.assertGreater(self.count_during(lambda: va.normalize()), 0)
+        self.assertGreater(self.count_during(lambda: fromBinary(toBinary(va))), 0)
+
+        # Hierarchies and clips guard their state with a lock of their own,
+        # which lets them go of it as well, see AllowThreads.
+        h = TransformHierarchy([-1] + list(range(20000)))
+        def update():
+            h.invalidate()
+            h.update()
+        self.assertGreater(self.count_during(update), 0)
+        roots = TransformHierarchy([-1] * 200000)
+        locals = array.array('f', [0, 0, 0, 0, 0, 0, 1, 1, 1, 1] * len(roots))
+        self.assertGreater(self.count_during(lambda: roots.setLocals(locals)), 0)
+        def move():
+            h.setLocal(len(h) - 1, Transform())
+            h.update()
+        self.assertEqual(self.count_during(move), 0)
+
+        keys = [0.0, 1.0]
+        vt = VectorTrack(keys, [Vector(), Vector(1, 2, 3)])
+        big = AnimationClip([vt] * 100000)
+        out = array.array('f', [0.0] * big.floats())
+        self.assertGreater(self.count_during(lambda: big.sample(0.5, out)), 0)
+        small = AnimationClip([vt] * 10)
+        self.assertEqual(self.count_during(lambda: small.sample(0.5)), 0)
+
+    def test_hierarchy_race(self):
+        # Each thread moves nodes of its own and updates. Without the lock, an
+        # update could clear the dirty flag of a node another thread moved
+        # meanwhile without recomputing it.
+        h = TransformHierarchy([-1] * 20000)
+        def work(i):
+            for j in range(10):
+                for k in range(i, len(h), 4):
+                    h.setLocal(k, Transform(Vector(j, i, 0)))
+                h.update()
+
+        workers = [threading.Thread(target=work, args=(i,)) for i in range(4)]
+        for w in workers:
+            w.start()
+        for w in workers:
+            w.join()
+
+        for k in range(0, len(h), 997):
+            self.assertFalse(h.dirty(k))
+            self.assertEqual(h.world(k) * Vector(), Vector(9, k % 4, 0))
+
+    @unittest.skipIf((os.cpu_count() or 1) < 2, "needs at least two cores")
+    def test_scaling(self):
+        # Without the pool splitting the calls, two Python threads doing the
+        # same amount of bulk work each take about as long as one of them
+        # alone, as long as neither holds the GIL while working.
+        setThreads(1)
+        m = translation(1, 2, 3) * rotation(Vector(1, 0, 0), deg=45)
+        bufs = [array.array('f', [1.0] * 3000000) for i in range(2)]
+        def work(i):
+            for j in range(20):
+                m.transformPoints(bufs[i], bufs[i])
+
+        def alone():
+            t = time.perf_counter()
+            work(0)
+            return time.perf_counter() - t
+
+        def together():
+            workers = [threading.Thread(target=work, args=(i,)) for i in range(2)]
+            t = time.perf_counter()
+            for w in workers:
+                w.start()
+            for w in workers:
+                w.join()
+            return time.perf_counter() - t
+
+        # Best of a few runs, machines running other things have hiccups.
+        ratio = min(together() / alone() for i in range(3))
+        self.assertLess(ratio, 1.5)
+
+if __name__ == '__main__':
+    unittest.main()
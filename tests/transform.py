@@ -0,0 +1,114 @@
+import unittest
+import math
+
+from pyglm import *
+from helpers import AlmostEqualMixin
+
+identity = [1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1]
+
+class TestTransform(AlmostEqualMixin, unittest.TestCase):
+
+    def setUp(self):
+        self.a = Transform(Vector(1, 2, 3), Quaternion(Vector(1, 2, 3), deg=40), 2)
+        self.b = Transform(Vector(-3, 0.5, 2), Quaternion(Vector(0, 1, 1), deg=-75), Vector(1, 2, 3))
+
+    def test_ctor(self):
+        t = Transform()
+        self.assertMatrixAlmostEqual(t.matrix(), identity)
+        self.assertEqual(t.translation, Vector(0, 0, 0))
+        self.assertEqual(t.scale, Vector(1, 1, 1))
+
+        t = Transform(scale=2, translation=(1, 2, 3))
+        self.assertEqual(t.translation, Vector(1, 2, 3))
+        self.assertEqual(t.scale, Vector(2, 2, 2))
+        self.assertEqual(t.rotation, Quaternion())
+
+        t = Transform(self.b)
+        self.assertMatrixAlmostEqual(t.matrix(), self.b.matrix())
+
+    def test_ctor_bad(self):
+        with self.assertRaises(TypeError):
+            Transform(1)
+        with self.assertRaises(TypeError):
+            Transform(Vector(), Vector())
+        with self.assertRaises(TypeError):
+            Transform(Vector(), Quaternion(), Vector(), Vector())
+        with self.assertRaises(TypeError):
+            Transform([1, 2, 3, 4])
+        with self.assertRaises(TypeError):
+            Transform(bogus=1)
+        with self.assertRaises(TypeError):
+            Transform(Vector(), translation=Vector())
+
+    def test_attributes(self):
+        t = Transform()
+        t.translation = Vector(1, 2, 3)
+        t.rotation = Quaternion(Vector(0, 0, 1), deg=90)
+        t.scale = 3
+        self.assertMatrixAlmostEqual(t.matrix(), transformation(Vector(1, 2, 3), Quaternion(Vector(0, 0, 1), deg=90), Vector(3, 3, 3)))
+
+        # Copies are handed out.
+        t.translation.x = 5
+        self.assertEqual(t.translation.x, 1)
+
+        with self.assertRaises(TypeError):
+            t.rotation = Vector()
+        with self.assertRaises(AttributeError):
+            del t.scale
+
+    def test_matrix(self):
+        for t in (self.a, self.b):
+            self.assertMatrixAlmostEqual(t.matrix(), transformation(t.translation, t.rotation, t.scale))
+
+    def test_point(self):
+        p = Vector(0.5, -1, 4)
+        for t in (self.a, self.b):
+            self.assertVectorAlmostEqual(t * p, t.matrix() * p)
+            self.assertVectorAlmostEqual(t.direction(p), t.matrix() * p - t.translation)
+
+    def test_product(self):
+        # Exact as long as the left scale is uniform, whatever the right one.
+        self.assertMatrixAlmostEqual((self.a * self.b).matrix(), self.a.matrix() * self.b.matrix())
+        self.assertMatrixAlmostEqual((self.a * self.a).matrix(), self.a.matrix() * self.a.matrix())
+
+        t = Transform(self.a)
+        t *= self.b
+        self.assertMatrixAlmostEqual(t.matrix(), (self.a * self.b).matrix())
+
+        # A Vector on the right isn't an in-place operation.
+        t = self.a
+        t *= Vector(1, 0, 0)
+        self.assertIsInstance(t, Vector)
+
+        with self.assertRaises(TypeError):
+            self.a * self.a.matrix()
+
+    def test_inverse(self):
+        inv = self.a.inverse()
+        self.assertMatrixAlmostEqual((self.a * inv).matrix(), identity)
+        self.assertMatrixAlmostEqual((inv * self.a).matrix(), identity)
+        self.assertMatrixAlmostEqual(inv.matrix(), self.a.matrix().inverse())
+
+    def test_lerp(self):
+        self.assertMatrixAlmostEqual(self.a.lerp(self.b, 0).matrix(), self.a.matrix())
+        self.assertMatrixAlmostEqual(self.a.lerp(other=self.b, between=1).matrix(), self.b.matrix())
+
+        half = self.a.lerp(self.b, 0.5)
+        self.assertVectorAlmostEqual(half.translation, (self.a.translation + self.b.translation) * 0.5)
+        self.assertVectorAlmostEqual(half.scale, (self.a.scale + self.b.scale) * 0.5)
+
+        # -q is the same rotation as q, the way to it is the shortest one.
+        q = self.a.rotation
+        flipped = Transform(self.a.translation, Quaternion(-q.x, -q.y, -q.z, -q.w), self.a.scale)
+        self.assertMatrixAlmostEqual(self.a.lerp(flipped, 0.5).matrix(), self.a.matrix())
+
+        with self.assertRaises(TypeError):
+            self.a.lerp(self.a.matrix(), 0.5)
+        with self.assertRaises(ValueError):
+            self.a.lerp(self.b)
+
+if __name__ == '__main__':
+    unittest.main()
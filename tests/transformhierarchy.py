@@ -0,0 +1,162 @@
+import unittest
+import array
+import struct
+
+from pyglm import *
+from helpers import AlmostEqualMixin
+
+# All the floats of the matrices, in memory order.
+def flat(h):
+    return struct.unpack('%df' % (16*len(h)), h)
+
+class TestTransformHierarchy(AlmostEqualMixin, unittest.TestCase):
+
+    def setUp(self):
+        # Two roots: 0 with the chain 0-1-2 and the branch 1-3, and 4 alone.
+        self.parents = [-1, 0, 1, 1, -1]
+        self.h = TransformHierarchy(self.parents)
+        self.locals = [Transform(Vector(i, 1, -i), Quaternion(Vector(1, i, 2), deg=20*i), 1 + 0.5*i) for i in range(5)]
+        for i, t in enumerate(self.locals):
+            self.h.setLocal(i, t)
+
+    def test_ctor(self):
+        self.assertEqual(len(self.h), 5)
+        self.assertEqual(self.h.parents(), self.parents)
+        self.assertEqual(len(TransformHierarchy([])), 0)
+
+        # Everything is the identity until set and updated.
+        h = TransformHierarchy([-1, 0])
+        self.assertMatrixAlmostEqual(flat(h)[16:], AffineMatrix())
+
+    def test_ctor_bad(self):
+        with self.assertRaises(ValueError):
+            TransformHierarchy([-1, 2, 1])
+        with self.assertRaises(ValueError):
+            TransformHierarchy([0])
+        with self.assertRaises(ValueError):
+            TransformHierarchy([-1, -2])
+        with self.assertRaises(TypeError):
+            TransformHierarchy(3)
+        with self.assertRaises(MemoryError):
+            TransformHierarchy(range(2**61))
+
+    def test_update(self):
+        self.h.update()
+        worlds = []
+        for i, p in enumerate(self.parents):
+            worlds.append(self.locals[i] if p < 0 else worlds[p] * self.locals[i])
+
+        floats = flat(self.h)
+        for i, w in enumerate(worlds):
+            self.assertIsInstance(self.h.world(i), AffineMatrix)
+            self.assertMatrixAlmostEqual(self.h.world(i), w.matrix())
+            self.assertMatrixAlmostEqual(floats[16*i:16*i+16], w.matrix())
+            self.assertMatrixAlmostEqual(self.h.local(i).matrix(), self.locals[i].matrix())
+
+        # Indexing and iterating give the world matrices too.
+        self.assertIsInstance(self.h[0], AffineMatrix)
+        self.assertMatrixAlmostEqual(self.h[-1], worlds[-1].matrix())
+        self.assertEqual(len(list(self.h)), len(worlds))
+        for m, w in zip(self.h, worlds):
+            self.assertMatrixAlmostEqual(m, w.matrix())
+
+        # The matrices of the world transforms are the products of the local ones.
+        m = self.locals[0].matrix() * self.locals[1].matrix() * self.locals[2].matrix()
+        self.assertMatrixAlmostEqual(floats[32:48], m, 4)
+
+    def test_uneven_scale(self):
+        # Scaling y thrice shears the rotated child, which needs the product of
+        # the matrices and not that of the Transforms.
+        parent = Transform(Vector(0, 0, 0), Quaternion(), Vector(1, 3, 1))
+        child = Transform(Vector(1, 0, 0), Quaternion(Vector(0, 0, 1), deg=45))
+        h = TransformHierarchy([-1, 0])
+        h.setLocal(0, parent)
+        h.setLocal(1, child)
+        h.update()
+        m = parent.matrix() * child.matrix()
+        self.assertMatrixAlmostEqual(h.world(1), m)
+        self.assertMatrixAlmostEqual(flat(h)[16:], m)
+        p = h.world(1) * Vector(1, 0, 0)
+        self.assertAlmostEqual(p.x, 1.7071, 4)
+        self.assertAlmostEqual(p.y, 2.1213, 4)
+        self.assertAlmostEqual(p.z, 0.0, 4)
+
+    def test_dirty(self):
+        self.assertTrue(self.h.dirty(4))
+        self.assertEqual(self.h.update(), 5)
+        self.assertFalse(self.h.dirty(4))
+        self.assertEqual(self.h.update(), 0)
+
+        # Only the node and those below it.
+        moved = Transform(Vector(0, 5, 0), Quaternion(Vector(0, 0, 1), deg=30))
+        self.h.setLocal(1, moved)
+        self.assertTrue(self.h.dirty(1))
+        self.assertFalse(self.h.dirty(2))
+        self.assertEqual(self.h.update(), 3)
+        self.h.setLocal(4, moved)
+        self.assertEqual(self.h.update(), 1)
+        self.h.setLocal(3, moved)
+        self.h.setLocal(0, moved)
+        self.assertEqual(self.h.update(), 4)
+
+        # The same as recomputing everything.
+        full = TransformHierarchy(self.parents)
+        for i in range(len(self.h)):
+            full.setLocal(i, self.h.local(i))
+        full.update()
+        self.assertEqual(flat(full), flat(self.h))
+
+        self.h.invalidate()
+        self.assertEqual(self.h.update(), 5)
+        self.assertEqual(flat(full), flat(self.h))
+
+    def test_dirty_uneven_scale(self):
+        # Moving only the parent recomputes the children below it from the
+        # parent's matrix, shear included.
+        self.h.update()
+        self.h.setLocal(1, Transform(Vector(0, 1, 0), Quaternion(Vector(1, 0, 0), deg=30), Vector(2, 0.5, 1)))
+        self.assertEqual(self.h.update(), 3)
+        m = [l.matrix() for l in self.locals]
+        m[1] = self.h.local(1).matrix()
+        self.assertMatrixAlmostEqual(self.h.world(2), m[0] * m[1] * m[2], 4)
+        self.assertMatrixAlmostEqual(self.h.world(3), m[0] * m[1] * m[3], 4)
+        self.assertMatrixAlmostEqual(flat(self.h)[48:64], m[0] * m[1] * m[3], 4)
+
+    def test_buffer(self):
+        self.h.update()
+        view = memoryview(self.h)
+        self.assertEqual(view.shape, (5, 4, 4))
+        self.assertTrue(view.readonly)
+        # Indexed as [node, row, column].
+        w = self.h.world(3) * Vector(0, 0, 0)
+        self.assertAlmostEqual(view[3, 0, 3], w.x, 5)
+        self.assertAlmostEqual(view[3, 1, 3], w.y, 5)
+        self.assertAlmostEqual(view[3, 2, 3], w.z, 5)
+
+    def test_set_locals(self):
+        h = TransformHierarchy(self.parents)
+        h.setLocals(array.array('f', [c for t in self.locals for c in
+                                      (t.translation.x, t.translation.y, t.translation.z,
+                                       t.rotation.x, t.rotation.y, t.rotation.z, t.rotation.w,
+                                       t.scale.x, t.scale.y, t.scale.z)]))
+        h.update()
+        self.h.update()
+        self.assertEqual(flat(h), flat(self.h))
+
+        with self.assertRaises(ValueError):
+            h.setLocals(array.array('f', [0] * 9))
+
+    def test_index_bad(self):
+        with self.assertRaises(IndexError):
+            self.h.world(5)
+        with self.assertRaises(IndexError):
+            self.h[5]
+        with self.assertRaises(IndexError):
+            self.h.local(-1)
+        with self.assertRaises(IndexError):
+            self.h.setLocal(5, Transform())
+        with self.assertRaises(TypeError):
+            self.h.setLocal(0, AffineMatrix())
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,4 +1,5 @@
 import unittest
+import struct
 import math
 
 from pyglm import *
@@ -65,6 +66,49 @@ class TestVector(unittest.TestCase):
             v.w = 3.0
         with self.assertRaises(ValueError):
             v.x = "abc"
+        with self.assertRaises(AttributeError):
+            del v.x
+
+    def test_setter_conversion(self):
+        v = Vector()
+        v.x = 2
+        v.y = "0.5"
+        self.assertEqual((v.x, v.y, v.z), (2.0, 0.5, 0.0))
+
+    def test_swizzle(self):
+        v = Vector(1, 2, 3)
+        self.assertEqual(v.xy, (1.0, 2.0))
+        self.assertEqual(v.zx, (3.0, 1.0))
+        self.assertIsInstance(v.zyx, Vector)
+        self.assertEqual(v.zyx, Vector(3, 2, 1))
+        self.assertEqual(v.xxy, Vector(1, 1, 2))
+        self.assertIsInstance(v.xyzx, Quaternion)
+        self.assertEqual(v.xyzx, Quaternion(1, 2, 3, 1))
+        with self.assertRaises(AttributeError):
+            v.xw
+
+    def test_swizzle_setter(self):
+        v = Vector(1, 2, 3)
+        v.xz = (10, 30)
+        self.assertEqual(v, Vector(10, 2, 30))
+        v.xy = v.yx
+        self.assertEqual(v, Vector(2, 10, 30))
+        v.zyx = Vector(7, 8, 9)
+        self.assertEqual(v, Vector(9, 8, 7))
+        v.yz = [1, "2"]
+        self.assertEqual(v, Vector(9, 1, 2))
+
+    def test_swizzle_setter_bad(self):
+        v = Vector(1, 2, 3)
+        with self.assertRaises(AttributeError):
+            v.xx = (1, 2)
+        with self.assertRaises(ValueError):
+            v.xy = (1, 2, 3)
+        with self.assertRaises(ValueError):
+            v.xy = Vector(1, 2, 3)
+        with self.assertRaises(TypeError):
+            v.xy = 3
+        self.assertEqual(v, Vector(1, 2, 3))
 
     def test_comparison(self):
         v1 = Vector(1, 2, 3)
@@ -132,6 +176,30 @@ class TestVector(unittest.TestCase):
         with self.assertRaises(TypeError):
             "1,2,3" + Vector()
 
+    def test_inplace(self):
+        v = Vector(1, 2, 3)
+        alias = v
+        v += Vector(0.5, 0.5, 0.5)
+        self.assertIs(v, alias)
+        self.assertEqual(v, Vector(1.5, 2.5, 3.5))
+        v -= Vector(0.5, 1.5, 2.5)
+        self.assertEqual(v, Vector(1, 1, 1))
+        v *= 2
+        self.assertEqual(v, Vector(2, 2, 2))
+        v *= Vector(1, 2, 3)
+        self.assertIs(v, alias)
+        self.assertEqual(v, Vector(2, 4, 6))
+        v += v
+        self.assertEqual(v, Vector(4, 8, 12))
+
+    def test_inplace_bad(self):
+        v = Vector(1, 2, 3)
+        with self.assertRaises(TypeError):
+            v += 1
+        with self.assertRaises(TypeError):
+            v *= "Hi"
+        self.assertEqual(v, Vector(1, 2, 3))
+
     def test_subtraction(self):
         v1 = Vector(1, 2, 3)
         v2 = Vector(0.1, 0.2, 0.3)
@@ -250,6 +318,27 @@ class TestVector(unittest.TestCase):
         with self.assertRaises(TypeError):
             Vector().normalized(32)
 
+    def test_free_list(self):
+        v = Vector(1, 2, 3)
+        before = freeListStats()['Vector']
+        results = [v + v for i in range(10)]
+        del results
+        results = [v + v for i in range(10)]
+        after = freeListStats()['Vector']
+        self.assertGreaterEqual(after['hits'] - before['hits'], 10)
+        self.assertLessEqual(after['size'], after['capacity'])
+        for r in results:
+            self.assertEqual(r, v + v)
+
+    def test_buffer(self):
+        v = Vector(1, 2, 3)
+        m = memoryview(v)
+        self.assertEqual(m.format, 'f')
+        self.assertEqual(m.tolist(), [1, 2, 3])
+        m[1] = 5
+        self.assertEqual(v, Vector(1, 5, 3))
+        self.assertEqual(struct.unpack('3f', v), (1, 5, 3))
+
 if __name__ == '__main__':
     unittest.main()
 
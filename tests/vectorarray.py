@@ -0,0 +1,96 @@
+import unittest
+import math
+
+from pyglm import *
+
+class TestVectorArray(unittest.TestCase):
+
+    def setUp(self):
+        self.a = VectorArray([Vector(1, 2, 3), Vector(4, 5, 6), Vector(-1, 0, 2), Vector(0, 0, 0), Vector(3, 0, 0)])
+        self.b = VectorArray([Vector(0, 1, 0), Vector(1, 1, 1), Vector(2, 2, 2), Vector(1, 2, 3), Vector(0, 4, 0)])
+
+    def assertArrayEqual(self, arr, expected):
+        self.assertEqual(len(arr), len(expected))
+        for a, b in zip(arr, expected):
+            self.assertEqual(a, b)
+
+    def test_ctor(self):
+        self.assertEqual(len(VectorArray()), 0)
+        self.assertArrayEqual(VectorArray(3), [Vector()] * 3)
+        self.assertArrayEqual(VectorArray([(1, 2, 3), [4, 5]]), [Vector(1, 2, 3), Vector(4, 5, 0)])
+
+    def test_ctor_bad(self):
+        with self.assertRaises(ValueError):
+            VectorArray(-1)
+        with self.assertRaises(ValueError):
+            VectorArray(Vector())
+        with self.assertRaises(TypeError):
+            VectorArray([1, 2])
+        with self.assertRaises(MemoryError):
+            VectorArray(2**61)
+        with self.assertRaises(MemoryError):
+            VectorArray(range(2**61))
+
+    def test_item(self):
+        self.assertEqual(self.a[1], Vector(4, 5, 6))
+        self.assertEqual(self.a[-1], Vector(3, 0, 0))
+        self.a[1] = Vector(7, 8, 9)
+        self.a[2] = (1, 1, 1)
+        self.assertEqual(self.a[1], Vector(7, 8, 9))
+        self.assertEqual(self.a[2], Vector(1, 1, 1))
+
+    def test_item_bad(self):
+        with self.assertRaises(IndexError):
+            self.a[5]
+        with self.assertRaises(IndexError):
+            self.a[5] = Vector()
+
+    def test_arithmetic(self):
+        self.assertArrayEqual(self.a + self.b, [a + b for a, b in zip(self.a, self.b)])
+        self.assertArrayEqual(self.a - self.b, [a - b for a, b in zip(self.a, self.b)])
+        self.assertArrayEqual(self.a * self.b, [a * b for a, b in zip(self.a, self.b)])
+        self.assertArrayEqual(self.a * 2.5, [a * 2.5 for a in self.a])
+
+    def test_arithmetic_bad(self):
+        with self.assertRaises(ValueError):
+            self.a + VectorArray(2)
+        with self.assertRaises(TypeError):
+            self.a + Vector()
+        with self.assertRaises(TypeError):
+            self.a * "Hi"
+
+    def test_cross_dot(self):
+        self.assertArrayEqual(self.a.cross(self.b), [a.cross(b) for a, b in zip(self.a, self.b)])
+        dots = self.a.dot(self.b)
+        self.assertEqual(len(dots), 5)
+        for d, a, b in zip(dots, self.a, self.b):
+            self.assertAlmostEqual(d, a.dot(b), 5)
+
+    def test_len(self):
+        for l, a in zip(self.a.len(), self.a):
+            self.assertAlmostEqual(l, a.len(), 5)
+        self.assertEqual(len(VectorArray().len()), 0)
+
+    def test_normalize(self):
+        arr = VectorArray([Vector(1, 2, 3), Vector(0, 0, 0), Vector(0.000001, 0, 0), Vector(-0.000009, 0.000009, 0), Vector(0, -5, 0)])
+        expected = [v.normalized() for v in arr]
+        arr.normalize()
+        self.assertArrayEqual(arr, expected)
+        self.assertEqual(arr[1], Vector(0, 0, 0))
+        self.assertEqual(arr[2], Vector(0, 0, 0))
+        self.assertAlmostEqual(arr[0].len(), 1.0, 6)
+
+    def test_lerp(self):
+        self.assertArrayEqual(self.a.lerp(self.b, 0.25), [a.lerp(b, 0.25) for a, b in zip(self.a, self.b)])
+        self.assertArrayEqual(self.a.lerp(other=self.b, between=1), self.b)
+
+    def test_buffer(self):
+        m = memoryview(self.a)
+        self.assertEqual(m.shape, (3, 5))
+        self.assertEqual(m.tolist()[0], [1, 4, -1, 0, 3])
+        m[2, 1] = 7
+        self.assertEqual(self.a[1], Vector(4, 5, 7))
+        self.assertEqual(memoryview(VectorArray()).shape, (3, 0))
+
+if __name__ == '__main__':
+    unittest.main()